@@ -0,0 +1,527 @@
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../definitions/errors.h"
+
+#include "gnuplotprocess.h"
+
+extern char** environ;
+
+namespace Plotypus
+{
+    namespace
+    {
+        //! @brief to be called between fork and exec; returns false if the limit could not be set.
+        bool applyLimit(decltype(RLIMIT_CPU) resource, size_t limit)
+        {
+            // *INDENT-OFF*
+            if (!limit) {return true;}
+            // *INDENT-ON*
+
+            // RLIMIT_CPU sends SIGXCPU at the soft limit and SIGKILL at the hard limit
+            const rlimit value = {limit, (resource == RLIMIT_CPU ? limit + 1 : limit)};
+            return ::setrlimit(resource, &value) == 0;
+        }
+
+        GnuplotResult awaitGnuplot(pid_t pid, int hError, int hOutput, int hProcess, std::chrono::steady_clock::time_point start, std::chrono::duration<double> timeout)
+        {
+            using namespace std::chrono;
+
+            GnuplotResult result;
+            char          buffer[4096];
+            bool          exited = false;
+
+            // captured channels; a handle of -1 marks a closed or not captured one
+            int          handles[2] = {hError, hOutput};
+            std::string* targets[2] = {&result.errorOutput, &result.output};
+
+            const auto channelsOpen = [&handles] {return handles[0] >= 0 || handles[1] >= 0;};
+            const auto closeChannel = [&handles] (int i) {::close(handles[i]); handles[i] = -1;};
+
+            /* Wait for both the end of the captured output and the exit of gnuplot: helper processes may keep
+             * the channels open after gnuplot is gone, and gnuplot may close them before it is done. Without a
+             * pidfd, waiting ends with the output, and the timeout no longer applies from there on.
+             */
+            while (!exited && (channelsOpen() || hProcess >= 0))
+            {
+                int waitMilliseconds = -1;
+                if (timeout > timeout.zero())
+                {
+                    const duration<double> remaining = start + timeout - steady_clock::now();
+                    if (remaining <= remaining.zero())
+                    {
+                        ::kill(-pid, SIGKILL);
+                        result.timedOut = true;
+                        break;
+                    }
+                    waitMilliseconds = static_cast<int>(std::ceil(remaining.count() * 1000.));
+                }
+
+                pollfd events[3] = {{handles[0], POLLIN, 0}, {handles[1], POLLIN, 0}, {hProcess, POLLIN, 0}};
+                if (::poll(events, 3, waitMilliseconds) < 0)
+                {
+                    // *INDENT-OFF*
+                    if (errno == EINTR) {continue;}
+                    // *INDENT-ON*
+                    break;
+                }
+
+                for (int i = 0; i < 2; ++i)
+                {
+                    // *INDENT-OFF*
+                    if (!events[i].revents) {continue;}
+                    // *INDENT-ON*
+
+                    const ssize_t received = ::read(handles[i], buffer, sizeof(buffer));
+                    // *INDENT-OFF*
+                    if (received > 0)   {targets[i]->append(buffer, received);}
+                    else                {closeChannel(i);}
+                    // *INDENT-ON*
+                }
+
+                exited = events[2].revents;
+            }
+
+            int status = 0;
+            while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+
+            for (int i = 0; i < 2; ++i)
+            {
+                // *INDENT-OFF*
+                if (handles[i] < 0) {continue;}
+                // *INDENT-ON*
+
+                ::fcntl(handles[i], F_SETFL, O_NONBLOCK);
+                for (ssize_t received; (received = ::read(handles[i], buffer, sizeof(buffer))) > 0;)
+                {
+                    targets[i]->append(buffer, received);
+                }
+                closeChannel(i);
+            }
+
+            // *INDENT-OFF*
+            if (hProcess >= 0) {::close(hProcess);}
+            // *INDENT-ON*
+
+            result.wallTime = steady_clock::now() - start;
+            if (WIFEXITED(status))
+            {
+                result.exitCode = WEXITSTATUS(status);
+            }
+            else if (WIFSIGNALED(status))
+            {
+                result.exitCode = -1;
+                result.signal   = WTERMSIG(status);
+            }
+
+            return result;
+        }
+    }
+
+    std::future<GnuplotResult> runGnuplotAsync(const std::string& filename, const GnuplotLaunchOptions& options)
+    {
+        return runGnuplotAsync(std::vector<std::string>({filename}), options);
+    }
+
+    std::future<GnuplotResult> runGnuplotAsync(const std::vector<std::string>& arguments, const GnuplotLaunchOptions& options)
+    {
+        int errorPipe[2];
+        int outputPipe[2] = {-1, -1};
+        if (::pipe2(errorPipe, O_CLOEXEC) != 0)
+        {
+            throw FileIOError("Could not create error channel for '" + options.executable + "'");
+        }
+        if (options.captureOutput && ::pipe2(outputPipe, O_CLOEXEC) != 0)
+        {
+            ::close(errorPipe[0]);
+            ::close(errorPipe[1]);
+            throw FileIOError("Could not create output channel for '" + options.executable + "'");
+        }
+
+        // reports the errno of a failed setup or exec in the child; closed without data by a successful exec
+        int statusPipe[2];
+        if (::pipe2(statusPipe, O_CLOEXEC) != 0)
+        {
+            ::close(errorPipe[0]);
+            ::close(errorPipe[1]);
+            // *INDENT-OFF*
+            if (options.captureOutput) {::close(outputPipe[0]); ::close(outputPipe[1]);}
+            // *INDENT-ON*
+            throw FileIOError("Could not create status channel for '" + options.executable + "'");
+        }
+
+        std::vector<char*> argv = {const_cast<char*>(options.executable.c_str())};
+        for (const auto& argument : arguments)
+        {
+            argv.push_back(const_cast<char*>(argument.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        /* fork and exec rather than posix_spawn, so that the resource limits are in place before gnuplot
+         * runs. Between the two, only async-signal-safe calls are made.
+         */
+        const auto start = std::chrono::steady_clock::now();
+        const pid_t pid  = ::fork();
+        if (pid == 0)
+        {
+            const auto fail = [&statusPipe] ()
+            {
+                const int error = errno;
+                [[maybe_unused]] const auto written = ::write(statusPipe[1], &error, sizeof(error));
+                ::_exit(127);
+            };
+
+            // own process group, so that a kill also reaches helpers like gnuplot_qt
+            const int hNull = ::open("/dev/null", O_RDONLY);
+            // *INDENT-OFF*
+            if (::setpgid(0, 0) != 0)                                              {fail();}
+            if (hNull < 0 || ::dup2(hNull, STDIN_FILENO) < 0)                      {fail();}
+            if (::dup2(errorPipe[1], STDERR_FILENO) < 0)                           {fail();}
+            if (options.captureOutput && ::dup2(outputPipe[1], STDOUT_FILENO) < 0) {fail();}
+            if (!applyLimit(RLIMIT_CPU, options.cpuTimeLimit))                     {fail();}
+            if (!applyLimit(RLIMIT_AS,  options.memoryLimit))                      {fail();}
+            // *INDENT-ON*
+
+            ::execvp(argv[0], argv.data());
+            fail();
+        }
+
+        ::close(statusPipe[1]);
+        ::close(errorPipe[1]);
+        // *INDENT-OFF*
+        if (options.captureOutput) {::close(outputPipe[1]);}
+        // *INDENT-ON*
+
+        int     childError = 0;
+        ssize_t received;
+        while ((received = ::read(statusPipe[0], &childError, sizeof(childError))) < 0 && errno == EINTR) {}
+        ::close(statusPipe[0]);
+
+        if (pid < 0 || received > 0)
+        {
+            ::close(errorPipe[0]);
+            // *INDENT-OFF*
+            if (options.captureOutput) {::close(outputPipe[0]);}
+            if (pid > 0) {int status; while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {}}
+            // *INDENT-ON*
+            throw FileIOError("Could not start '" + options.executable + "'" + (received > 0 ? std::string(": ") + std::strerror(childError) : ""));
+        }
+
+        const int hProcess = static_cast<int>(::syscall(SYS_pidfd_open, pid, 0));
+
+        return std::async(std::launch::async, awaitGnuplot, pid, errorPipe[0], outputPipe[0], hProcess, start, options.timeout);
+    }
+
+    // ====================================================================== //
+
+    void GnuplotProcess::spawn()
+    {
+        /* stdin is a socket rather than a pipe, so that writing to a dead gnuplot yields EPIPE
+         * via MSG_NOSIGNAL instead of raising SIGPIPE in the client process.
+         */
+        int inputPair[2];
+        int outputPipe[2];
+        int errorPipe[2];
+
+        if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, inputPair) != 0)
+        {
+            throw FileIOError("Could not create input channel for '" + executable + "'");
+        }
+        if (::pipe2(outputPipe, O_CLOEXEC) != 0)
+        {
+            ::close(inputPair[0]);
+            ::close(inputPair[1]);
+            throw FileIOError("Could not create output channel for '" + executable + "'");
+        }
+        if (::pipe2(errorPipe, O_CLOEXEC) != 0)
+        {
+            ::close(inputPair[0]);
+            ::close(inputPair[1]);
+            ::close(outputPipe[0]);
+            ::close(outputPipe[1]);
+            throw FileIOError("Could not create error channel for '" + executable + "'");
+        }
+
+        posix_spawn_file_actions_t fileActions;
+        posix_spawn_file_actions_init(&fileActions);
+        posix_spawn_file_actions_adddup2(&fileActions, inputPair[1],  STDIN_FILENO);
+        posix_spawn_file_actions_adddup2(&fileActions, outputPipe[1], STDOUT_FILENO);
+        posix_spawn_file_actions_adddup2(&fileActions, errorPipe[1],  STDERR_FILENO);
+
+        char* const argv[] = {const_cast<char*>(executable.c_str()), nullptr};
+        const int error = ::posix_spawnp(&pid, executable.c_str(), &fileActions, nullptr, argv, environ);
+
+        posix_spawn_file_actions_destroy(&fileActions);
+        ::close(inputPair[1]);
+        ::close(outputPipe[1]);
+        ::close(errorPipe[1]);
+
+        if (error)
+        {
+            ::close(inputPair[0]);
+            ::close(outputPipe[0]);
+            ::close(errorPipe[0]);
+            pid = -1;
+            throw FileIOError("Could not start '" + executable + "'");
+        }
+
+        hInput  = inputPair[0];
+        hOutput = outputPipe[0];
+        hErrors = errorPipe[0];
+        pendingErrors.clear();
+        ++spawnCount;
+    }
+
+    void GnuplotProcess::closeHandles()
+    {
+        // *INDENT-OFF*
+        if (hInput  >= 0) {::close(hInput);}
+        if (hOutput >= 0) {::close(hOutput);}
+        if (hErrors >= 0) {::close(hErrors);}
+        // *INDENT-ON*
+
+        hInput  = -1;
+        hOutput = -1;
+        hErrors = -1;
+    }
+
+    void GnuplotProcess::kill()
+    {
+        // *INDENT-OFF*
+        if (pid < 0) {return;}
+        // *INDENT-ON*
+
+        ::kill(pid, SIGKILL);
+        closeHandles();
+
+        int status;
+        while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+        pid = -1;
+    }
+
+    bool GnuplotProcess::waitFor(pollfd* events, size_t count, const deadline_t& deadline)
+    {
+        using namespace std::chrono;
+
+        while (true)
+        {
+            int waitMilliseconds = -1;
+            if (deadline)
+            {
+                const duration<double> remaining = deadline.value() - steady_clock::now();
+                if (remaining <= remaining.zero())
+                {
+                    timedOut = true;
+                    return false;
+                }
+                waitMilliseconds = static_cast<int>(std::ceil(remaining.count() * 1000.));
+            }
+
+            const int ready = ::poll(events, count, waitMilliseconds);
+            // *INDENT-OFF*
+            if (ready > 0)                      {return true;}
+            if (ready < 0 && errno != EINTR)    {return false;}
+            // *INDENT-ON*
+        }
+    }
+
+    bool GnuplotProcess::sendAll(const std::string& text, const deadline_t& deadline)
+    {
+        const char* data = text.data();
+        size_t      size = text.size();
+
+        while (size)
+        {
+            pollfd event = {hInput, POLLOUT, 0};
+            // *INDENT-OFF*
+            if (!waitFor(&event, 1u, deadline)) {return false;}
+            // *INDENT-ON*
+
+            const ssize_t sent = ::send(hInput, data, size, MSG_NOSIGNAL);
+            if (sent < 0)
+            {
+                // *INDENT-OFF*
+                if (errno == EINTR) {continue;}
+                // *INDENT-ON*
+                return false;
+            }
+            data += sent;
+            size -= sent;
+        }
+
+        return true;
+    }
+
+    bool GnuplotProcess::readUntil(const std::string& marker, const deadline_t& deadline)
+    {
+        char buffer[4096];
+
+        while (true)
+        {
+            // the marker line ends with the value of GPVAL_ERRNO
+            const auto position = pendingErrors.find(marker + " ");
+            const auto lineEnd  = (position == std::string::npos ? std::string::npos : pendingErrors.find('\n', position));
+            if (lineEnd != std::string::npos)
+            {
+                errorOutput = pendingErrors.substr(0, position);
+                scriptError = (std::strtol(pendingErrors.c_str() + position + marker.size(), nullptr, 10) != 0);
+                pendingErrors.erase(0, lineEnd + 1);
+                return true;
+            }
+
+            // stdout is drained, too, so that gnuplot does not block on a full pipe
+            pollfd events[2] = {{hErrors, POLLIN, 0}, {hOutput, POLLIN, 0}};
+            // *INDENT-OFF*
+            if (!waitFor(events, 2u, deadline)) {return false;}
+            // *INDENT-ON*
+
+            for (const auto& event : events)
+            {
+                // *INDENT-OFF*
+                if (!event.revents) {continue;}
+                // *INDENT-ON*
+
+                const ssize_t received = ::read(event.fd, buffer, sizeof(buffer));
+                if (received < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (received <= 0)
+                {
+                    return false;
+                }
+
+                // *INDENT-OFF*
+                if (event.fd == hErrors) {pendingErrors.append(buffer, received);}
+                // *INDENT-ON*
+            }
+        }
+    }
+
+    // ====================================================================== //
+
+    GnuplotProcess::GnuplotProcess(const std::string& executable) :
+        executable(executable)
+    {}
+
+    GnuplotProcess::~GnuplotProcess()
+    {
+        stop();
+    }
+
+    const std::string& GnuplotProcess::getExecutable() const
+    {
+        return executable;
+    }
+
+    void GnuplotProcess::setExecutable(const std::string& newExecutable)
+    {
+        executable = newExecutable;
+    }
+
+    pid_t GnuplotProcess::getPid() const
+    {
+        return pid;
+    }
+
+    size_t GnuplotProcess::getSpawnCount() const
+    {
+        return spawnCount;
+    }
+
+    bool GnuplotProcess::isRunning()
+    {
+        // *INDENT-OFF*
+        if (pid < 0) {return false;}
+        // *INDENT-ON*
+
+        int status;
+        if (::waitpid(pid, &status, WNOHANG) == 0)
+        {
+            return true;
+        }
+
+        closeHandles();
+        pid = -1;
+        return false;
+    }
+
+    void GnuplotProcess::start()
+    {
+        // *INDENT-OFF*
+        if (!isRunning()) {spawn();}
+        // *INDENT-ON*
+    }
+
+    void GnuplotProcess::stop()
+    {
+        // *INDENT-OFF*
+        if (pid < 0) {return;}
+        // *INDENT-ON*
+
+        closeHandles();         // gnuplot exits on end of input
+
+        int status;
+        while (::waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+        pid = -1;
+    }
+
+    bool GnuplotProcess::hasTimedOut() const
+    {
+        return timedOut;
+    }
+
+    bool GnuplotProcess::hasScriptError() const
+    {
+        return scriptError;
+    }
+
+    const std::string& GnuplotProcess::getErrorOutput() const
+    {
+        return errorOutput;
+    }
+
+    bool GnuplotProcess::execute(const std::string& script, std::chrono::duration<double> timeout)
+    {
+        timedOut    = false;
+        scriptError = false;
+        errorOutput.clear();
+        start();
+
+        const std::string marker   = "plotypus-done-" + std::to_string(++scriptCount);
+        const deadline_t  deadline = (timeout > timeout.zero() ?
+                                      deadline_t(std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout)) :
+                                      std::nullopt);
+
+        // `unset output` closes the output file, so that it is complete once the marker arrives
+        const bool sent = sendAll("reset session\nreset errors\n", deadline) &&
+                          sendAll(script, deadline) &&
+                          sendAll("\nunset output\nset print\nprint \"" + marker + "\", GPVAL_ERRNO\n", deadline);
+
+        if (sent && readUntil(marker, deadline))
+        {
+            return !scriptError;
+        }
+
+        errorOutput = pendingErrors;
+
+        // a hung gnuplot would not react to the end of its input
+        // *INDENT-OFF*
+        if (timedOut)   {kill();}
+        else            {stop();}
+        // *INDENT-ON*
+        return false;
+    }
+}
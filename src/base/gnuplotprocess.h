@@ -0,0 +1,104 @@
+#ifndef GNUPLOTPROCESS_H
+#define GNUPLOTPROCESS_H
+
+#include <chrono>
+#include <future>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <poll.h>
+#include <sys/types.h>
+
+#include "../definitions/types.h"
+
+namespace Plotypus
+{
+    /**
+     * @brief starts gnuplot on the script `filename` and returns without waiting for it to finish.
+     *
+     * The process is spawned before returning, so descriptors that are open at the time of the call are
+     * inherited. Its stderr is captured into the result, while stdout is shared with the caller unless
+     * GnuplotLaunchOptions::captureOutput is set. Throws a FileIOError if gnuplot cannot be started.
+     */
+    std::future<GnuplotResult> runGnuplotAsync(const std::string& filename, const GnuplotLaunchOptions& options = GnuplotLaunchOptions());
+    //! @brief like runGnuplotAsync(filename, options), but passes the command line `arguments` to gnuplot, e.g. several scripts and `-e` commands.
+    std::future<GnuplotResult> runGnuplotAsync(const std::vector<std::string>& arguments, const GnuplotLaunchOptions& options = GnuplotLaunchOptions());
+
+    /**
+     * @brief long-lived gnuplot child process that executes scripts sent through its standard input
+     *
+     * The process is spawned with posix_spawn and kept alive between scripts, so that repeated plots
+     * do not pay for starting a shell and gnuplot each time. Every script is run in a fresh session
+     * (`reset session`, `reset errors`). Its completion is confirmed by a marker that gnuplot prints to
+     * its standard error along with GPVAL_ERRNO, like the markers of a RenderFarm batch. Reading commands
+     * from its standard input, gnuplot skips the rest of a failing script but keeps running. If gnuplot
+     * dies nevertheless, it is spawned anew with the next script.
+     */
+    class GnuplotProcess
+    {
+        private:
+            std::string executable;
+
+            pid_t  pid          = -1;
+            int    hInput       = -1;   //!< connected to stdin of gnuplot
+            int    hOutput      = -1;   //!< connected to stdout of gnuplot, which is discarded
+            int    hErrors      = -1;   //!< connected to stderr of gnuplot
+            size_t scriptCount  = 0u;
+            size_t spawnCount   = 0u;
+
+            std::string pendingErrors;
+            std::string errorOutput;
+            bool        timedOut    = false;
+            bool        scriptError = false;
+
+            using deadline_t = std::optional<std::chrono::steady_clock::time_point>;
+
+            void spawn();
+            void closeHandles();
+            void kill();
+            bool waitFor(pollfd* events, size_t count, const deadline_t& deadline);
+            bool sendAll(const std::string& text, const deadline_t& deadline);
+            bool readUntil(const std::string& marker, const deadline_t& deadline);
+
+        public:
+            GnuplotProcess(const std::string& executable = "gnuplot");
+            ~GnuplotProcess();
+
+            GnuplotProcess(const GnuplotProcess&)            = delete;
+            GnuplotProcess& operator=(const GnuplotProcess&) = delete;
+
+            const std::string&  getExecutable() const;
+            //! @brief sets the program to run; takes effect when the process is (re-)spawned.
+            void                setExecutable(const std::string& newExecutable);
+
+            pid_t               getPid() const;
+            //! @brief returns how often the process has been spawned, including re-spawns after it died.
+            size_t              getSpawnCount() const;
+
+            bool isRunning();
+
+            //! @brief spawns the process unless it is running already, or throws a FileIOError if this fails.
+            void start();
+            //! @brief closes the standard input of the process and waits for it to exit.
+            void stop();
+
+            /**
+             * @brief runs `script` in a fresh session and waits until gnuplot has processed it.
+             *
+             * Spawns the process if necessary. Returns false if gnuplot reported an error in the script,
+             * in which case it keeps running. Also returns false if gnuplot terminated before finishing
+             * the script, or if it did not finish within `timeout` (unless zero), in which case it is
+             * killed. Either way, it is spawned anew with the next call.
+             */
+            bool execute(const std::string& script, std::chrono::duration<double> timeout = std::chrono::duration<double>::zero());
+            //! @brief returns whether the last call of execute failed because the timeout expired.
+            bool hasTimedOut() const;
+            //! @brief returns whether the last call of execute failed because gnuplot reported an error in the script.
+            bool hasScriptError() const;
+            //! @brief returns what gnuplot wrote to stderr during the last call of execute.
+            const std::string& getErrorOutput() const;
+    };
+}
+
+#endif // GNUPLOTPROCESS_H
@@ -0,0 +1,1028 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "../definitions/errors.h"
+
+#include "util.h"
+
+#include "pdfmerger.h"
+
+namespace Plotypus
+{
+    namespace
+    {
+        // ================================================================== //
+        // inflate (RFC 1950/1951), after Mark Adler's puff
+
+        class Inflater
+        {
+            private:
+                struct Huffman
+                {
+                    std::array<short, 16>   count = {};
+                    std::vector<short>      symbol;
+                };
+
+                std::string_view input;
+                size_t           position    = 0u;
+                uint32_t         bitBuffer   = 0u;
+                int              bitCount    = 0;
+                std::string      output;
+
+                [[noreturn]] static void fail()
+                {
+                    throw FileIOError("Corrupt compressed stream in PDF file");
+                }
+
+                int bits(int n)
+                {
+                    while (bitCount < n)
+                    {
+                        // *INDENT-OFF*
+                        if (position >= input.size()) {fail();}
+                        // *INDENT-ON*
+                        bitBuffer |= static_cast<uint32_t>(static_cast<uint8_t>(input[position++])) << bitCount;
+                        bitCount  += 8;
+                    }
+
+                    const int value = bitBuffer & ((1u << n) - 1u);
+                    bitBuffer >>= n;
+                    bitCount   -= n;
+                    return value;
+                }
+
+                static Huffman build(const short* lengths, int n)
+                {
+                    Huffman h;
+                    h.symbol.resize(n);
+
+                    for (int i = 0; i < n; ++i)
+                    {
+                        ++h.count[lengths[i]];
+                    }
+
+                    std::array<short, 16> offsets = {};
+                    for (int length = 1; length < 15; ++length)
+                    {
+                        offsets[length + 1] = offsets[length] + h.count[length];
+                    }
+
+                    for (int i = 0; i < n; ++i)
+                    {
+                        // *INDENT-OFF*
+                        if (lengths[i]) {h.symbol[offsets[lengths[i]]++] = i;}
+                        // *INDENT-ON*
+                    }
+
+                    return h;
+                }
+
+                int decode(const Huffman& h)
+                {
+                    int code = 0, first = 0, index = 0;
+
+                    for (int length = 1; length < 16; ++length)
+                    {
+                        code |= bits(1);
+                        const int count = h.count[length];
+                        // *INDENT-OFF*
+                        if (code - count < first) {return h.symbol[index + (code - first)];}
+                        // *INDENT-ON*
+                        index  += count;
+                        first  += count;
+                        first <<= 1;
+                        code  <<= 1;
+                    }
+
+                    fail();
+                }
+
+                void stored()
+                {
+                    bitBuffer = 0u;
+                    bitCount  = 0;
+
+                    // *INDENT-OFF*
+                    if (position + 4u > input.size()) {fail();}
+                    // *INDENT-ON*
+
+                    const size_t length           = static_cast<uint8_t>(input[position    ]) | (static_cast<uint8_t>(input[position + 1]) << 8);
+                    const size_t lengthComplement = static_cast<uint8_t>(input[position + 2]) | (static_cast<uint8_t>(input[position + 3]) << 8);
+                    position += 4u;
+
+                    // *INDENT-OFF*
+                    if ((length ^ lengthComplement) != 0xFFFFu)  {fail();}
+                    if (position + length > input.size())       {fail();}
+                    // *INDENT-ON*
+
+                    output.append(input.substr(position, length));
+                    position += length;
+                }
+
+                void codes(const Huffman& lengthCode, const Huffman& distanceCode)
+                {
+                    static constexpr short lengthBase[]    = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+                    static constexpr short lengthExtra[]   = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+                    static constexpr short distanceBase[]  = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+                    static constexpr short distanceExtra[] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+                    while (true)
+                    {
+                        int symbol = decode(lengthCode);
+
+                        if (symbol < 256)
+                        {
+                            output.push_back(static_cast<char>(symbol));
+                            continue;
+                        }
+                        // *INDENT-OFF*
+                        if (symbol == 256)  {return;}
+                        // *INDENT-ON*
+
+                        symbol -= 257;
+                        // *INDENT-OFF*
+                        if (symbol >= 29)   {fail();}
+                        // *INDENT-ON*
+                        const size_t length = lengthBase[symbol] + bits(lengthExtra[symbol]);
+
+                        symbol = decode(distanceCode);
+                        // *INDENT-OFF*
+                        if (symbol >= 30)   {fail();}
+                        // *INDENT-ON*
+                        const size_t distance = distanceBase[symbol] + bits(distanceExtra[symbol]);
+
+                        // *INDENT-OFF*
+                        if (distance > output.size()) {fail();}
+                        // *INDENT-ON*
+
+                        for (size_t i = 0u; i < length; ++i)         // byte-wise, as source and target may overlap
+                        {
+                            output.push_back(output[output.size() - distance]);
+                        }
+                    }
+                }
+
+                void fixed()
+                {
+                    static const auto [lengthCode, distanceCode] = []
+                    {
+                        short lengths[288];
+                        std::fill(lengths,       lengths + 144, 8);
+                        std::fill(lengths + 144, lengths + 256, 9);
+                        std::fill(lengths + 256, lengths + 280, 7);
+                        std::fill(lengths + 280, lengths + 288, 8);
+
+                        short distances[30];
+                        std::fill(distances, distances + 30, 5);
+
+                        return std::make_pair(build(lengths, 288), build(distances, 30));
+                    }();
+
+                    codes(lengthCode, distanceCode);
+                }
+
+                void dynamic()
+                {
+                    static constexpr short order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+                    const int lengthCount   = bits(5) + 257;
+                    const int distanceCount = bits(5) + 1;
+                    const int codeCount     = bits(4) + 4;
+
+                    // *INDENT-OFF*
+                    if (lengthCount > 286 || distanceCount > 30) {fail();}
+                    // *INDENT-ON*
+
+                    short lengths[320] = {};
+                    for (int i = 0; i < codeCount; ++i)
+                    {
+                        lengths[order[i]] = bits(3);
+                    }
+                    const Huffman codeLengthCode = build(lengths, 19);
+
+                    for (int i = 0; i < lengthCount + distanceCount;)
+                    {
+                        const int symbol = decode(codeLengthCode);
+                        if (symbol < 16)
+                        {
+                            lengths[i++] = symbol;
+                            continue;
+                        }
+
+                        short repeated = 0;
+                        int   count;
+                        // *INDENT-OFF*
+                        if      (symbol == 16) {if (!i) {fail();} repeated = lengths[i - 1]; count = 3 + bits(2);}
+                        else if (symbol == 17) {count = 3 + bits(3);}
+                        else                   {count = 11 + bits(7);}
+
+                        if (i + count > lengthCount + distanceCount) {fail();}
+                        // *INDENT-ON*
+
+                        while (count--)
+                        {
+                            lengths[i++] = repeated;
+                        }
+                    }
+
+                    codes(build(lengths, lengthCount), build(lengths + lengthCount, distanceCount));
+                }
+
+            public:
+                //! @brief returns the decompressed content of the zlib stream `data`.
+                std::string inflate(std::string_view data)
+                {
+                    input = data;
+                    // *INDENT-OFF*
+                    if (input.size() < 2u || (input[0] & 0x0F) != 8 || (input[1] & 0x20)) {fail();}
+                    // *INDENT-ON*
+                    position = 2u;
+
+                    bool last;
+                    do
+                    {
+                        last = bits(1);
+                        switch (bits(2))
+                        {
+                            // *INDENT-OFF*
+                            case 0:  stored();  break;
+                            case 1:  fixed();   break;
+                            case 2:  dynamic(); break;
+                            default: fail();
+                            // *INDENT-ON*
+                        }
+                    }
+                    while (!last);
+
+                    return std::move(output);
+                }
+        };
+
+        // ================================================================== //
+        // object model
+
+        struct PdfObject
+        {
+            enum class Kind {Scalar, Array, Dictionary, Reference, Stream};
+
+            Kind                                            kind = Kind::Scalar;
+            std::string                                     text;           //!< raw source of scalars: numbers, names, strings, keywords
+            std::vector<PdfObject>                          items;          //!< array elements
+            std::vector<std::pair<std::string, PdfObject>>  entries;        //!< dictionary entries, also of streams
+            int                                             number = 0;     //!< object number of references
+            std::string                                     data;           //!< raw (encoded) content of streams
+
+            const PdfObject* get(std::string_view key) const
+            {
+                for (const auto& [entryKey, value] : entries)
+                {
+                    // *INDENT-OFF*
+                    if (entryKey == key) {return &value;}
+                    // *INDENT-ON*
+                }
+                return nullptr;
+            }
+
+            void set(const std::string& key, const PdfObject& value)
+            {
+                for (auto& [entryKey, entryValue] : entries)
+                {
+                    // *INDENT-OFF*
+                    if (entryKey == key) {entryValue = value; return;}
+                    // *INDENT-ON*
+                }
+                entries.emplace_back(key, value);
+            }
+
+            void erase(std::string_view key)
+            {
+                std::erase_if(entries, [key] (const auto& entry) {return entry.first == key;});
+            }
+        };
+
+        PdfObject makeScalar(const std::string& text)
+        {
+            PdfObject result;
+            result.text = text;
+            return result;
+        }
+
+        PdfObject makeReference(int number)
+        {
+            PdfObject result;
+            result.kind   = PdfObject::Kind::Reference;
+            result.number = number;
+            return result;
+        }
+
+        // ================================================================== //
+        // parser
+
+        std::optional<size_t> getDirectInteger(const PdfObject* object)
+        {
+            // *INDENT-OFF*
+            if (!object || object->kind != PdfObject::Kind::Scalar || object->text.empty()) {return std::nullopt;}
+            if (!std::all_of(object->text.begin(), object->text.end(), [] (char c) {return c >= '0' && c <= '9';})) {return std::nullopt;}
+            // *INDENT-ON*
+            return std::stoul(object->text);
+        }
+
+
+        class PdfLexer
+        {
+            private:
+                std::string_view source;
+                size_t           position = 0u;
+
+                static bool isWhitespace(char c)
+                {
+                    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\0';
+                }
+
+                static bool isDelimiter(char c)
+                {
+                    return std::string_view("()<>[]{}/%").find(c) != std::string_view::npos;
+                }
+
+                static bool isInteger(std::string_view token)
+                {
+                    return !token.empty() && std::all_of(token.begin(), token.end(), [] (char c) {return c >= '0' && c <= '9';});
+                }
+
+                [[noreturn]] void fail(const std::string& what) const
+                {
+                    throw FileIOError("Could not parse PDF file: " + what + " at offset " + std::to_string(position));
+                }
+
+                std::string_view readRegular()
+                {
+                    const size_t start = position;
+                    while (position < source.size() && !isWhitespace(source[position]) && !isDelimiter(source[position]))
+                    {
+                        ++position;
+                    }
+                    return source.substr(start, position - start);
+                }
+
+                std::string_view readLiteralString()
+                {
+                    const size_t start = position++;
+                    for (int depth = 1; depth;)
+                    {
+                        // *INDENT-OFF*
+                        if (position >= source.size()) {fail("unterminated string");}
+                        // *INDENT-ON*
+
+                        switch (source[position++])
+                        {
+                            // *INDENT-OFF*
+                            case '\\': ++position; break;
+                            case '(':  ++depth;    break;
+                            case ')':  --depth;    break;
+                            // *INDENT-ON*
+                        }
+                    }
+                    return source.substr(start, position - start);
+                }
+
+                std::string_view readDelimited(char terminator)
+                {
+                    const size_t end = source.find(terminator, position);
+                    // *INDENT-OFF*
+                    if (end == std::string_view::npos) {fail("unterminated token");}
+                    // *INDENT-ON*
+
+                    const auto result = source.substr(position, end + 1u - position);
+                    position = end + 1u;
+                    return result;
+                }
+
+            public:
+                PdfLexer(std::string_view source, size_t position = 0u) :
+                    source(source), position(position)
+                {}
+
+                size_t getPosition() const
+                {
+                    return position;
+                }
+
+                bool atEnd()
+                {
+                    skipWhitespace();
+                    return position >= source.size();
+                }
+
+                void skipWhitespace()
+                {
+                    while (position < source.size())
+                    {
+                        if (source[position] == '%')
+                        {
+                            // *INDENT-OFF*
+                            while (position < source.size() && source[position] != '\n' && source[position] != '\r') {++position;}
+                            // *INDENT-ON*
+                        }
+                        else if (isWhitespace(source[position]))
+                        {
+                            ++position;
+                        }
+                        else
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                //! @brief consumes `keyword` if it is the next token.
+                bool accept(std::string_view keyword)
+                {
+                    skipWhitespace();
+                    const size_t start = position;
+                    // *INDENT-OFF*
+                    if (readRegular() == keyword) {return true;}
+                    // *INDENT-ON*
+                    position = start;
+                    return false;
+                }
+
+                //! @brief skips the next token, or a single delimiter.
+                void skipToken()
+                {
+                    skipWhitespace();
+                    // *INDENT-OFF*
+                    if (readRegular().empty()) {++position;}
+                    // *INDENT-ON*
+                }
+
+                //! @brief consumes `N G obj` and returns N, or returns -1 without consuming anything.
+                int acceptObjectHeader()
+                {
+                    skipWhitespace();
+                    const size_t start = position;
+
+                    const auto number = readRegular();
+                    skipWhitespace();
+                    const auto generation = readRegular();
+
+                    if (isInteger(number) && isInteger(generation) && accept("obj"))
+                    {
+                        return std::stoi(std::string(number));
+                    }
+
+                    position = start;
+                    return -1;
+                }
+
+                PdfObject parseObject()
+                {
+                    skipWhitespace();
+                    // *INDENT-OFF*
+                    if (position >= source.size()) {fail("unexpected end of file");}
+                    // *INDENT-ON*
+
+                    PdfObject result;
+                    const char c = source[position];
+
+                    if (c == '/')
+                    {
+                        ++position;
+                        result.text = "/" + std::string(readRegular());
+                    }
+                    else if (c == '(')
+                    {
+                        result.text = readLiteralString();
+                    }
+                    else if (c == '<' && source.substr(position, 2) == "<<")
+                    {
+                        position += 2u;
+                        result.kind = PdfObject::Kind::Dictionary;
+                        while (true)
+                        {
+                            skipWhitespace();
+                            if (source.substr(position, 2) == ">>")
+                            {
+                                position += 2u;
+                                break;
+                            }
+
+                            const PdfObject key = parseObject();
+                            // *INDENT-OFF*
+                            if (key.text.empty() || key.text[0] != '/') {fail("dictionary key expected");}
+                            // *INDENT-ON*
+                            result.entries.emplace_back(key.text, parseObject());
+                        }
+                    }
+                    else if (c == '<')
+                    {
+                        result.text = readDelimited('>');
+                    }
+                    else if (c == '[')
+                    {
+                        ++position;
+                        result.kind = PdfObject::Kind::Array;
+                        while (true)
+                        {
+                            skipWhitespace();
+                            if (position < source.size() && source[position] == ']')
+                            {
+                                ++position;
+                                break;
+                            }
+                            result.items.push_back(parseObject());
+                        }
+                    }
+                    else
+                    {
+                        const auto token = readRegular();
+                        // *INDENT-OFF*
+                        if (token.empty()) {fail("unexpected delimiter");}
+                        // *INDENT-ON*
+
+                        if (isInteger(token))          // might start a reference `N G R`
+                        {
+                            const size_t afterNumber = position;
+                            skipWhitespace();
+                            const auto generation = readRegular();
+                            if (isInteger(generation) && accept("R"))
+                            {
+                                return makeReference(std::stoi(std::string(token)));
+                            }
+                            position = afterNumber;
+                        }
+
+                        result.text = token;
+                    }
+
+                    return result;
+                }
+
+                //! @brief returns the value of the object `number` if it is an integer, searching the entire source.
+                std::optional<size_t> findIndirectInteger(int number) const
+                {
+                    const std::string header = std::to_string(number) + " 0 obj";
+
+                    for (size_t at = source.find(header); at != std::string_view::npos; at = source.find(header, at + 1u))
+                    {
+                        // *INDENT-OFF*
+                        if (at && !isWhitespace(source[at - 1])) {continue;}
+                        // *INDENT-ON*
+
+                        PdfLexer lexer(source, at + header.size());
+                        const PdfObject value = lexer.parseObject();
+                        return getDirectInteger(&value);
+                    }
+
+                    return std::nullopt;
+                }
+
+                //! @brief reads the content of a stream, after the keyword `stream`, given its length if known.
+                std::string readStreamData(std::optional<size_t> length)
+                {
+                    // *INDENT-OFF*
+                    if      (source.substr(position, 2) == "\r\n") {position += 2u;}
+                    else if (source.substr(position, 1) == "\n")   {++position;}
+                    // *INDENT-ON*
+
+                    size_t end = (length ? position + length.value() : source.size());
+                    if (!length || end > source.size() || source.substr(end).find("endstream") > 2u)
+                    {
+                        // length is indirect or wrong: the data end before the keyword, less the end of line
+                        end = source.find("endstream", position);
+                        // *INDENT-OFF*
+                        if (end == std::string_view::npos) {fail("unterminated stream");}
+                        if (end > position && source[end - 1] == '\n') {--end;}
+                        if (end > position && source[end - 1] == '\r') {--end;}
+                        // *INDENT-ON*
+                    }
+
+                    std::string data(source.substr(position, end - position));
+                    position = end;
+                    accept("endstream");
+
+                    return data;
+                }
+        };
+
+        struct PdfDocument
+        {
+            std::map<int, PdfObject>    objects;
+            PdfObject                   trailer;
+
+            const PdfObject& resolve(const PdfObject& object) const
+            {
+                static const PdfObject null = makeScalar("null");
+
+                // *INDENT-OFF*
+                if (object.kind != PdfObject::Kind::Reference) {return object;}
+                // *INDENT-ON*
+
+                const auto it = objects.find(object.number);
+                return (it == objects.end() ? null : it->second);
+            }
+        };
+
+        bool hasType(const PdfObject& object, std::string_view type)
+        {
+            const auto value = object.get("/Type");
+            return value && value->text == type;
+        }
+
+        void unpackObjectStream(PdfDocument& document, const PdfObject& stream)
+        {
+            const PdfObject* filter = stream.get("/Filter");
+            // *INDENT-OFF*
+            if (filter && filter->kind == PdfObject::Kind::Array && filter->items.size() == 1u) {filter = &filter->items[0];}
+            if (filter && filter->text != "/FlateDecode") {throw UnsupportedOperationError("Unsupported filter in PDF object stream");}
+            if (stream.get("/DecodeParms"))               {throw UnsupportedOperationError("Unsupported predictor in PDF object stream");}
+            // *INDENT-ON*
+
+            const auto count = getDirectInteger(stream.get("/N"));
+            const auto first = getDirectInteger(stream.get("/First"));
+            // *INDENT-OFF*
+            if (!count || !first) {throw FileIOError("Could not parse PDF file: incomplete object stream");}
+            // *INDENT-ON*
+
+            const std::string content = (filter ? Inflater().inflate(stream.data) : stream.data);
+            const std::string_view contentView(content);
+
+            PdfLexer header(contentView);
+            for (size_t i = 0u; i < count.value(); ++i)
+            {
+                const PdfObject numberObject = header.parseObject();
+                const PdfObject offsetObject = header.parseObject();
+                const auto      number       = getDirectInteger(&numberObject);
+                const auto      offset       = getDirectInteger(&offsetObject);
+                // *INDENT-OFF*
+                if (!number || !offset) {throw FileIOError("Could not parse PDF file: corrupt object stream");}
+                // *INDENT-ON*
+
+                PdfLexer body(contentView, first.value() + offset.value());
+                document.objects.try_emplace(number.value(), body.parseObject());     // objects outside of streams take precedence
+            }
+        }
+
+        PdfDocument readPdf(const std::string& filename)
+        {
+            std::ifstream hFile(filename, std::ios_base::binary);
+            // *INDENT-OFF*
+            if (!hFile.is_open()) {throw FileIOError("Could not open '" + filename + "'");}
+            // *INDENT-ON*
+            const std::string source((std::istreambuf_iterator<char>(hFile)), std::istreambuf_iterator<char>());
+
+            // *INDENT-OFF*
+            if (!source.starts_with("%PDF-")) {throw FileIOError("'" + filename + "' is not a PDF file");}
+            // *INDENT-ON*
+
+            PdfDocument document;
+            std::vector<const PdfObject*> objectStreams;
+            PdfLexer lexer(source);
+
+            /* Scan for objects instead of following the cross reference table: this survives the
+             * inaccurate offsets of some producers and makes incremental updates override earlier
+             * definitions, as the later one is read last.
+             */
+            while (!lexer.atEnd())
+            {
+                if (const int number = lexer.acceptObjectHeader(); number >= 0)
+                {
+                    PdfObject object = lexer.parseObject();
+                    if (object.kind == PdfObject::Kind::Dictionary && lexer.accept("stream"))
+                    {
+                        object.kind = PdfObject::Kind::Stream;
+                        const PdfObject* length = object.get("/Length");
+                        object.data = lexer.readStreamData(length && length->kind == PdfObject::Kind::Reference ? lexer.findIndirectInteger(length->number) : getDirectInteger(length));
+                    }
+                    lexer.accept("endobj");
+
+                    // *INDENT-OFF*
+                    if (hasType(object, "/XRef")) {document.trailer = object;}     // cross reference streams double as trailers
+                    // *INDENT-ON*
+                    document.objects[number] = std::move(object);
+                }
+                else if (lexer.accept("trailer"))
+                {
+                    document.trailer = lexer.parseObject();
+                }
+                else if (lexer.accept("xref"))
+                {
+                    // *INDENT-OFF*
+                    while (!lexer.atEnd() && !lexer.accept("trailer")) {lexer.skipToken();}
+                    if (!lexer.atEnd()) {document.trailer = lexer.parseObject();}
+                    // *INDENT-ON*
+                }
+                else
+                {
+                    lexer.skipToken();
+                }
+            }
+
+            // *INDENT-OFF*
+            if (document.trailer.get("/Encrypt")) {throw UnsupportedOperationError("Cannot merge encrypted PDF file '" + filename + "'");}
+            if (!document.trailer.get("/Root"))   {throw FileIOError("Could not parse PDF file '" + filename + "': no document catalog");}
+            // *INDENT-ON*
+
+            for (auto& [number, object] : document.objects)
+            {
+                // *INDENT-OFF*
+                if (object.kind == PdfObject::Kind::Stream && hasType(object, "/ObjStm")) {objectStreams.push_back(&object);}
+                // *INDENT-ON*
+            }
+            for (const auto stream : objectStreams)
+            {
+                unpackObjectStream(document, *stream);
+            }
+
+            return document;
+        }
+
+        // ================================================================== //
+        // merger
+
+        struct PageNode
+        {
+            int         number;             //!< original object number, or -1 for direct objects
+            PdfObject   dictionary;
+        };
+
+        void collectPages(const PdfDocument& document, const PdfObject& node, int number, PdfObject inherited, std::vector<PageNode>& pages, std::vector<int>& treeNodes, int depth = 0)
+        {
+            static const std::array<std::string, 4> inheritable = {"/Resources", "/MediaBox", "/CropBox", "/Rotate"};
+
+            const PdfObject& dictionary = document.resolve(node);
+            // *INDENT-OFF*
+            if (depth > 64) {throw FileIOError("Could not parse PDF file: page tree too deep");}
+            if (node.kind == PdfObject::Kind::Reference) {number = node.number;}
+            // *INDENT-ON*
+
+            if (hasType(dictionary, "/Page"))
+            {
+                PdfObject page = dictionary;
+                for (const auto& key : inheritable)
+                {
+                    // *INDENT-OFF*
+                    if (!page.get(key) && inherited.get(key)) {page.set(key, *inherited.get(key));}
+                    // *INDENT-ON*
+                }
+                page.erase("/Parent");
+                pages.push_back({number, page});
+                return;
+            }
+
+            // *INDENT-OFF*
+            if (number >= 0) {treeNodes.push_back(number);}
+            // *INDENT-ON*
+
+            for (const auto& key : inheritable)
+            {
+                // *INDENT-OFF*
+                if (dictionary.get(key)) {inherited.set(key, *dictionary.get(key));}
+                // *INDENT-ON*
+            }
+
+            const PdfObject* kids = dictionary.get("/Kids");
+            // *INDENT-OFF*
+            if (!kids) {return;}
+            // *INDENT-ON*
+
+            for (const auto& kid : document.resolve(*kids).items)
+            {
+                collectPages(document, kid, -1, inherited, pages, treeNodes, depth + 1);
+            }
+        }
+
+        void serialize(const PdfObject& object, std::string& output)
+        {
+            switch (object.kind)
+            {
+                case PdfObject::Kind::Scalar:
+                    output += object.text;
+                    break;
+
+                case PdfObject::Kind::Reference:
+                    output += std::to_string(object.number) + " 0 R";
+                    break;
+
+                case PdfObject::Kind::Array:
+                    output += "[";
+                    for (bool first = true; const auto& item : object.items)
+                    {
+                        // *INDENT-OFF*
+                        if (!first) {output += " ";}
+                        // *INDENT-ON*
+                        serialize(item, output);
+                        first = false;
+                    }
+                    output += "]";
+                    break;
+
+                case PdfObject::Kind::Dictionary:
+                case PdfObject::Kind::Stream:
+                    output += "<<";
+                    for (const auto& [key, value] : object.entries)
+                    {
+                        output += key + " ";
+                        serialize(value, output);
+                        output += " ";
+                    }
+                    output += ">>";
+
+                    if (object.kind == PdfObject::Kind::Stream)
+                    {
+                        output += "\nstream\n" + object.data + "\nendstream";
+                    }
+                    break;
+            }
+        }
+
+        class PdfWriter
+        {
+            private:
+                std::vector<PdfObject> objects;         //!< object number i + 1
+
+            public:
+                int reserve()
+                {
+                    objects.emplace_back();
+                    return objects.size();
+                }
+
+                void define(int number, PdfObject object)
+                {
+                    objects[number - 1] = std::move(object);
+                }
+
+                std::string finish(int root) const
+                {
+                    std::string output = "%PDF-1.7\n%\xE2\xE3\xCF\xD3\n";
+                    std::vector<size_t> offsets;
+
+                    for (size_t i = 0u; i < objects.size(); ++i)
+                    {
+                        offsets.push_back(output.size());
+                        output += std::to_string(i + 1u) + " 0 obj\n";
+                        serialize(objects[i], output);
+                        output += "\nendobj\n";
+                    }
+
+                    const size_t xrefOffset = output.size();
+                    output += "xref\n0 " + std::to_string(objects.size() + 1u) + "\n0000000000 65535 f \n";
+                    for (const size_t offset : offsets)
+                    {
+                        char line[21];
+                        std::snprintf(line, sizeof(line), "%010zu 00000 n \n", offset);
+                        output += line;
+                    }
+
+                    output += "trailer\n<</Size " + std::to_string(objects.size() + 1u) + " /Root " + std::to_string(root) + " 0 R>>\n";
+                    output += "startxref\n" + std::to_string(xrefOffset) + "\n%%EOF\n";
+
+                    return output;
+                }
+        };
+
+        //! @brief copies the objects of one document, renumbering them on the fly
+        class PdfCopier
+        {
+            private:
+                const PdfDocument&      document;
+                PdfWriter&              writer;
+                std::map<int, int>      numbers;            //!< original -> new
+                std::deque<int>         pending;            //!< original numbers to be copied
+
+            public:
+                PdfCopier(const PdfDocument& document, PdfWriter& writer) :
+                    document(document), writer(writer)
+                {}
+
+                void alias(int original, int number)
+                {
+                    numbers[original] = number;
+                }
+
+                int map(int original)
+                {
+                    const auto [it, inserted] = numbers.try_emplace(original, 0);
+                    if (inserted)
+                    {
+                        it->second = writer.reserve();
+                        pending.push_back(original);
+                    }
+                    return it->second;
+                }
+
+                PdfObject rewrite(const PdfObject& object)
+                {
+                    PdfObject result = object;
+
+                    // *INDENT-OFF*
+                    if (object.kind == PdfObject::Kind::Stream) {result.set("/Length", makeScalar(std::to_string(result.data.size())));}    // might be indirect
+                    // *INDENT-ON*
+
+                    switch (object.kind)
+                    {
+                        // *INDENT-OFF*
+                        case PdfObject::Kind::Reference: result.number = map(object.number); break;
+                        case PdfObject::Kind::Array:     for (auto& item : result.items) {item = rewrite(item);} break;
+                        case PdfObject::Kind::Dictionary:
+                        case PdfObject::Kind::Stream:    for (auto& entry : result.entries) {entry.second = rewrite(entry.second);} break;
+                        case PdfObject::Kind::Scalar:    break;
+                        // *INDENT-ON*
+                    }
+
+                    return result;
+                }
+
+                void copyPending()
+                {
+                    while (!pending.empty())
+                    {
+                        const int original = pending.front();
+                        pending.pop_front();
+
+                        const auto it = document.objects.find(original);
+                        writer.define(numbers[original], (it == document.objects.end() ? makeScalar("null") : rewrite(it->second)));
+                    }
+                }
+        };
+    }
+
+    void mergePdfFiles(const std::vector<std::string>& inputFilenames, const std::string& outputFilename)
+    {
+        PdfWriter writer;
+        const int catalog   = writer.reserve();
+        const int pageTree  = writer.reserve();
+
+        PdfObject kids;
+        kids.kind = PdfObject::Kind::Array;
+
+        for (const auto& filename : inputFilenames)
+        {
+            const PdfDocument document = readPdf(filename);
+
+            std::vector<PageNode> pages;
+            std::vector<int>      treeNodes;
+            const PdfObject&      root = document.resolve(*document.trailer.get("/Root"));
+            // *INDENT-OFF*
+            if (!root.get("/Pages")) {throw FileIOError("Could not parse PDF file '" + filename + "': no page tree");}
+            // *INDENT-ON*
+            collectPages(document, *root.get("/Pages"), -1, PdfObject(), pages, treeNodes);
+
+            /* References to the old page tree (e.g. from annotations) are redirected to the new one,
+             * so that copying does not pull in the pages of the entire input document.
+             */
+            PdfCopier copier(document, writer);
+            std::vector<int> pageNumbers;
+            for (const int node : treeNodes)
+            {
+                copier.alias(node, pageTree);
+            }
+            for (const auto& page : pages)
+            {
+                const int number = writer.reserve();
+                // *INDENT-OFF*
+                if (page.number >= 0) {copier.alias(page.number, number);}
+                // *INDENT-ON*
+                pageNumbers.push_back(number);
+            }
+
+            for (size_t i = 0u; i < pages.size(); ++i)
+            {
+                PdfObject page = copier.rewrite(pages[i].dictionary);
+                page.set("/Parent", makeReference(pageTree));
+                writer.define(pageNumbers[i], page);
+                kids.items.push_back(makeReference(pageNumbers[i]));
+            }
+
+            copier.copyPending();
+        }
+
+        PdfObject pages;
+        pages.kind = PdfObject::Kind::Dictionary;
+        pages.set("/Type",  makeScalar("/Pages"));
+        pages.set("/Kids",  kids);
+        pages.set("/Count", makeScalar(std::to_string(kids.items.size())));
+        writer.define(pageTree, pages);
+
+        PdfObject catalogDictionary;
+        catalogDictionary.kind = PdfObject::Kind::Dictionary;
+        catalogDictionary.set("/Type",  makeScalar("/Catalog"));
+        catalogDictionary.set("/Pages", makeReference(pageTree));
+        writer.define(catalog, catalogDictionary);
+
+        std::fstream hFile = openOrThrow(outputFilename, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        hFile << writer.finish(catalog);
+        // *INDENT-OFF*
+        if (!hFile.good()) {throw FileIOError("Could not write '" + outputFilename + "'");}
+        // *INDENT-ON*
+    }
+}
@@ -0,0 +1,23 @@
+#ifndef PDFMERGER_H
+#define PDFMERGER_H
+
+#include <string>
+#include <vector>
+
+namespace Plotypus
+{
+    /**
+     * @brief writes the pages of all `inputFilenames`, in order, into the single PDF file `outputFilename`.
+     *
+     * This is a minimal merger meant for the single-page files rendered by gnuplot terminals like pdfcairo,
+     * not a general PDF tool: objects are collected by scanning the files rather than by their cross
+     * reference tables, compressed object streams are read with a built-in inflater, and the document
+     * structure apart from the pages (outlines, named destinations, metadata) is dropped.
+     *
+     * Throws a FileIOError if a file cannot be read, written or parsed, and an UnsupportedOperationError for
+     * encrypted files and object streams with filters other than FlateDecode.
+     */
+    void mergePdfFiles(const std::vector<std::string>& inputFilenames, const std::string& outputFilename);
+}
+
+#endif // PDFMERGER_H
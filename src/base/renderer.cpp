@@ -0,0 +1,179 @@
+#include <filesystem>
+
+#include "util.h"
+
+#include "renderer.h"
+
+namespace fs = std::filesystem;
+
+namespace Plotypus
+{
+    std::future<GnuplotResult> SystemGnuplotRenderer::render(const std::string& scriptFilename, const GnuplotLaunchOptions& options)
+    {
+        return runGnuplotAsync(scriptFilename, options);
+    }
+
+    // ====================================================================== //
+
+    void GnuplotPoolRenderer::work(GnuplotProcess& process)
+    {
+        std::unique_lock lock(mutex);
+
+        while (true)
+        {
+            jobAvailable.wait(lock, [this] {return stopping || !queue.empty();});
+
+            // *INDENT-OFF*
+            if (queue.empty()) {return;}
+            // *INDENT-ON*
+
+            Job job = std::move(queue.front());
+            queue.pop();
+            lock.unlock();
+
+            try
+            {
+                if (process.getExecutable() != job.executable)
+                {
+                    process.stop();
+                    process.setExecutable(job.executable);
+                }
+
+                GnuplotResult result;
+                const auto start   = std::chrono::steady_clock::now();
+                const bool success = process.execute("load " + quotedGnuplotString(job.scriptFilename), job.timeout);
+                result.errorOutput = process.getErrorOutput();
+
+                // a script error yields the exit code of a gnuplot that runs the script on its own
+                // *INDENT-OFF*
+                if      (success)                   {}
+                else if (process.hasScriptError())  {result.exitCode = 1;}
+                else if (process.hasTimedOut())     {result.exitCode = -1; result.timedOut = true; result.errorOutput += "gnuplot did not finish the script in time\n";}
+                else                                {result.exitCode = -1; result.errorOutput += "gnuplot terminated before finishing the script\n";}
+                // *INDENT-ON*
+                result.wallTime = std::chrono::steady_clock::now() - start;
+
+                job.result.set_value(result);
+            }
+            catch (...)
+            {
+                job.result.set_exception(std::current_exception());
+            }
+
+            lock.lock();
+        }
+    }
+
+    GnuplotPoolRenderer::GnuplotPoolRenderer(size_t processCount)
+    {
+        // *INDENT-OFF*
+        if (!processCount) {processCount = std::max(1u, std::thread::hardware_concurrency());}
+        // *INDENT-ON*
+
+        for (size_t i = 0u; i < processCount; ++i)
+        {
+            processes.push_back(std::make_unique<GnuplotProcess>());
+        }
+        for (auto& process : processes)
+        {
+            workers.emplace_back(&GnuplotPoolRenderer::work, this, std::ref(*process));
+        }
+    }
+
+    GnuplotPoolRenderer::~GnuplotPoolRenderer()
+    {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        jobAvailable.notify_all();
+        workers.clear();                // joins; the processes stop on destruction
+    }
+
+    size_t GnuplotPoolRenderer::getProcessCount() const
+    {
+        return processes.size();
+    }
+
+    std::future<GnuplotResult> GnuplotPoolRenderer::render(const std::string& scriptFilename, const GnuplotLaunchOptions& options)
+    {
+        // *INDENT-OFF*
+        if (options.captureOutput) {return runGnuplotAsync(scriptFilename, options);}
+        // *INDENT-ON*
+
+        Job job = {scriptFilename, options.executable, options.timeout, std::promise<GnuplotResult>()};
+        auto result = job.result.get_future();
+        {
+            std::lock_guard lock(mutex);
+            queue.push(std::move(job));
+        }
+        jobAvailable.notify_one();
+
+        return result;
+    }
+
+    // ====================================================================== //
+
+    std::chrono::duration<double> RecordingRenderer::getSimulatedDuration() const
+    {
+        std::lock_guard lock(mutex);
+        return simulatedDuration;
+    }
+
+    void RecordingRenderer::setSimulatedDuration(const std::chrono::duration<double>& newSimulatedDuration)
+    {
+        std::lock_guard lock(mutex);
+        simulatedDuration = newSimulatedDuration;
+    }
+
+    std::vector<RenderRecord> RecordingRenderer::getRecords() const
+    {
+        std::lock_guard lock(mutex);
+        return records;
+    }
+
+    size_t RecordingRenderer::getRenderCount() const
+    {
+        std::lock_guard lock(mutex);
+        return records.size();
+    }
+
+    void RecordingRenderer::clear()
+    {
+        std::lock_guard lock(mutex);
+        records.clear();
+    }
+
+    std::future<GnuplotResult> RecordingRenderer::render(const std::string& scriptFilename, const GnuplotLaunchOptions&)
+    {
+        const auto now = std::chrono::steady_clock::now();
+
+        std::error_code error;
+        const auto size = fs::file_size(scriptFilename, error);
+
+        GnuplotResult result;
+        {
+            std::lock_guard lock(mutex);
+
+            // *INDENT-OFF*
+            if (records.empty()) {firstRender = now;}
+            // *INDENT-ON*
+
+            records.push_back({scriptFilename, (error ? 0u : static_cast<size_t>(size)), now - firstRender});
+            result.wallTime = simulatedDuration;
+        }
+
+        if (result.wallTime > std::chrono::duration<double>::zero())
+        {
+            return std::async(std::launch::async, [result] ()
+            {
+                std::this_thread::sleep_for(result.wallTime);
+                return result;
+            });
+        }
+
+        std::promise<GnuplotResult> done;
+        done.set_value(result);
+        return done.get_future();
+    }
+}
@@ -0,0 +1,129 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../definitions/types.h"
+
+#include "gnuplotprocess.h"
+
+namespace Plotypus
+{
+    /**
+     * @brief backend that turns a script file into the output it describes
+     *
+     * A Report hands every script it runs to its renderer (see Report::setRenderer). render may be called
+     * from several threads at once, e.g. for Report::setParallelPages.
+     */
+    class Renderer
+    {
+        public:
+            virtual ~Renderer() = default;
+
+            /**
+             * @brief starts rendering the script file `scriptFilename`, and returns the outcome once it is done.
+             *
+             * The script and the files it reads must not change before the future is ready. Errors that
+             * prevent rendering altogether, such as a missing gnuplot executable, may be thrown by render or
+             * stored in the future.
+             */
+            virtual std::future<GnuplotResult> render(const std::string& scriptFilename, const GnuplotLaunchOptions& options) = 0;
+    };
+
+    // ====================================================================== //
+
+    //! @brief runs each script in a new gnuplot process (see runGnuplotAsync), honouring all GnuplotLaunchOptions.
+    class SystemGnuplotRenderer : public Renderer
+    {
+        public:
+            virtual std::future<GnuplotResult> render(const std::string& scriptFilename, const GnuplotLaunchOptions& options);
+    };
+
+    // ====================================================================== //
+
+    /**
+     * @brief runs scripts in a pool of long-lived gnuplot processes (see GnuplotProcess)
+     *
+     * Saves starting gnuplot for each script. Scripts are queued and taken by the first idle process;
+     * render returns right away. Of the GnuplotLaunchOptions, only the executable and the timeout apply:
+     * a process is restarted when the executable changes, and killed when a script exceeds the timeout.
+     * Scripts asking for captured output are run by runGnuplotAsync instead, as the processes' output is
+     * used to track their progress. gnuplot's messages go to the standard error of the client process; a
+     * script fails only if its process dies or times out (see GnuplotProcess::execute).
+     */
+    class GnuplotPoolRenderer : public Renderer
+    {
+        private:
+            struct Job
+            {
+                std::string                     scriptFilename;
+                std::string                     executable;
+                std::chrono::duration<double>   timeout;
+                std::promise<GnuplotResult>     result;
+            };
+
+            std::queue<Job>     queue;
+            bool                stopping = false;
+
+            std::mutex                                      mutex;
+            std::condition_variable                         jobAvailable;
+            std::vector<std::unique_ptr<GnuplotProcess>>    processes;
+            std::vector<std::jthread>                       workers;        //!< declared last, so that they are joined before the members they use are destroyed
+
+            void work(GnuplotProcess& process);
+
+        public:
+            //! @brief starts `processCount` workers with one gnuplot process each, or one per hardware thread if `processCount` is zero.
+            GnuplotPoolRenderer(size_t processCount = 0u);
+            //! @brief renders all queued scripts, then stops the processes.
+            ~GnuplotPoolRenderer();
+
+            GnuplotPoolRenderer(const GnuplotPoolRenderer&)            = delete;
+            GnuplotPoolRenderer& operator=(const GnuplotPoolRenderer&) = delete;
+
+            size_t getProcessCount() const;
+
+            virtual std::future<GnuplotResult> render(const std::string& scriptFilename, const GnuplotLaunchOptions& options);
+    };
+
+    // ====================================================================== //
+
+    /**
+     * @brief stand-in that records the scripts it is given instead of rendering them
+     *
+     * Lets the generation of data and scripts be timed end to end on machines without gnuplot. Every
+     * script succeeds; with a simulated duration, the result becomes ready after that time and reports it
+     * as GnuplotResult::wallTime, so that throughput can be estimated for a given rendering cost.
+     */
+    class RecordingRenderer : public Renderer
+    {
+        private:
+            std::chrono::duration<double>           simulatedDuration = std::chrono::duration<double>::zero();
+            std::vector<RenderRecord>               records;
+            std::chrono::steady_clock::time_point   firstRender;
+
+            mutable std::mutex mutex;
+
+        public:
+            std::chrono::duration<double>   getSimulatedDuration() const;
+            void                            setSimulatedDuration(const std::chrono::duration<double>& newSimulatedDuration);
+
+            //! @brief returns the scripts rendered so far, in order of the calls of render.
+            std::vector<RenderRecord>       getRecords() const;
+            size_t                          getRenderCount() const;
+            //! @brief forgets all records; the times of the next records count from the next call of render.
+            void                            clear();
+
+            virtual std::future<GnuplotResult> render(const std::string& scriptFilename, const GnuplotLaunchOptions& options);
+    };
+}
+
+#endif // RENDERER_H
@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <exception>
+
+#include "../definitions/errors.h"
+
+#include "gnuplotprocess.h"
+#include "report.h"
+
+#include "renderfarm.h"
+
+namespace Plotypus
+{
+    namespace
+    {
+        //! @brief printed to stderr after each but the last script of a batch, to tell where gnuplot stopped
+        const std::string scriptDoneMarker = "plotypus: script done";
+    }
+
+    bool RenderFarm::Job::operator<(const Job& other) const
+    {
+        // *INDENT-OFF*
+        if (priority != other.priority) {return priority < other.priority;}
+        // *INDENT-ON*
+        return sequence > other.sequence;
+    }
+
+    void RenderFarm::work()
+    {
+        std::unique_lock lock(mutex);
+
+        while (true)
+        {
+            jobAvailable.wait(lock, [this] {return stopping || (!paused && !queue.empty());});
+
+            // *INDENT-OFF*
+            if (queue.empty()) {return;}
+            // *INDENT-ON*
+
+            std::vector<std::string> batch;
+            const int priority = queue.top().priority;
+            while (!queue.empty() && queue.top().priority == priority && batch.size() < std::max<size_t>(batchSize, 1u))
+            {
+                batch.push_back(queue.top().script);
+                queue.pop();
+            }
+
+            const auto options = launchOptions;
+            ++activeWorkers;
+            lock.unlock();
+
+            size_t rendered = 0u;
+            std::vector<std::pair<std::string, GnuplotResult>> failed;
+
+            // gnuplot stops at the first failing script, so the scripts before it are done
+            for (size_t next = 0u; next < batch.size(); ++next)
+            {
+                size_t completed = 0u;
+                auto   result    = render({batch.begin() + next, batch.end()}, options, completed);
+                if (isSuccess(result))
+                {
+                    rendered += batch.size() - next;
+                    break;
+                }
+
+                completed  = std::min(completed, batch.size() - next - 1u);
+                rendered  += completed;
+                next      += completed;
+
+                // a script failing after others is rendered again alone, to report its own result
+                // *INDENT-OFF*
+                if (completed) {result = render({batch[next]}, options, completed);}
+                if (isSuccess(result))  {++rendered;}
+                else                    {failed.emplace_back(batch[next], result);}
+                // *INDENT-ON*
+            }
+
+            lock.lock();
+            statistics.renderedScripts += rendered;
+            statistics.failedScripts.insert(statistics.failedScripts.end(), failed.begin(), failed.end());
+
+            --activeWorkers;
+            // *INDENT-OFF*
+            if (isIdle()) {idle.notify_all();}
+            // *INDENT-ON*
+        }
+    }
+
+    GnuplotResult RenderFarm::render(const std::vector<std::string>& scripts, const GnuplotLaunchOptions& options, size_t& completed)
+    {
+        std::vector<std::string> arguments;
+        for (const auto& script : scripts)
+        {
+            // *INDENT-OFF*
+            if (!arguments.empty()) {arguments.insert(arguments.end(), {"-e", "set print; print \"" + scriptDoneMarker + "\"; reset session"});}
+            // *INDENT-ON*
+            arguments.push_back(script);
+        }
+
+        GnuplotResult result;
+        try
+        {
+            result = runGnuplotAsync(arguments, options).get();
+        }
+        catch (const std::exception& e)
+        {
+            result.exitCode    = -1;
+            result.errorOutput = e.what();
+        }
+
+        completed = 0u;
+        const std::string markerLine = scriptDoneMarker + "\n";
+        for (auto position = result.errorOutput.find(markerLine); position != std::string::npos; position = result.errorOutput.find(markerLine, position + markerLine.size()))
+        {
+            ++completed;
+        }
+
+        std::lock_guard lock(mutex);
+        ++statistics.gnuplotRuns;
+        statistics.busyTime += result.wallTime;
+
+        return result;
+    }
+
+    bool RenderFarm::isSuccess(const GnuplotResult& result)
+    {
+        return !result.exitCode && !result.timedOut;
+    }
+
+    bool RenderFarm::isIdle() const
+    {
+        return !activeWorkers && (paused || queue.empty());
+    }
+
+    // ====================================================================== //
+
+    RenderFarm::RenderFarm(size_t workerCount, size_t batchSize) :
+        batchSize(batchSize)
+    {
+        // *INDENT-OFF*
+        if (!workerCount) {workerCount = std::max(1u, std::thread::hardware_concurrency());}
+        // *INDENT-ON*
+
+        for (size_t i = 0u; i < workerCount; ++i)
+        {
+            workers.emplace_back(&RenderFarm::work, this);
+        }
+    }
+
+    RenderFarm::~RenderFarm()
+    {
+        {
+            std::lock_guard lock(mutex);
+            paused   = false;
+            stopping = true;
+        }
+        jobAvailable.notify_all();
+        workers.clear();                // joins
+    }
+
+    size_t RenderFarm::getWorkerCount() const
+    {
+        return workers.size();
+    }
+
+    size_t RenderFarm::getBatchSize() const
+    {
+        std::lock_guard lock(mutex);
+        return batchSize;
+    }
+
+    void RenderFarm::setBatchSize(size_t newBatchSize)
+    {
+        std::lock_guard lock(mutex);
+        batchSize = newBatchSize;
+    }
+
+    GnuplotLaunchOptions RenderFarm::getLaunchOptions() const
+    {
+        std::lock_guard lock(mutex);
+        return launchOptions;
+    }
+
+    void RenderFarm::setLaunchOptions(const GnuplotLaunchOptions& newLaunchOptions)
+    {
+        std::lock_guard lock(mutex);
+        launchOptions = newLaunchOptions;
+    }
+
+    bool RenderFarm::getPaused() const
+    {
+        std::lock_guard lock(mutex);
+        return paused;
+    }
+
+    void RenderFarm::setPaused(bool newPaused)
+    {
+        {
+            std::lock_guard lock(mutex);
+            paused = newPaused;
+        }
+        jobAvailable.notify_all();
+        idle.notify_all();
+    }
+
+    // ====================================================================== //
+
+    void RenderFarm::submit(const std::string& scriptFilename, int priority)
+    {
+        submit(std::vector<std::string>({scriptFilename}), priority);
+    }
+
+    void RenderFarm::submit(const std::vector<std::string>& scriptFilenames, int priority)
+    {
+        {
+            std::lock_guard lock(mutex);
+
+            // *INDENT-OFF*
+            if (!submitted) {firstSubmission = std::chrono::steady_clock::now();}
+            // *INDENT-ON*
+
+            for (const auto& script : scriptFilenames)
+            {
+                queue.push({script, priority, submitted++});
+            }
+        }
+        jobAvailable.notify_all();
+    }
+
+    void RenderFarm::submit(const Report& report, int priority)
+    {
+        // *INDENT-OFF*
+        if (report.getDataTransport() == DataTransport::MemoryFiles) {throw UnsupportedOperationError("Cannot queue a report with in-memory data transport");}
+        // *INDENT-ON*
+
+        report.writeDat();
+        const auto script = report.writeScriptFile();
+
+        // *INDENT-OFF*
+        if (!script.empty()) {submit(script, priority);}       // else skipped as unchanged
+        // *INDENT-ON*
+    }
+
+    void RenderFarm::wait()
+    {
+        std::unique_lock lock(mutex);
+        idle.wait(lock, [this] {return isIdle();});
+    }
+
+    RenderFarmStatistics RenderFarm::getStatistics() const
+    {
+        std::lock_guard lock(mutex);
+
+        RenderFarmStatistics result = statistics;
+        // *INDENT-OFF*
+        if (submitted) {result.elapsedTime = std::chrono::steady_clock::now() - firstSubmission;}
+        // *INDENT-ON*
+
+        const size_t finished = result.renderedScripts + result.failedScripts.size();
+        result.throughput = (result.elapsedTime.count() > 0. ? finished / result.elapsedTime.count() : 0.);
+
+        return result;
+    }
+}
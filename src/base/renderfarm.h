@@ -0,0 +1,108 @@
+#ifndef RENDERFARM_H
+#define RENDERFARM_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../definitions/types.h"
+
+namespace Plotypus
+{
+    class Report;
+
+    /**
+     * @brief queue of gnuplot scripts rendered by a pool of concurrent gnuplot processes
+     *
+     * Scripts are rendered in order of descending priority, and in order of submission among equal
+     * priorities. To amortize the startup of gnuplot, a worker passes up to `batchSize` scripts of the same
+     * priority to a single gnuplot process, separated by `reset session`. Since gnuplot stops at the first
+     * failing script, a failed batch is resumed after the failing script; that one is rendered again
+     * alone if other scripts preceded it in the process, to report its own result.
+     *
+     * All methods may be called from any thread.
+     */
+    class RenderFarm
+    {
+        private:
+            struct Job
+            {
+                std::string script;
+                int         priority;
+                size_t      sequence;
+
+                bool operator<(const Job& other) const;     //!< orders by priority, then by order of submission
+            };
+
+            size_t                  batchSize;
+            GnuplotLaunchOptions    launchOptions;
+            bool                    paused          = false;
+            bool                    stopping        = false;
+
+            std::priority_queue<Job>                queue;
+            size_t                                  submitted       = 0u;
+            size_t                                  activeWorkers   = 0u;
+            RenderFarmStatistics                    statistics;
+            std::chrono::steady_clock::time_point   firstSubmission;
+
+            mutable std::mutex          mutex;
+            std::condition_variable     jobAvailable;
+            std::condition_variable     idle;
+            std::vector<std::jthread>   workers;        //!< declared last, so that they are joined before the members they use are destroyed
+
+            void work();
+            //! @brief `completed` receives the number of scripts gnuplot finished before it stopped
+            GnuplotResult render(const std::vector<std::string>& scripts, const GnuplotLaunchOptions& options, size_t& completed);
+            static bool isSuccess(const GnuplotResult& result);
+            bool isIdle() const;                            //!< to be called with the mutex held
+
+        public:
+            //! @brief starts `workerCount` workers, or one per hardware thread if `workerCount` is zero.
+            RenderFarm(size_t workerCount = 0u, size_t batchSize = 1u);
+            //! @brief renders all queued scripts, then stops the workers.
+            ~RenderFarm();
+
+            RenderFarm(const RenderFarm&)            = delete;
+            RenderFarm& operator=(const RenderFarm&) = delete;
+
+            size_t                  getWorkerCount() const;
+            size_t                  getBatchSize() const;
+            //! @brief sets the maximum number of scripts per gnuplot process; applies to batches started afterwards.
+            void                    setBatchSize(size_t newBatchSize);
+            GnuplotLaunchOptions    getLaunchOptions() const;
+            //! @brief sets executable, timeout and resource limits of the gnuplot processes; the timeout applies per batch.
+            void                    setLaunchOptions(const GnuplotLaunchOptions& newLaunchOptions);
+            bool                    getPaused() const;
+            //! @brief while paused, no new batches are started, e.g. for queueing a set of scripts to be batched and prioritized together.
+            void                    setPaused(bool newPaused);
+
+            //! @brief queues the script file `scriptFilename` for rendering.
+            void submit(const std::string& scriptFilename, int priority = 0);
+            void submit(const std::vector<std::string>& scriptFilenames, int priority = 0);
+            /**
+             * @brief writes the data files and the script of `report` on the calling thread, and queues the script.
+             *
+             * The data files must not be changed until the script is rendered. Reports using
+             * DataTransport::MemoryFiles are rejected with an UnsupportedOperationError before anything is
+             * written, since their script refers to file descriptors that do not outlive the export.
+             */
+            void submit(const Report& report, int priority = 0);
+
+            /**
+             * @brief blocks until all queued scripts are rendered.
+             *
+             * While paused, or once paused by another thread, it only waits for the batches already being
+             * rendered and leaves the queued scripts in the queue.
+             */
+            void wait();
+
+            //! @brief returns counts and throughput since the first submission.
+            RenderFarmStatistics getStatistics() const;
+    };
+}
+
+#endif // RENDERFARM_H
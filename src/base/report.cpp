@@ -1,8 +1,20 @@
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+#include <unistd.h>
 
 #include "../definitions/errors.h"
+#include "../render/plotpainter.h"
+#include "../render/pngencoder.h"
+#include "../render/rastercanvas.h"
+#include "../render/svgcanvas.h"
+#include "../render/textcanvas.h"
 
+#include "pdfmerger.h"
 #include "report.h"
 
 namespace fs = std::filesystem;
@@ -12,6 +24,8 @@ namespace Plotypus
 {
     void Report::preprocessSheets(const std::string& extension) const
     {
+        const auto pixelWidth = (autoDecimation ? m_terminalInfoProvider.getPixelWidth() : std::nullopt);
+
         for (size_t i = 1u; auto sheet : sheets)
         {
             // *INDENT-OFF*
@@ -19,11 +33,205 @@ namespace Plotypus
 
             const std::string autoOutputFilename = getOutputFilename("", "_" + std::to_string(i));
             sheet->preprocessSheet(autoOutputFilename, extension);
+
+            const auto plotWithAxes = dynamic_cast<const PlotWithAxes*>(sheet);
+            if (plotWithAxes) {plotWithAxes->applyAutoCulling(autoCulling);}
+            if (plotWithAxes) {plotWithAxes->applyAutoDecimation(pixelWidth.value_or(0u));}
             ++i;
 
             if (verbose) {std::cout << "done." << std::endl;}
             // *INDENT-ON*
         }
+
+        // *INDENT-OFF*
+        if (dataTransport == DataTransport::MemoryFiles) {assignMemoryFiles();}
+        // *INDENT-ON*
+
+        applySharedDataFiles();
+        assignArchive();
+    }
+
+    void Report::shareDataFiles() const
+    {
+        std::vector<const DataView*>            dataViews;
+        std::vector<std::pair<size_t, size_t>>  positions;
+        for (size_t i = 0u; i < sheets.size(); ++i)
+        {
+            for (size_t j = 0u; auto dataView : sheets[i]->getDatDataViews())
+            {
+                // *INDENT-OFF*
+                if (dataView->getAutoGenerateDataFilename()) {dataViews.push_back(dataView); positions.emplace_back(i, j);}
+                // *INDENT-ON*
+                ++j;
+            }
+        }
+
+        // hashing reads all the data, hence it is spread like writing them
+        const size_t threadCount = (exportThreadCount ? exportThreadCount : std::max(1u, std::thread::hardware_concurrency()));
+
+        std::vector<std::optional<uint64_t>> fingerprints(dataViews.size());
+        runParallel(dataViews.size(), threadCount, [&] (const size_t k)
+        {
+            fingerprints[k] = dataViews[k]->getContentFingerprint();
+        });
+
+        /* Equal fingerprints are confirmed by comparing the data, as a hash collision would make a view
+         * plot the data of another one. The comparison only takes place for actual duplicates, or
+         * collisions, and then reads the data of both views once more.
+         */
+        std::unordered_map<uint64_t, std::vector<size_t>> candidates;      // views writing their own file, by fingerprint
+        for (size_t k = 0u; k < dataViews.size(); ++k)
+        {
+            // *INDENT-OFF*
+            if (!fingerprints[k]) {continue;}
+            // *INDENT-ON*
+
+            auto&      sameFingerprint = candidates[fingerprints[k].value()];
+            const auto original        = std::find_if(sameFingerprint.begin(), sameFingerprint.end(), [&] (const size_t candidate)
+            {
+                return dataViews[candidate]->hasEqualContent(*dataViews[k]);
+            });
+
+            if (original == sameFingerprint.end())
+            {
+                sameFingerprint.push_back(k);
+                continue;
+            }
+
+            const std::string filename = dataViews[*original]->getDataFilename();
+            sharedDataFilenames[positions[k]] = filename;
+            dataViews[k]->setDataFilename(filename);
+        }
+    }
+
+    void Report::applySharedDataFiles() const
+    {
+        // *INDENT-OFF*
+        if (!deduplicateData || inlineData || dataTransport == DataTransport::Archive) {return;}
+        // *INDENT-ON*
+
+        for (const auto& [position, filename] : sharedDataFilenames)
+        {
+            const auto& [i, j] = position;
+            // *INDENT-OFF*
+            if (i >= sheets.size()) {continue;}
+            // *INDENT-ON*
+
+            const auto dataViews = sheets[i]->getDatDataViews();
+            // *INDENT-OFF*
+            if (j < dataViews.size()) {dataViews[j]->setDataFilename(filename);}
+            // *INDENT-ON*
+        }
+    }
+
+    void Report::assignMemoryFiles() const
+    {
+        size_t k = 0u;
+        for (auto sheet : sheets)
+        {
+            for (auto dataView : sheet->getDatDataViews())
+            {
+                // *INDENT-OFF*
+                if (!dataView->getAutoGenerateDataFilename()) {continue;}
+                if (k == memoryFiles.size()) {memoryFiles.push_back(createMemoryFile(filenameBase + "_" + std::to_string(k)));}
+                // *INDENT-ON*
+
+                dataView->setDataFilename(getDescriptorPath(memoryFiles[k], !inheritsMemoryFiles()));
+                ++k;
+            }
+        }
+    }
+
+    void Report::closeMemoryFiles() const
+    {
+        for (const int fd : memoryFiles)
+        {
+            ::close(fd);
+        }
+        memoryFiles.clear();
+    }
+
+    bool Report::inheritsMemoryFiles() const
+    {
+        // the persistent process and those of other renderers may predate the files
+        return !persistentGnuplot && (m_renderer == &m_systemRenderer);
+    }
+
+    void Report::assignArchive() const
+    {
+        const std::string archiveFilename = getOutputFilename(extDat);
+
+        for (auto sheet : sheets)
+        {
+            for (auto dataView : sheet->getDatDataViews())
+            {
+                const bool archived = (dataTransport == DataTransport::Archive) && dataView->getAutoGenerateDataFilename() &&
+                                      dataView->getBinaryDataOutput() && !dataView->isFunction() && !dataView->isDummy();
+
+                // *INDENT-OFF*
+                if (archived)   {dataView->setDataFilename(archiveFilename);}       // keeps the slice of the last writeArchive
+                else            {dataView->setArchiveSlice(std::nullopt);}
+                // *INDENT-ON*
+            }
+        }
+    }
+
+    void Report::throwIfArchiveIncomplete() const
+    {
+        // *INDENT-OFF*
+        if (dataTransport != DataTransport::Archive || inlineData) {return;}
+        // *INDENT-ON*
+
+        const std::string archiveFilename = getOutputFilename(extDat);
+
+        for (auto sheet : sheets)
+        {
+            for (auto dataView : sheet->getDatDataViews())
+            {
+                // *INDENT-OFF*
+                if (dataView->getDataFilename() == archiveFilename && !dataView->getArchiveSlice()) {throw UnsupportedOperationError("Data archive '" + archiveFilename + "' has not been written; call writeDat before writing the script");}
+                // *INDENT-ON*
+            }
+        }
+    }
+
+    void Report::writeArchive() const
+    {
+        const std::string archiveFilename = getOutputFilename(extDat);
+
+        // *INDENT-OFF*
+        if (verbose) {std::cout << "writing data archive " << archiveFilename << " ..." << std::endl;}
+        // *INDENT-ON*
+
+        std::fstream hArchive = openOrThrow(archiveFilename, std::ios_base::out | std::ios_base::binary);
+        exportSummary.writtenDataFiles.push_back(archiveFilename);
+
+        for (auto sheet : sheets)
+        {
+            const auto sheetDataViews = sheet->getDatDataViews();
+
+            // *INDENT-OFF*
+            if (sheetDataViews.empty()) {sheet->writeDatData();}     // sheets that do not expose their views
+            // *INDENT-ON*
+
+            for (auto dataView : sheetDataViews)
+            {
+                // *INDENT-OFF*
+                if (dataView->getDataFilename() == archiveFilename) {dataView->writeArchiveData(hArchive); continue;}
+                // *INDENT-ON*
+
+                // *INDENT-OFF*
+                if (!dataView->hasDataFile()) {continue;}
+                // *INDENT-ON*
+
+                dataView->writeDatData();
+                exportSummary.writtenDataFiles.push_back(dataView->getDataFilename());
+            }
+        }
+
+        // *INDENT-OFF*
+        if (verbose) {std::cout << "done." << std::endl;}
+        // *INDENT-ON*
     }
 
     std::string Report::getOutputFilename(const std::string& extension, const std::string& infix) const
@@ -61,6 +269,61 @@ namespace Plotypus
         hFile << std::endl;
     }
 
+    void Report::writeScriptSetup(std::ostream& hFile, const std::string& outputFilename, size_t onlySheet) const
+    {
+        hFile << "# " << std::string(76, '=') << " #" << std::endl;
+        hFile << "# output setup" << std::endl << std::endl;
+
+        m_terminalInfoProvider.writeTerminalInfo(hFile);
+
+        // *INDENT-OFF*
+        if (m_terminalInfoProvider.getOutputToFile()) {
+            if (outputFilename.empty()) {hFile << "set output" << std::endl << std::endl;}        // standard output
+            else                        {hFile << "set output '" << outputFilename << "'" << std::endl << std::endl;}
+        }
+        // *INDENT-ON*
+
+        m_stylesCollection.writeStyles(hFile);
+
+        writeDatablocks(hFile, onlySheet);
+    }
+
+    void Report::writeDatablocks(std::ostream& hFile, size_t onlySheet) const
+    {
+        bool headerWritten = false;
+
+        for (size_t i = 1u; auto sheet : sheets)
+        {
+            // *INDENT-OFF*
+            if (onlySheet && i != onlySheet) {++i; continue;}
+            // *INDENT-ON*
+
+            for (size_t j = 1u; auto dataView : sheet->getDatDataViews())
+            {
+                const std::string name = "$data_" + std::to_string(i) + "_" + std::to_string(j);
+
+                // *INDENT-OFF*
+                if (!inlineData) {dataView->setDatablockName(""); continue;}
+
+                if (!headerWritten) {
+                    hFile << "# " << std::string(76, '=') << " #\n";
+                    hFile << "# data" << std::endl << std::endl;
+                    headerWritten = true;
+                }
+
+                if (dataView->writeDatablock(hFile, name)) {dataView->setDatablockName(name);}
+                else                                       {dataView->setDatablockName("");}
+                ++j;
+                // *INDENT-ON*
+            }
+            ++i;
+        }
+
+        // *INDENT-OFF*
+        if (headerWritten) {hFile << std::endl;}
+        // *INDENT-ON*
+    }
+
     // ====================================================================== //
 
     Report::Report() {}
@@ -73,11 +336,13 @@ namespace Plotypus
 
     Report::~Report()
     {
+        closeMemoryFiles();
         clearSheets();
     }
 
     void Report::reset()
     {
+        closeMemoryFiles();
         clearSheets();
 
         outputDirectory     = "";
@@ -89,12 +354,36 @@ namespace Plotypus
 
         verbose             = true;
         autoRunScript       = true;
+        persistentGnuplot   = false;
+        parallelPages       = false;
+        nativeRendering     = false;
+        cellGlyphs          = CellGlyphs::Characters;
+
+        exportThreadCount   = 1u;
+        maxOpenFiles        = 0u;
+
+        skipUnchangedOutput   = false;
+        deduplicateData     = false;
+        autoDecimation      = false;
+        autoCulling         = false;
+        inlineData          = false;
+        dataTransport       = DataTransport::Files;
+
+        exportSummary           = ExportSummary();
+        sheetScriptFingerprints.clear();
+        scriptFingerprint.reset();
+        dataChangedSinceScript  = true;
+        sharedDataFilenames.clear();
 
         pageSeparatorTxt    = "================================================================================\n";
         frameSeparatorTxt   = "--------------------------------------------------------------------------------\n";
 
         m_stylesCollection.reset();
         m_terminalInfoProvider.reset();
+        m_gnuplotProcess.stop();
+        m_gnuplotProcess.setExecutable("gnuplot");
+        m_gnuplotLaunchOptions = GnuplotLaunchOptions();
+        m_renderer             = &m_systemRenderer;
     }
 
     TerminalInfoProvider& Report::terminalInfoProvider()
@@ -102,6 +391,26 @@ namespace Plotypus
         return m_terminalInfoProvider;
     }
 
+    GnuplotProcess& Report::gnuplotProcess()
+    {
+        return m_gnuplotProcess;
+    }
+
+    GnuplotLaunchOptions& Report::gnuplotLaunchOptions()
+    {
+        return m_gnuplotLaunchOptions;
+    }
+
+    Renderer& Report::renderer()
+    {
+        return *m_renderer;
+    }
+
+    void Report::setRenderer(Renderer& newRenderer)
+    {
+        m_renderer = &newRenderer;
+    }
+
     // ====================================================================== //
 
     size_t Report::getReportSize() const
@@ -234,6 +543,141 @@ namespace Plotypus
         autoRunScript = newAutoRunScript;
     }
 
+    size_t Report::getExportThreadCount() const
+    {
+        return exportThreadCount;
+    }
+
+    void Report::setExportThreadCount(size_t newExportThreadCount)
+    {
+        exportThreadCount = newExportThreadCount;
+    }
+
+    size_t Report::getMaxOpenFiles() const
+    {
+        return maxOpenFiles;
+    }
+
+    void Report::setMaxOpenFiles(size_t newMaxOpenFiles)
+    {
+        maxOpenFiles = newMaxOpenFiles;
+    }
+
+    bool Report::getPersistentGnuplot() const
+    {
+        return persistentGnuplot;
+    }
+
+    void Report::setPersistentGnuplot(bool newPersistentGnuplot)
+    {
+        // *INDENT-OFF*
+        if (newPersistentGnuplot)   {m_gnuplotProcess.start();}
+        else                        {m_gnuplotProcess.stop();}
+        // *INDENT-ON*
+
+        persistentGnuplot = newPersistentGnuplot;
+    }
+
+    bool Report::getParallelPages() const
+    {
+        return parallelPages;
+    }
+
+    void Report::setParallelPages(bool newParallelPages)
+    {
+        parallelPages = newParallelPages;
+    }
+
+    bool Report::getNativeRendering() const
+    {
+        return nativeRendering;
+    }
+
+    void Report::setNativeRendering(bool newNativeRendering)
+    {
+        nativeRendering = newNativeRendering;
+    }
+
+    CellGlyphs Report::getCellGlyphs() const
+    {
+        return cellGlyphs;
+    }
+
+    void Report::setCellGlyphs(CellGlyphs newCellGlyphs)
+    {
+        cellGlyphs = newCellGlyphs;
+    }
+
+    DataTransport Report::getDataTransport() const
+    {
+        return dataTransport;
+    }
+
+    void Report::setDataTransport(DataTransport newDataTransport)
+    {
+        // *INDENT-OFF*
+        if (newDataTransport != DataTransport::MemoryFiles) {closeMemoryFiles();}
+        // *INDENT-ON*
+
+        dataTransport = newDataTransport;
+    }
+
+    bool Report::getInlineData() const
+    {
+        return inlineData;
+    }
+
+    void Report::setInlineData(bool newInlineData)
+    {
+        inlineData = newInlineData;
+    }
+
+    bool Report::getAutoDecimation() const
+    {
+        return autoDecimation;
+    }
+
+    void Report::setAutoDecimation(bool newAutoDecimation)
+    {
+        autoDecimation = newAutoDecimation;
+    }
+
+    bool Report::getAutoCulling() const
+    {
+        return autoCulling;
+    }
+
+    void Report::setAutoCulling(bool newAutoCulling)
+    {
+        autoCulling = newAutoCulling;
+    }
+
+    bool Report::getSkipUnchangedOutput() const
+    {
+        return skipUnchangedOutput;
+    }
+
+    void Report::setSkipUnchangedOutput(bool newSkipUnchangedOutput)
+    {
+        skipUnchangedOutput = newSkipUnchangedOutput;
+    }
+
+    bool Report::getDeduplicateData() const
+    {
+        return deduplicateData;
+    }
+
+    void Report::setDeduplicateData(bool newDeduplicateData)
+    {
+        deduplicateData = newDeduplicateData;
+        sharedDataFilenames.clear();
+    }
+
+    const ExportSummary& Report::getExportSummary() const
+    {
+        return exportSummary;
+    }
+
     const std::string& Report::getOutputDirectory() const
     {
         return outputDirectory;
@@ -265,25 +709,493 @@ namespace Plotypus
 
     void Report::writeDat() const
     {
+        const bool sharing = deduplicateData && !inlineData && dataTransport != DataTransport::Archive;
+
+        sharedDataFilenames.clear();
         preprocessSheets(extDat);
 
-        for (auto sheet : sheets)
+        exportSummary.writtenDataFiles.clear();
+        exportSummary.skippedDataFiles.clear();
+        exportSummary.sharedDataViews = 0u;
+        dataChangedSinceScript = true;
+
+        // *INDENT-OFF*
+        if (inlineData) {return;}           // data go to the script
+        if (dataTransport == DataTransport::Archive) {writeArchive(); return;}
+        if (sharing) {shareDataFiles();}
+        // *INDENT-ON*
+
+        // *INDENT-OFF*
+        if (exportThreadCount == 1u && !skipUnchangedOutput && !sharing) {
+            for (auto sheet : sheets) {
+                sheet->writeDatData();
+                for (auto dataView : sheet->getDatDataViews()) {if (dataView->hasDataFile()) {exportSummary.writtenDataFiles.push_back(dataView->getDataFilename());}}
+            }
+            return;
+        }
+        // *INDENT-ON*
+
+        /* Each DataView keeps exactly one file open while being written, hence limiting the
+         * number of open files amounts to limiting the number of threads.
+         */
+        std::vector<const DataView*> dataViews;
+        for (size_t i = 0u; i < sheets.size(); ++i)
         {
-            sheet->writeDatData();
+            const auto sheetDataViews = sheets[i]->getDatDataViews();
+
+            // *INDENT-OFF*
+            if (sheetDataViews.empty()) {sheets[i]->writeDatData();}     // sheets that do not expose their views
+            // *INDENT-ON*
+
+            for (size_t j = 0u; j < sheetDataViews.size(); ++j)
+            {
+                // *INDENT-OFF*
+                if (!sheetDataViews[j]->hasDataFile())    {continue;}
+                if (sharedDataFilenames.contains({i, j})) {++exportSummary.sharedDataViews; continue;}
+                // *INDENT-ON*
+                dataViews.push_back(sheetDataViews[j]);
+            }
+        }
+
+        size_t threadCount = (exportThreadCount ? exportThreadCount : std::max(1u, std::thread::hardware_concurrency()));
+        // *INDENT-OFF*
+        if (maxOpenFiles) {threadCount = std::min(threadCount, maxOpenFiles);}
+        // *INDENT-ON*
+
+        std::vector<char> written(dataViews.size(), true);
+        runParallel(dataViews.size(), threadCount, [&] (const size_t i)
+        {
+            // *INDENT-OFF*
+            if (skipUnchangedOutput)  {written[i] = dataViews[i]->writeDatDataIfChanged();}
+            else                    {dataViews[i]->writeDatData();}
+            // *INDENT-ON*
+        });
+
+        for (size_t i = 0u; i < dataViews.size(); ++i)
+        {
+            auto& list = (written[i] ? exportSummary.writtenDataFiles : exportSummary.skippedDataFiles);
+            list.push_back(dataViews[i]->getDataFilename());
+        }
+
+        dataChangedSinceScript = !exportSummary.writtenDataFiles.empty();
+
+        if (verbose && skipUnchangedOutput)
+        {
+            std::cout << "skipped " << exportSummary.skippedDataFiles.size() << " of " << dataViews.size() << " unchanged data files." << std::endl;
         }
     }
 
-    void Report::writeScript() const
+    bool Report::writeScriptFile(std::string& filenameGnu, int& scriptFile) const
     {
-        const std::string filenameGnu = getOutputFilename(extGnu);
-        std::fstream hFile = openOrThrow(filenameGnu);
+        const bool        inMemory       = (dataTransport == DataTransport::MemoryFiles);
+        const std::string outputFilename = getOutputFilename(m_terminalInfoProvider.getExtOut());
 
-        writeScript(hFile);
+        std::stringstream script;
+        writeScript(script);
+
+        scriptFile  = (inMemory ? createMemoryFile(filenameBase + "." + extGnu) : -1);
+        filenameGnu = (inMemory ? getDescriptorPath(scriptFile, !inheritsMemoryFiles()) : getOutputFilename(extGnu));
+
+        const uint64_t fingerprint     = hashString(script.str());
+        const bool     outputIsPresent = fs::exists(filenameGnu) && (!m_terminalInfoProvider.getOutputToFile() || fs::exists(outputFilename));
+
+        exportSummary.skippedScript = skipUnchangedOutput && !dataChangedSinceScript && outputIsPresent && (fingerprint == scriptFingerprint);
+        if (exportSummary.skippedScript)
+        {
+            // *INDENT-OFF*
+            if (verbose) {std::cout << "script " << filenameGnu << " and its data are unchanged; skipped gnuplot." << std::endl;}
+            // *INDENT-ON*
+            return false;
+        }
+
+        std::fstream hFile = openOrThrow(filenameGnu);
+        hFile << script.rdbuf();
         hFile.close();
 
-        if (autoRunScript)
+        scriptFingerprint      = fingerprint;
+        dataChangedSinceScript = false;
+
+        return true;
+    }
+
+    void Report::writePages() const
+    {
+        const std::string outputFilename = getOutputFilename(m_terminalInfoProvider.getExtOut());
+        const bool        mergePages     = (m_terminalInfoProvider.getFileType() == FileType::Pdf);
+
+        preprocessSheets(extDat);
+        throwIfArchiveIncomplete();
+
+        /* The page scripts, and the pages that are merged afterwards, go to a directory of their own so
+         * that they cannot overwrite files in the output directory.
+         */
+        const fs::path           pageDirectory = createTemporaryDirectory("plotypus_pages_");
+        std::vector<std::string> pageScripts;
+        std::vector<std::string> pageOutputs;
+
+        for (size_t i = 1u; auto sheet : sheets)
         {
-            runGnuplot(filenameGnu, verbose);
+            // *INDENT-OFF*
+            if (verbose) {std::cout << "writing script for page #" << i << " ... ";}
+            // *INDENT-ON*
+
+            const std::string infix    = "_" + std::to_string(i);
+            const std::string pageName = filenameBase + infix + ".";
+            pageScripts.push_back((pageDirectory / (pageName + extGnu)).string());
+            pageOutputs.push_back(mergePages ? (pageDirectory / (pageName + m_terminalInfoProvider.getExtOut())).string() : getOutputFilename(m_terminalInfoProvider.getExtOut(), infix));
+
+            std::fstream hFile = openOrThrow(pageScripts.back());
+            writeScriptSetup(hFile, pageOutputs.back(), i);
+
+            hFile << "# " << std::string(76, '=') << " #\n";
+            hFile << "# page " << i << std::endl << std::endl;
+
+            // *INDENT-OFF*
+            if (sheet->getType() == PlotType::Sheet) {writeCleanSheetCommands(hFile);}
+            // *INDENT-ON*
+
+            sheet->writeScriptHead  (hFile);
+            sheet->writeScriptData  (hFile, m_stylesCollection);
+            sheet->writeScriptLabels(hFile);
+            sheet->writeScriptFooter(hFile, i);
+            ++i;
+
+            // *INDENT-OFF*
+            if (verbose) {std::cout << "done." << std::endl;}
+            // *INDENT-ON*
+        }
+
+        exportSummary.skippedScript = false;
+        scriptFingerprint.reset();              // the single script is out of date
+        dataChangedSinceScript      = false;
+
+        // *INDENT-OFF*
+        if (verbose) {std::cout << "rendering " << sheets.size() << " pages in parallel ..." << std::endl;}
+        // *INDENT-ON*
+
+        std::vector<GnuplotResult> results(pageScripts.size());
+        runParallel(pageScripts.size(), 0u, [&] (const size_t i)
+        {
+            results[i] = m_renderer->render(pageScripts[i], m_gnuplotLaunchOptions).get();
+        });
+
+        bool success = true;
+        for (size_t i = 0u; i < results.size(); ++i)
+        {
+            // *INDENT-OFF*
+            if (!results[i].exitCode && !results[i].timedOut) {continue;}
+            // *INDENT-ON*
+
+            success = false;
+            if (verbose)
+            {
+                std::cerr << "gnuplot did not succeed on page #" << (i + 1u) << ". Error code: " << results[i].exitCode << std::endl;
+                std::cerr << results[i].errorOutput;
+            }
+        }
+
+        if (!success)
+        {
+            // *INDENT-OFF*
+            if (verbose) {std::cerr << "page scripts and pages are kept in " << pageDirectory.string() << " for inspection." << std::endl;}
+            // *INDENT-ON*
+            return;
+        }
+
+        // *INDENT-OFF*
+        if (mergePages) {mergePdfFiles(pageOutputs, outputFilename);}
+        fs::remove_all(pageDirectory);
+
+        if (verbose && mergePages) {std::cout << "merged pages into " << outputFilename << "." << std::endl;}
+        // *INDENT-ON*
+    }
+
+    bool Report::writeNative() const
+    {
+        const FileType fileType = m_terminalInfoProvider.getFileType();
+
+        // *INDENT-OFF*
+        if (!autoRunScript || m_terminalInfoProvider.getOptions())  {return false;}
+        if (fileType != FileType::Svg && fileType != FileType::Png && fileType != FileType::Ascii) {return false;}
+        // *INDENT-ON*
+
+        int width  = NATIVE_DEFAULT_WIDTH;
+        int height = NATIVE_DEFAULT_HEIGHT;
+
+        const auto dimensions = m_terminalInfoProvider.getDimensions();
+        if (dimensions)
+        {
+            if (!std::holds_alternative<TerminalInfoProvider::dimensions_pixels_t>(dimensions.value()))
+            {
+                // *INDENT-OFF*
+                if (verbose) {std::cout << "dimensions are not given in pixels; using gnuplot." << std::endl;}
+                // *INDENT-ON*
+                return false;
+            }
+            std::tie(width, height) = std::get<TerminalInfoProvider::dimensions_pixels_t>(dimensions.value());
+        }
+
+        for (size_t i = 1u; auto sheet : sheets)
+        {
+            const auto problem = PlotPainter::findUnsupportedFeature(*sheet, m_stylesCollection);
+            if (problem)
+            {
+                // *INDENT-OFF*
+                if (verbose) {std::cout << "sheet #" << i << " cannot be rendered natively (" << problem.value() << "); using gnuplot." << std::endl;}
+                // *INDENT-ON*
+                return false;
+            }
+            ++i;
+        }
+
+        // *INDENT-OFF*
+        if (verbose) {std::cout << "rendering " << sheets.size() << " sheets natively ..." << std::endl;}
+        // *INDENT-ON*
+
+        if (fileType == FileType::Ascii)
+        {
+            // all pages go to the one file, as with gnuplot's dumb terminal
+            std::fstream hFile = openOrThrow(getOutputFilename(m_terminalInfoProvider.getExtOut()), std::ios_base::out);
+            renderText(hFile);
+        }
+        else
+        {
+            drawNativePages(fileType, width, height);
+        }
+
+        // *INDENT-OFF*
+        if (verbose) {std::cout << "done." << std::endl;}
+        // *INDENT-ON*
+
+        exportSummary.skippedScript = false;
+        scriptFingerprint.reset();              // no script corresponds to the output
+        dataChangedSinceScript      = false;
+
+        return true;
+    }
+
+    void Report::drawNativePages(FileType fileType, int width, int height) const
+    {
+        auto background = parseColor(m_terminalInfoProvider.getBackgroundColor().value_or("white")).value_or(Color{255u, 255u, 255u});
+        // *INDENT-OFF*
+        if (fileType == FileType::Png && m_terminalInfoProvider.getTransparent().value_or(false)) {background.a = 0u;}
+        // *INDENT-ON*
+
+        // pages are independent of each other, so each one is drawn on its own thread
+        runParallel(sheets.size(), 0u, [&] (const size_t i)
+        {
+            const std::string infix    = (sheets.size() == 1u ? "" : "_" + std::to_string(i + 1u));
+            const std::string filename = getOutputFilename(m_terminalInfoProvider.getExtOut(), infix);
+            const PlotPainter painter(*sheets[i], m_stylesCollection);
+
+            std::fstream hFile = openOrThrow(filename, std::ios_base::out | std::ios_base::binary);
+            if (fileType == FileType::Svg)
+            {
+                SvgCanvas canvas(hFile);
+                painter.paint(canvas, width, height, background);
+            }
+            else
+            {
+                RasterCanvas canvas;
+                painter.paint(canvas, width, height, background);
+                hFile << encodePng(canvas.getPixels(), canvas.getWidth(), canvas.getHeight());
+            }
+        });
+    }
+
+    void Report::writeScript() const
+    {
+        // *INDENT-OFF*
+        if (nativeRendering && writeNative()) {return;}
+        if (parallelPages && autoRunScript && m_terminalInfoProvider.getOutputToFile()) {writePages(); return;}
+        // *INDENT-ON*
+
+        std::string filenameGnu;
+        int         scriptFile = -1;
+
+        const bool written = writeScriptFile(filenameGnu, scriptFile);
+
+        if (written && autoRunScript && persistentGnuplot)
+        {
+            // *INDENT-OFF*
+            if (verbose) {std::cout << "About to run gnuplot script '" << filenameGnu << "' in process " << m_gnuplotProcess.getPid() << " ..." << std::endl;}
+
+            const bool success = m_gnuplotProcess.execute("load " + quotedGnuplotString(filenameGnu), m_gnuplotLaunchOptions.timeout);
+
+            if (verbose) {
+                std::cerr << m_gnuplotProcess.getErrorOutput();
+                if      (success)                           {std::cout << "done." << std::endl;}
+                else if (m_gnuplotProcess.hasScriptError()) {std::cerr << "gnuplot reported an error in the script." << std::endl;}
+                else if (m_gnuplotProcess.hasTimedOut())    {std::cerr << "gnuplot did not finish the script in time and was killed; it will be restarted with the next one." << std::endl;}
+                else                                        {std::cerr << "gnuplot terminated before finishing the script; it will be restarted with the next one." << std::endl;}
+            }
+            // *INDENT-ON*
+        }
+        else if (written && autoRunScript)
+        {
+            // *INDENT-OFF*
+            if (verbose) {std::cout << "About to run gnuplot script '" << filenameGnu << "' ..." << std::endl;}
+            // *INDENT-ON*
+
+            GnuplotResult result;
+            try
+            {
+                result = m_renderer->render(filenameGnu, m_gnuplotLaunchOptions).get();
+            }
+            catch (const std::exception& e)
+            {
+                result.exitCode    = -1;
+                result.errorOutput = e.what();
+            }
+
+            // *INDENT-OFF*
+            if (verbose) {
+                if (result.exitCode || result.timedOut) {std::cerr << "gnuplot did not succeed. Error code: " << result.exitCode << std::endl << result.errorOutput;}
+                else                                    {std::cout << "done." << std::endl;}
+            }
+            // *INDENT-ON*
+        }
+
+        // *INDENT-OFF*
+        if (scriptFile >= 0) {::close(scriptFile);}
+        // *INDENT-ON*
+    }
+
+    std::string Report::writeScriptFile() const
+    {
+        // *INDENT-OFF*
+        if (dataTransport == DataTransport::MemoryFiles) {throw UnsupportedOperationError("Cannot keep a script file with in-memory data transport");}
+        // *INDENT-ON*
+
+        std::string filenameGnu;
+        int         scriptFile = -1;
+
+        return (writeScriptFile(filenameGnu, scriptFile) ? filenameGnu : "");
+    }
+
+    GnuplotResult Report::renderToMemory() const
+    {
+        // *INDENT-OFF*
+        if (!m_terminalInfoProvider.getOutputToFile()) {throw UnsupportedOperationError("Cannot capture the output of terminal '" + m_terminalInfoProvider.getTerminal() + "'");}
+        // *INDENT-ON*
+
+        std::stringstream script;
+        writeScript(script, "");
+
+        const int scriptFile = createMemoryFile(filenameBase + "." + extGnu);
+
+        GnuplotResult result;
+        try
+        {
+            std::fstream hFile = openOrThrow(getDescriptorPath(scriptFile));
+            hFile << script.rdbuf();
+            hFile.close();
+
+            auto options = m_gnuplotLaunchOptions;
+            options.captureOutput = true;
+            result = m_renderer->render(getDescriptorPath(scriptFile, m_renderer != &m_systemRenderer), options).get();
+        }
+        catch (...)
+        {
+            ::close(scriptFile);
+            throw;
+        }
+        ::close(scriptFile);
+
+        // *INDENT-OFF*
+        if (verbose && (result.exitCode || result.timedOut)) {std::cerr << "gnuplot did not succeed. Error code: " << result.exitCode << std::endl << result.errorOutput;}
+        // *INDENT-ON*
+
+        return result;
+    }
+
+    std::future<GnuplotResult> Report::writeScriptAsync() const
+    {
+        std::string filenameGnu;
+        int         scriptFile = -1;
+
+        std::future<GnuplotResult> result;
+        try
+        {
+            if (writeScriptFile(filenameGnu, scriptFile))
+            {
+                // *INDENT-OFF*
+                if (verbose) {std::cout << "Starting gnuplot script '" << filenameGnu << "' in the background." << std::endl;}
+                // *INDENT-ON*
+                result = m_renderer->render(filenameGnu, m_gnuplotLaunchOptions);
+
+                if (scriptFile >= 0 && m_renderer != &m_systemRenderer)
+                {
+                    // unlike a process of its own, the renderer may load the script after render returned
+                    result = std::async(std::launch::async, [scriptFile, rendering = std::move(result)]() mutable
+                    {
+                        try
+                        {
+                            auto outcome = rendering.get();
+                            ::close(scriptFile);
+                            return outcome;
+                        }
+                        catch (...)
+                        {
+                            ::close(scriptFile);
+                            throw;
+                        }
+                    });
+                    scriptFile = -1;
+                }
+            }
+            else
+            {
+                std::promise<GnuplotResult> skipped;
+                skipped.set_value(GnuplotResult());
+                result = skipped.get_future();
+            }
+        }
+        catch (...)
+        {
+            // *INDENT-OFF*
+            if (scriptFile >= 0) {::close(scriptFile);}
+            // *INDENT-ON*
+            throw;
+        }
+
+        // *INDENT-OFF*
+        if (scriptFile >= 0) {::close(scriptFile);}      // the gnuplot process holds its own copy
+        // *INDENT-ON*
+
+        return result;
+    }
+
+    void Report::renderText(std::ostream& hFile) const
+    {
+        int columns = NATIVE_DEFAULT_COLUMNS;
+        int rows    = NATIVE_DEFAULT_ROWS;
+
+        const auto dimensions = m_terminalInfoProvider.getDimensions();
+        if (dimensions && std::holds_alternative<TerminalInfoProvider::dimensions_pixels_t>(dimensions.value()))
+        {
+            std::tie(columns, rows) = std::get<TerminalInfoProvider::dimensions_pixels_t>(dimensions.value());
+        }
+
+        for (size_t i = 1u; auto sheet : sheets)
+        {
+            const auto problem = PlotPainter::findUnsupportedFeature(*sheet, m_stylesCollection);
+            // *INDENT-OFF*
+            if (problem) {throw UnsupportedOperationError("Cannot render sheet #" + std::to_string(i) + " as text: " + problem.value());}
+            // *INDENT-ON*
+            ++i;
+        }
+
+        const auto [dx, dy] = TextCanvas::getDotsPerCell(cellGlyphs);
+        TextCanvas canvas(hFile, cellGlyphs);
+
+        for (size_t i = 0u; i < sheets.size(); ++i)
+        {
+            // *INDENT-OFF*
+            if (i) {hFile << pageSeparatorTxt;}
+            // *INDENT-ON*
+
+            PlotPainter(*sheets[i], m_stylesCollection).paint(canvas, columns * dx, rows * dy, Color{255u, 255u, 255u});
         }
     }
 
@@ -307,27 +1219,26 @@ namespace Plotypus
     }
 
     void Report::writeScript(std::ostream& hFile) const
+    {
+        writeScript(hFile, getOutputFilename(m_terminalInfoProvider.getExtOut()));
+    }
+
+    void Report::writeScript(std::ostream& hFile, const std::string& outputFilename) const
     {
         // *INDENT-OFF*
 
-        const std::string outputFilename = getOutputFilename(m_terminalInfoProvider.getExtOut());
+        const std::string outputName             = (outputFilename.empty() ? "standard output" : outputFilename);
         bool              needCleanSheetCommands = true;
 
-        if (verbose) {std::cout << "about to write script for " << outputFilename << " ..." << std::endl;}
+        if (verbose) {std::cout << "about to write script for " << outputName << " ..." << std::endl;}
 
         preprocessSheets(extDat);
+        throwIfArchiveIncomplete();
 
-        hFile << "# " << std::string(76, '=') << " #" << std::endl;
-        hFile << "# output setup" << std::endl << std::endl;
-
-        m_terminalInfoProvider.writeTerminalInfo(hFile);
-
-        if (m_terminalInfoProvider.getOutputToFile()) {
-            hFile << "set output '" << outputFilename << "'" << std::endl << std::endl;
-        }
-
+        std::vector<uint64_t> fingerprints;
+        exportSummary.unchangedSheets.clear();
 
-        m_stylesCollection.writeStyles(hFile);
+        writeScriptSetup(hFile, outputFilename);
 
         for (size_t i = 1u; auto sheet : sheets)
         {
@@ -336,19 +1247,31 @@ namespace Plotypus
             hFile << "# " << std::string(76, '=') << " #\n";
             hFile << "# page " << i << std::endl << std::endl;
 
-            if (needCleanSheetCommands && sheet->getType() == PlotType::Sheet) {needCleanSheetCommands = false; writeCleanSheetCommands(hFile);}
+            std::stringstream fragment;
+
+            if (needCleanSheetCommands && sheet->getType() == PlotType::Sheet) {needCleanSheetCommands = false; writeCleanSheetCommands(fragment);}
             else if                      (sheet->getType() != PlotType::Sheet) {needCleanSheetCommands = true ;}
 
-            sheet->writeScriptHead  (hFile);
-            sheet->writeScriptData  (hFile, m_stylesCollection);
-            sheet->writeScriptLabels(hFile);
-            sheet->writeScriptFooter(hFile, i);
+            sheet->writeScriptHead  (fragment);
+            sheet->writeScriptData  (fragment, m_stylesCollection);
+            sheet->writeScriptLabels(fragment);
+            sheet->writeScriptFooter(fragment, i);
+
+            const std::string fragmentText = fragment.str();
+            const uint64_t    fingerprint  = hashString(fragmentText);
+            if (i <= sheetScriptFingerprints.size() && sheetScriptFingerprints[i - 1] == fingerprint) {exportSummary.unchangedSheets.push_back(i);}
+            fingerprints.push_back(fingerprint);
+
+            hFile << fragmentText;
             ++i;
 
             if (verbose) {std::cout << "done." << std::endl;}
         }
 
-        if (verbose) {std::cout << "script for " << outputFilename << " completed." << std::endl;}
+        sheetScriptFingerprints = fingerprints;
+
+        if (verbose && skipUnchangedOutput) {std::cout << exportSummary.unchangedSheets.size() << " of " << sheets.size() << " sheets unchanged." << std::endl;}
+        if (verbose) {std::cout << "script for " << outputName << " completed." << std::endl;}
 
         // *INDENT-ON*
     }
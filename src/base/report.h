@@ -2,10 +2,14 @@
 #define REPORT_H
 
 #include <string>
+#include <future>
+#include <map>
 #include <vector>
 
 #include "util.h"
 
+#include "gnuplotprocess.h"
+#include "renderer.h"
 #include "stylescollection.h"
 #include "terminalinfoprovider.h"
 
@@ -41,16 +45,68 @@ namespace Plotypus
             bool verbose                    = true;
             bool autoRunScript              = true;
 
+            size_t exportThreadCount        = 1u;
+            size_t maxOpenFiles             = 0u;
+
+            bool skipUnchangedOutput          = false;
+            bool deduplicateData            = false;
+            bool autoDecimation             = false;
+            bool autoCulling                = false;
+            bool inlineData                 = false;
+
+            bool persistentGnuplot          = false;
+            bool parallelPages              = false;
+            bool nativeRendering            = false;
+            CellGlyphs cellGlyphs           = CellGlyphs::Characters;
+
+            DataTransport               dataTransport = DataTransport::Files;
+            mutable std::vector<int>    memoryFiles;
+
+            mutable ExportSummary           exportSummary;
+            mutable std::vector<uint64_t>   sheetScriptFingerprints;
+            mutable std::optional<uint64_t> scriptFingerprint;
+            mutable bool                    dataChangedSinceScript = true;
+            //! @brief data file of an identical DataView, by sheet and view index (zero based), as found by the last writeDat
+            mutable std::map<std::pair<size_t, size_t>, std::string> sharedDataFilenames;
+
             std::string pageSeparatorTxt    = "================================================================================\n";
             std::string frameSeparatorTxt   = "--------------------------------------------------------------------------------\n";
 
             StylesCollection        m_stylesCollection;
             TerminalInfoProvider    m_terminalInfoProvider;
+            mutable GnuplotProcess  m_gnuplotProcess;
+            GnuplotLaunchOptions    m_gnuplotLaunchOptions;
+            SystemGnuplotRenderer   m_systemRenderer;
+            Renderer*               m_renderer = &m_systemRenderer;
 
             void preprocessSheets(const std::string& extension) const;
+            void assignMemoryFiles() const;
+            void closeMemoryFiles() const;
+            //! @brief tells whether gnuplot inherits the memory files; otherwise, they are named via the process ID instead of /proc/self.
+            bool inheritsMemoryFiles() const;
+            //! @brief points all DataViews whose binary data go to the archive to the archive file.
+            void assignArchive() const;
+            //! @brief throws an UnsupportedOperationError if a DataView refers to the archive, but has not been written to it.
+            void throwIfArchiveIncomplete() const;
+            void writeArchive() const;
+            //! @brief points each DataView whose data equal those of an earlier one to the data file of that view.
+            void shareDataFiles() const;
+            void applySharedDataFiles() const;
             std::string getOutputFilename(const std::string& extension, const std::string& infix = "") const;
 
+            //! @brief writes the script file unless it is skipped as unchanged; `scriptFile` is the memory file to be closed, or -1.
+            bool writeScriptFile(std::string& filenameGnu, int& scriptFile) const;
+
             void writeCleanSheetCommands(std::ostream& hFile) const;
+            void writeScriptSetup       (std::ostream& hFile, const std::string& outputFilename, size_t onlySheet = 0u) const;
+            //! @brief writes the datablocks of all Sheets, or of Sheet `onlySheet` (one based) only.
+            void writeDatablocks        (std::ostream& hFile, size_t onlySheet = 0u) const;
+            void writePages() const;
+            //! @brief draws all Sheets without gnuplot if they are supported by PlotPainter; returns whether it did so.
+            bool writeNative() const;
+            void drawNativePages(FileType fileType, int width, int height) const;
+            //! @brief writes the script with output to `outputFilename`, or to standard output if it is empty.
+            void writeScript(std::ostream& hFile, const std::string& outputFilename) const;
 
         public:
             //! @brief Default CTor for setting up a PDF report with pdfcairo as terminal engine.
@@ -67,6 +123,20 @@ namespace Plotypus
             void reset();
 
             TerminalInfoProvider& terminalInfoProvider();
+            GnuplotProcess&       gnuplotProcess();
+            //! @brief returns the executable, timeout and resource limits passed to the renderer with every script.
+            GnuplotLaunchOptions& gnuplotLaunchOptions();
+            //! @brief returns the backend that renders the scripts; defaults to a SystemGnuplotRenderer.
+            Renderer&             renderer();
+            /**
+             * @brief lets `newRenderer` render the scripts of writeScript, writeScriptAsync, renderToMemory and the
+             * parallel pages.
+             *
+             * The Report does not take ownership; `newRenderer` must outlive its use, and may be shared by
+             * several Reports. reset restores the SystemGnuplotRenderer. Does not apply to the persistent
+             * gnuplot process nor to native rendering.
+             */
+            void                  setRenderer(Renderer& newRenderer);
 
             // -------------------------------------------------------------- //
             // content management
@@ -132,6 +202,147 @@ namespace Plotypus
             bool                getAutoRunScript() const;
             void                setAutoRunScript(bool newAutoRunScript);
 
+            bool                getPersistentGnuplot() const;
+            /**
+             * @brief runs scripts in a gnuplot process that stays alive between calls of writeScript.
+             *
+             * Enabling starts the process right away (see gnuplotProcess for the executable), so that later
+             * exports do not wait for gnuplot to start. Each script file is written as usual and passed to the
+             * process by a `load` command in a fresh session, rather than streamed through the pipe, so that
+             * commands reading from the standard input (e.g. `pause -1`) behave as in a script run. writeScript
+             * returns once gnuplot has finished it. If gnuplot terminates, e.g. due to an error
+             * in the script, it is restarted with the next script. A script exceeding the timeout of the
+             * gnuplotLaunchOptions gets the process killed. Disabling stops the process.
+             */
+            void                setPersistentGnuplot(bool newPersistentGnuplot);
+
+            //! @brief returns the number of threads writing data files in writeDat
+            size_t              getExportThreadCount() const;
+            /**
+             * @brief sets the number of threads writing data files in writeDat.
+             *
+             * Zero uses one thread per hardware thread. With more than one thread, the DataViews of all
+             * Sheets are written concurrently, so their selectors must be safe to call from any thread.
+             * Defaults to one, i.e. all data files are written in order on the calling thread.
+             */
+            void                setExportThreadCount(size_t newExportThreadCount);
+            //! @brief returns the maximum number of data files written at the same time by writeDat; zero means no limit.
+            size_t              getMaxOpenFiles() const;
+            //! @brief limits the number of data files written at the same time by writeDat; zero means no limit.
+            void                setMaxOpenFiles(size_t newMaxOpenFiles);
+
+            bool                getParallelPages() const;
+            /**
+             * @brief splits the script into one script per page, which writeScript renders concurrently.
+             *
+             * Each page script `<base>_<n>.<ext>` holds the complete output setup and renders its page into the
+             * file `<base>_<n>.<output ext>`. The renderer gets one script per hardware thread at a time, with
+             * the gnuplotLaunchOptions. The page scripts are written to a new temporary directory, which is
+             * removed once all pages succeeded, and kept for inspection otherwise. For FileType::Pdf, the pages
+             * are rendered into that directory, too, and merged into the single output file (see mergePdfFiles);
+             * other FileTypes write the numbered files to the output directory. Has no effect for output to the
+             * screen or without autoRunScript; the persistent gnuplot and skipping unchanged output do not apply.
+             */
+            void                setParallelPages(bool newParallelPages);
+
+            bool                getNativeRendering() const;
+            /**
+             * @brief lets writeScript draw the Sheets itself instead of running gnuplot, where possible.
+             *
+             * Applies to FileType::Svg and FileType::Png without terminal options and with autoRunScript. If
+             * PlotPainter supports every Sheet, each one is written to the output file, or to `<base>_<n>.<ext>`
+             * if there are several Sheets; no script is written, no data files are needed and no process is
+             * started. The Sheets are drawn concurrently, one per hardware thread. Otherwise, the reason is
+             * printed in verbose mode, and the Report is rendered by gnuplot as usual. The size is taken from
+             * the dimensions in pixels, defaulting to NATIVE_DEFAULT_WIDTH x NATIVE_DEFAULT_HEIGHT; PNG output
+             * honours the transparent background.
+             *
+             * FileType::Ascii is drawn as character cells, see renderText; all Sheets go to the single output
+             * file, separated by the pageSeparatorTxt.
+             */
+            void                setNativeRendering(bool newNativeRendering);
+
+            CellGlyphs          getCellGlyphs() const;
+            //! @brief selects the characters renderText draws graphics with.
+            void                setCellGlyphs(CellGlyphs newCellGlyphs);
+
+            DataTransport       getDataTransport() const;
+            /**
+             * @brief selects how data are handed to gnuplot.
+             *
+             * With DataTransport::MemoryFiles, every DataView with an auto-generated data filename writes to an
+             * in-memory file referenced as `/proc/self/fd/N` in the script, and the script itself is passed
+             * the same way. The descriptors stay open, and are reused by later exports, until the transport is
+             * changed or the Report is reset or destroyed. Linux only.
+             *
+             * With DataTransport::Archive, writeDat appends the binary data of every DataView with an
+             * auto-generated data filename to the single file `<base>.<ext dat>`, one view after the other, and
+             * the script addresses each view's records by byte offset and count. Views with ASCII output keep
+             * their own data files. writeDat rewrites the archive and all other data files sequentially on the
+             * calling thread; the export thread count and skipping unchanged output do not apply. Call writeDat
+             * before writing the script, as the offsets are only known once the data are written.
+             */
+            void                setDataTransport(DataTransport newDataTransport);
+
+            bool                getInlineData() const;
+            /**
+             * @brief embeds the data of all DataViews into the script as datablocks (`$data_<sheet>_<view>`).
+             *
+             * Datablocks are ASCII; the views' binary settings are ignored. writeDat does not write any data
+             * files in this mode, making the script self-contained.
+             */
+            void                setInlineData(bool newInlineData);
+
+            bool                getAutoDecimation() const;
+            /**
+             * @brief decimates line-like DataViews of all PlotWithAxes to the output width before writing data files.
+             *
+             * The pixel budget is the width set in the TerminalInfoProvider dimensions; without dimensions,
+             * no decimation is applied. Applies to DataViews without a pixel budget of their own, and leaves
+             * them unmodified; see DataView2D::setAutoDecimation.
+             */
+            void                setAutoDecimation(bool newAutoDecimation);
+            bool                getAutoCulling() const;
+            /**
+             * @brief drops records outside the X range of their PlotWithAxes before writing data files.
+             *
+             * Takes effect for explicit axis ranges, e.g. on zoomed detail pages, and for DataViews without a
+             * culling range of their own; see DataView2D::setAutoCullingRange. The DataViews are not modified.
+             */
+            void                setAutoCulling(bool newAutoCulling);
+
+            bool                getSkipUnchangedOutput() const;
+            /**
+             * @brief skips writing outputs whose content did not change since the previous call of writeDat or writeScript.
+             *
+             * This is content-hash deduplication of the written files, not change tracking: DataViews refer to
+             * client memory and many properties are exposed as references, so every export still fetches and
+             * hashes the full data of each view and generates the whole script. What is saved are disk writes
+             * and gnuplot runs:
+             * - writeDat skips every data file whose name, settings and data hash to the same value as
+             *   at the previous export, provided the file still exists.
+             * - writeScript skips writing the script and running gnuplot altogether if the whole script is
+             *   unchanged and no data file has been written since. Otherwise the whole script is written;
+             *   the sheets whose script fragment is unchanged are merely listed.
+             *
+             * What was written and skipped is listed in getExportSummary.
+             */
+            void                setSkipUnchangedOutput(bool newSkipUnchangedOutput);
+
+            bool                getDeduplicateData() const;
+            /**
+             * @brief lets DataViews with identical data share one data file, e.g. the same span plotted on several Sheets.
+             *
+             * writeDat compares the content fingerprints (see DataView::getContentFingerprint) of all DataViews
+             * with an auto-generated data filename, which takes one pass over the data of each view. Each group
+             * of identical views refers to the data file of the first one, and only that file is written. The
+             * script refers to the files found by the last writeDat. Applies to DataTransport::Files and
+             * DataTransport::MemoryFiles.
+             */
+            void                setDeduplicateData(bool newDeduplicateData);
+            //! @brief returns which outputs were written and skipped by the last writeDat and writeScript.
+            const ExportSummary& getExportSummary() const;
+
             const std::string&  getPageSeparatorTxt() const;
             void                setPageSeparatorTxt(const std::string& newNewPageTXT);
 
@@ -141,8 +352,55 @@ namespace Plotypus
             // writers
 
             void writeTxt   () const;
+            /**
+             * @brief writes the data files of all Sheets.
+             *
+             * With an export thread count other than one, the data files are written concurrently. If any of
+             * them fails, the error of the first failing DataView in order of Sheets and DataViews is thrown
+             * once all files have been processed.
+             */
             void writeDat   () const;
             void writeScript() const;
+            /**
+             * @brief writes the script like writeScript, but hands it to the renderer without waiting for the result.
+             *
+             * Runs the script regardless of the settings for autoRunScript and persistentGnuplot, and applies
+             * the gnuplotLaunchOptions. The data files and the script must not be rewritten before the
+             * returned future is ready. If the script is skipped as unchanged, the future is ready
+             * immediately and holds a default GnuplotResult.
+             *
+             * With DataTransport::MemoryFiles and a renderer other than the SystemGnuplotRenderer, the
+             * in-memory script is kept open until it is rendered; the returned future then blocks on
+             * destruction until that is the case.
+             */
+            std::future<GnuplotResult> writeScriptAsync() const;
+            /**
+             * @brief writes the script without running it, and returns its filename, or an empty string if it
+             * was skipped as unchanged.
+             *
+             * Throws an UnsupportedOperationError with DataTransport::MemoryFiles, as the in-memory script does
+             * not outlive the call.
+             */
+            std::string writeScriptFile() const;
+            /**
+             * @brief renders the Report without creating an output file, and returns the output in GnuplotResult::output.
+             *
+             * The script is passed to gnuplot as an in-memory file, and the terminal writes to a pipe; use a
+             * terminal that supports output to stdout (e.g. pngcairo, svg, pdfcairo). Data files are read as
+             * usual, so call writeDat before; with DataTransport::MemoryFiles or inline data, rendering does not
+             * touch the disk at all. Applies the renderer and the gnuplotLaunchOptions. Throws an UnsupportedOperationError for
+             * screen output.
+             */
+            GnuplotResult renderToMemory() const;
+            /**
+             * @brief draws all Sheets as character cells to `hFile`, without gnuplot, separated by the pageSeparatorTxt.
+             *
+             * The dimensions in pixels are taken as columns and rows, defaulting to NATIVE_DEFAULT_COLUMNS x
+             * NATIVE_DEFAULT_ROWS; graphics are drawn with the cellGlyphs, text with one character per cell.
+             * Colours and dash patterns are not shown. Throws an UnsupportedOperationError if PlotPainter does
+             * not support one of the Sheets.
+             */
+            void renderText(std::ostream& hFile) const;
 
             void writeTxt   (std::ostream& hFile) const;
             void writeScript(std::ostream& hFile) const;
@@ -168,6 +168,11 @@ namespace Plotypus
         hFile << std::string(spaces, ' ') << std::to_string(pageNum) << std::endl;
     }
 
+    std::vector<const DataView*> Sheet::getDatDataViews() const
+    {
+        return {};
+    }
+
     void Sheet::writeDatData() const {}
 
     void Sheet::writeScriptHead(std::ostream& hFile) const
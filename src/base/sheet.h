@@ -8,6 +8,8 @@
 
 namespace Plotypus
 {
+    class DataView;
+
     class Sheet
     {
         protected:
@@ -72,6 +74,8 @@ namespace Plotypus
             virtual void writeTxtLabels     (std::ostream& hFile) const;
             virtual void writeTxtFooter     (std::ostream& hFile, const int pageNum) const;
 
+            //! @brief returns the DataViews whose data files are written by writeDatData, in order of writing.
+            virtual std::vector<const DataView*> getDatDataViews() const;
             virtual void writeDatData() const;
 
             virtual void writeScriptHead    (std::ostream& hFile) const;
@@ -266,6 +266,11 @@ namespace Plotypus
                 extOut   = "";
                 outputToFile = false;
                 break;
+
+            case FileType::Svg:
+                terminal = "svg";
+                extOut   = "svg";
+                break;
         }
 
         fileType = newFileType;
@@ -324,6 +329,7 @@ namespace Plotypus
             case FileType::Png:         break;
             case FileType::PostScript:  throwIfDimensionsNotOfType(newDimensions, DimensionsTypeIndex::Length); break;
             case FileType::Screen:      throwIfDimensionsNotOfType(newDimensions, DimensionsTypeIndex::Pixels); break;
+            case FileType::Svg:         throwIfDimensionsNotOfType(newDimensions, DimensionsTypeIndex::Pixels); break;
         }
         // *INDENT-ON*
 
@@ -374,6 +380,19 @@ namespace Plotypus
         dimensions.reset();
     }
 
+    std::optional<size_t> TerminalInfoProvider::getPixelWidth() const
+    {
+        // *INDENT-OFF*
+        if (!dimensions) {return std::nullopt;}
+        if (std::holds_alternative<dimensions_pixels_t>(dimensions.value())) {return std::max(0, std::get<dimensions_pixels_t>(dimensions.value()).first);}
+        // *INDENT-ON*
+
+        const auto& [lengths, unit] = std::get<dimensions_length_with_unit_t>(dimensions.value());
+        const double inches = (unit == getLengthUnitName(LengthUnit::Centimeter) ? lengths.first / 2.54 : lengths.first);
+
+        return static_cast<size_t>(std::max(0., inches * PIXELS_PER_INCH));
+    }
+
     // ---------------------------------------------------------------------- //
 
     std::optional<TerminalInfoProvider::dimensions_pixels_t> TerminalInfoProvider::getPosition() const
@@ -399,7 +418,7 @@ namespace Plotypus
 
     void TerminalInfoProvider::setBackgroundColor(const std::string& newBackgroundColor)
     {
-        throwIfUnsupportedFeature("background color", {FileType::Gif, FileType::Jpeg, FileType::LaTeX, FileType::Pdf, FileType::Png, FileType::PostScript});
+        throwIfUnsupportedFeature("background color", {FileType::Gif, FileType::Jpeg, FileType::LaTeX, FileType::Pdf, FileType::Png, FileType::PostScript, FileType::Svg});
         backgroundColor = newBackgroundColor;
     }
 
@@ -415,7 +434,7 @@ namespace Plotypus
 
     void TerminalInfoProvider::setLineEnds(const LineEnds newLineEnds)
     {
-        throwIfUnsupportedFeature("line ends", {FileType::Gif, FileType::Jpeg, FileType::LaTeX, FileType::Pdf, FileType::Png, FileType::PostScript});
+        throwIfUnsupportedFeature("line ends", {FileType::Gif, FileType::Jpeg, FileType::LaTeX, FileType::Pdf, FileType::Png, FileType::PostScript, FileType::Svg});
         lineEnds = newLineEnds;
     }
 
@@ -12,7 +12,6 @@ namespace Plotypus
             /**
              * @todo provide support for
              *      Lua/Tikz alias LaTeX
-             *      Svg
              *      Canvas alias JavaScript
              */
 
@@ -24,6 +23,7 @@ namespace Plotypus
              * | `Png`        | pngcairo        | png       |
              * | `PostScript` | epscairo        | eps       |
              * | `Gif`        | gif animate     | gif       |
+             * | `Svg`        | svg             | svg       |
              */
 
         public:
@@ -98,6 +98,8 @@ namespace Plotypus
             void                        setDimensions(const double width, const double height);
             void                        setDimensions(const double width, const double height, const LengthUnit lengthUnit);
             void                        clearDimensions();
+            //! @brief returns the width of the output in pixels, assuming PIXELS_PER_INCH for dimensions given as lengths, or std::nullopt if no dimensions are set.
+            std::optional<size_t>       getPixelWidth() const;
 
             std::optional<dimensions_pixels_t>  getPosition() const;
             void                                setPosition(const dimensions_pixels_t& newPosition);
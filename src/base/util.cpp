@@ -1,4 +1,12 @@
-#include <iostream>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <thread>
+
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include "util.h"
 
@@ -21,18 +29,137 @@ namespace Plotypus
         return hFile;
     }
 
-    void runGnuplot(const std::string& filename, bool verbose)
+    int createMemoryFile(const std::string& name)
     {
+        const int fd = ::memfd_create(name.c_str(), 0);     // no MFD_CLOEXEC: gnuplot inherits the descriptor
+
         // *INDENT-OFF*
-        if (verbose)    {std::cout << "About to run gnuplot script '" << filename << "' ..." << std::endl;}
+        if (fd < 0) {throw FileIOError("Could not create memory file '" + name + "'");}
+        // *INDENT-ON*
 
-        const auto error = std::system((std::string("gnuplot ") + filename).data());
+        return fd;
+    }
+
+    std::string getDescriptorPath(const int fd, bool viaProcessID)
+    {
+        const std::string process = (viaProcessID ? std::to_string(::getpid()) : std::string("self"));
+        return "/proc/" + process + "/fd/" + std::to_string(fd);
+    }
+
+    std::string createTemporaryDirectory(const std::string& prefix)
+    {
+        std::string path = (std::filesystem::temp_directory_path() / (prefix + "XXXXXX")).string();
+
+        // *INDENT-OFF*
+        if (!::mkdtemp(path.data())) {throw FileIOError("Could not create temporary directory '" + path + "'");}
+        // *INDENT-ON*
+
+        return path;
+    }
+
+    void runParallel(const size_t jobCount, size_t threadCount, const std::function<void (size_t)>& job)
+    {
+        // *INDENT-OFF*
+        if (threadCount == 0u) {threadCount = std::max(1u, std::thread::hardware_concurrency());}
+        threadCount = std::min(threadCount, jobCount);
 
-        if (verbose) {
-            if (error)  {std::cerr << "gnuplot did not succeed. Error code: " << error << std::endl;}
-            else        {std::cout << "done." << std::endl;}
-        }
         // *INDENT-ON*
+
+        if (threadCount <= 1u)
+        {
+            std::exception_ptr firstError;
+            for (size_t i = 0u; i < jobCount; ++i)
+            {
+                try
+                {
+                    job(i);
+                }
+                catch (...)
+                {
+                    // *INDENT-OFF*
+                    if (!firstError) {firstError = std::current_exception();}
+                    // *INDENT-ON*
+                }
+            }
+
+            // *INDENT-OFF*
+            if (firstError) {std::rethrow_exception(firstError);}
+            // *INDENT-ON*
+            return;
+        }
+
+        std::vector<std::exception_ptr> errors(jobCount);
+        std::atomic<size_t>             nextJob = 0u;
+
+        const auto worker = [&] ()
+        {
+            for (size_t i = nextJob++; i < jobCount; i = nextJob++)
+            {
+                try
+                {
+                    job(i);
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::jthread> threads;
+        for (size_t i = 0u; i < threadCount; ++i)
+        {
+            threads.emplace_back(worker);
+        }
+        threads.clear();
+
+        for (const auto& error : errors)
+        {
+            // *INDENT-OFF*
+            if (error) {std::rethrow_exception(error);}
+            // *INDENT-ON*
+        }
+    }
+
+    uint64_t hashBytes(const void* data, const size_t size, uint64_t seed)
+    {
+        /* word-wise multiply-xorshift mixing; each word is avalanched before being combined,
+         * so that the hash can be computed at memory speed.
+         */
+        const auto mix = [] (uint64_t word)
+        {
+            word ^= word >> 33;
+            word *= 0xff51afd7ed558ccdull;
+            word ^= word >> 33;
+            word *= 0xc4ceb9fe1a85ec53ull;
+            word ^= word >> 33;
+            return word;
+        };
+
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        uint64_t    hash  = seed ^ mix(size);
+
+        size_t i = 0u;
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+        {
+            uint64_t word;
+            std::memcpy(&word, bytes + i, sizeof(word));
+            hash = (hash ^ mix(word)) * 0x9e3779b97f4a7c15ull;
+        }
+
+        if (i < size)
+        {
+            uint64_t word = 0u;
+            std::memcpy(&word, bytes + i, size - i);
+            hash = (hash ^ mix(word)) * 0x9e3779b97f4a7c15ull;
+        }
+
+        return mix(hash);
+    }
+
+    uint64_t hashString(const std::string& text, uint64_t seed)
+    {
+        return hashBytes(text.data(), text.size(), seed);
     }
 
     // ---------------------------------------------------------------------- //
@@ -88,6 +215,7 @@ namespace Plotypus
             case FileType::Png:         return "Png";
             case FileType::PostScript:  return "PostScript";
             case FileType::Screen:      return "Screen";
+            case FileType::Svg:         return "Svg";
         }
         // *INDENT-ON*
 
@@ -192,6 +320,46 @@ namespace Plotypus
         return "(undefined)";
     }
 
+    std::string getColumnDataTypeName(const ColumnDataType columnDataType)
+    {
+        // *INDENT-OFF*
+        switch (columnDataType)
+        {
+            case ColumnDataType::Float64:   return "float64";
+            case ColumnDataType::Float32:   return "float32";
+            case ColumnDataType::Int32:     return "int32";
+            case ColumnDataType::Int16:     return "int16";
+            case ColumnDataType::Int8:      return "int8";
+            case ColumnDataType::UInt32:    return "uint32";
+            case ColumnDataType::UInt16:    return "uint16";
+            case ColumnDataType::UInt8:     return "uint8";
+            case ColumnDataType::Auto:      return "auto";
+        }
+        // *INDENT-ON*
+
+        return "(undefined)";
+    }
+
+    size_t getColumnDataTypeSize(const ColumnDataType columnDataType)
+    {
+        // *INDENT-OFF*
+        switch (columnDataType)
+        {
+            case ColumnDataType::Float64:   return 8u;
+            case ColumnDataType::Float32:   return 4u;
+            case ColumnDataType::Int32:     return 4u;
+            case ColumnDataType::Int16:     return 2u;
+            case ColumnDataType::Int8:      return 1u;
+            case ColumnDataType::UInt32:    return 4u;
+            case ColumnDataType::UInt16:    return 2u;
+            case ColumnDataType::UInt8:     return 1u;
+            case ColumnDataType::Auto:      return 0u;
+        }
+        // *INDENT-ON*
+
+        return 0u;
+    }
+
     bool hasAxisLabel(const AxisType axis)
     {
         // *INDENT-OFF*
@@ -242,6 +410,23 @@ namespace Plotypus
         // *INDENT-ON*
     }
 
+    std::string quotedGnuplotString(const std::string& text)
+    {
+        // *INDENT-OFF*
+        if (text.find_first_of("\r\n") != std::string::npos) {throw InvalidArgumentError("Cannot pass a line break to gnuplot in '" + text + "'");}
+        // *INDENT-ON*
+
+        std::string result = "'";
+        for (const char c : text)
+        {
+            // *INDENT-OFF*
+            if (c == '\'') {result += '\'';}
+            // *INDENT-ON*
+            result += c;
+        }
+        return result + "'";
+    }
+
     std::string optionalNumberString(const std::string& optionName, const double number, bool turnOn)
     {
         // *INDENT-OFF*
@@ -5,6 +5,7 @@
 #include <array>
 #include <concepts>
 #include <fstream>
+#include <functional>
 #include <optional>
 #include <ranges>
 #include <span>
@@ -22,7 +23,36 @@ namespace Plotypus
     bool contains(const T& toFind, const std::vector<T>& container);
 
     std::fstream openOrThrow(const std::string& filename, const std::ios_base::openmode& mode = std::ios_base::out);
-    void runGnuplot(const std::string& filename, bool verbose = true);
+
+    //! @brief creates an anonymous in-memory file that is inherited by child processes, or throws a FileIOError.
+    int         createMemoryFile(const std::string& name);
+    /**
+     * @brief returns the path under which the current process and its children can open the file descriptor `fd`.
+     *
+     * By default, the path refers to `/proc/self`, which requires the reader to have inherited `fd`. With
+     * `viaProcessID`, the path names the current process explicitly, which also works for children started
+     * before `fd` was created.
+     */
+    std::string getDescriptorPath(const int fd, bool viaProcessID = false);
+    //! @brief creates a new directory `<prefix>XXXXXX` with a unique suffix in the system temporary directory and returns its path, or throws a FileIOError.
+    std::string createTemporaryDirectory(const std::string& prefix);
+
+    /**
+     * @brief runs `job(0)` ... `job(jobCount - 1)` on up to `threadCount` threads
+     *
+     * A `threadCount` of zero uses one thread per hardware thread; a `threadCount` of one runs the
+     * jobs in order on the calling thread. All jobs are run even if some of them throw; afterwards,
+     * the exception of the job with the lowest index is rethrown.
+     */
+    void runParallel(const size_t jobCount, size_t threadCount, const std::function<void (size_t)>& job);
+
+    /**
+     * @brief returns a 64 bit, non-cryptographic hash of `size` bytes at `data`, continuing from `seed`.
+     *
+     * Chaining calls with the previous result as seed allows fingerprinting data that is not contiguous.
+     */
+    uint64_t hashBytes(const void* data, const size_t size, uint64_t seed = HASH_SEED);
+    uint64_t hashString(const std::string& text, uint64_t seed = HASH_SEED);
 
     // ---------------------------------------------------------------------- //
     // throw if ...
@@ -50,6 +80,8 @@ namespace Plotypus
     std::string getColumnIDName(const ColumnType columnType);
     std::string getPlotStyleName(const PlotStyle2D plotStyleID);
     std::string getAxisName(const AxisType axis);
+    std::string getColumnDataTypeName(const ColumnDataType columnDataType);
+    size_t      getColumnDataTypeSize(const ColumnDataType columnDataType);
 
     bool hasAxisLabel(const AxisType axis);
 
@@ -61,6 +93,14 @@ namespace Plotypus
     std::string optionalQuotedTextString(const std::string& optionName, const std::optional<std::string>& option);
     std::string optionalNumberString    (const std::string& optionName, const double number, bool turnOn);
     std::string optionalNumberString    (const std::string& optionName, const double number);
+
+    /**
+     * @brief returns `text` as single quoted gnuplot string, e.g. for a filename in a `load` command.
+     *
+     * gnuplot takes no escape sequences in single quoted strings except for a doubled quote, which stands
+     * for one. Throws an InvalidArgumentError if `text` contains a line break, which would end the command.
+     */
+    std::string quotedGnuplotString     (const std::string& text);
 };
 
 #include "util.txx"
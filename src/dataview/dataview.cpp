@@ -1,3 +1,7 @@
+#include <filesystem>
+
+#include "../base/util.h"
+
 #include "dataview.h"
 
 using namespace Plotypus;
@@ -21,7 +25,8 @@ namespace Plotypus
         style                       = "lines";
         options                     = "";
         dataFilename                = "";
-        numberPrecision             = -1;
+        datablockName               = "";
+        archiveSlice.reset();
         columnSeparatorTxt          = "\t";
         columnSeparatorDat          = "\t";
         binaryDataOutput            = true;
@@ -30,6 +35,10 @@ namespace Plotypus
         columnAssignments = {COLUMN_UNUSED, COLUMN_UNUSED, COLUMN_UNUSED, COLUMN_UNUSED, COLUMN_UNUSED, COLUMN_UNUSED};
         columnFormats     = {COLUMN_FORMAT_DEFAULT, COLUMN_FORMAT_DEFAULT, COLUMN_FORMAT_DEFAULT, COLUMN_FORMAT_DEFAULT, COLUMN_FORMAT_DEFAULT, COLUMN_FORMAT_DEFAULT};
         columnHeadlines   = {};
+        columnDataTypes   = {ColumnDataType::Float64, ColumnDataType::Float64, ColumnDataType::Float64, ColumnDataType::Float64, ColumnDataType::Float64, ColumnDataType::Float64};
+        columnPrecisions  = {COLUMN_PRECISION_SHORTEST, COLUMN_PRECISION_SHORTEST, COLUMN_PRECISION_SHORTEST, COLUMN_PRECISION_SHORTEST, COLUMN_PRECISION_SHORTEST, COLUMN_PRECISION_SHORTEST};
+
+        lastDatFingerprint.reset();
     }
 
     const std::string& DataView::getTitle() const
@@ -105,24 +114,34 @@ namespace Plotypus
         dataFilename = newDataFilename;
     }
 
-    bool DataView::getAutoGenerateDataFilename() const
+    const std::string& DataView::getDatablockName() const
     {
-        return autoGenerateDataFilename;
+        return datablockName;
     }
 
-    void DataView::setAutoGenerateDataFilename(bool newAutoGenerateDataFilename)
+    void DataView::setDatablockName(const std::string& newDatablockName) const
     {
-        autoGenerateDataFilename = newAutoGenerateDataFilename;
+        datablockName = newDatablockName;
+    }
+
+    const std::optional<ArchiveSlice>& DataView::getArchiveSlice() const
+    {
+        return archiveSlice;
+    }
+
+    void DataView::setArchiveSlice(const std::optional<ArchiveSlice>& newArchiveSlice) const
+    {
+        archiveSlice = newArchiveSlice;
     }
 
-    int DataView::getNumberPrecision() const
+    bool DataView::getAutoGenerateDataFilename() const
     {
-        return numberPrecision;
+        return autoGenerateDataFilename;
     }
 
-    void DataView::setNumberPrecision(int newNumberPrecision)
+    void DataView::setAutoGenerateDataFilename(bool newAutoGenerateDataFilename)
     {
-        numberPrecision = newNumberPrecision;
+        autoGenerateDataFilename = newAutoGenerateDataFilename;
     }
 
     const std::string& DataView::getColumnSeparatorTxt() const
@@ -145,6 +164,16 @@ namespace Plotypus
         columnSeparatorDat = newSeparatorDAT;
     }
 
+    const columnAssignmentList_t& DataView::getColumnAssignments() const
+    {
+        return columnAssignments;
+    }
+
+    const columnFormatList_t& DataView::getColumnFormats() const
+    {
+        return columnFormats;
+    }
+
     size_t& DataView::columnAssignment(const size_t columnID)
     {
         throwIfInvalidIndex("column ID", columnID, columnAssignments);
@@ -177,4 +206,78 @@ namespace Plotypus
     {
         return columnHeadline(getColumnID(columnType) - 1);
     }
+
+    ColumnDataType& DataView::columnDataType(const size_t columnID)
+    {
+        throwIfInvalidIndex("column ID", columnID, columnAssignments);
+        return columnDataTypes[columnID];
+    }
+
+    ColumnDataType& DataView::columnDataType(const ColumnType columnType)
+    {
+        return columnDataType(getColumnID(columnType) - 1);
+    }
+
+    int& DataView::columnPrecision(const size_t columnID)
+    {
+        throwIfInvalidIndex("column ID", columnID, columnAssignments);
+        return columnPrecisions[columnID];
+    }
+
+    int& DataView::columnPrecision(const ColumnType columnType)
+    {
+        return columnPrecision(getColumnID(columnType) - 1);
+    }
+
+    // ====================================================================== //
+
+    std::optional<uint64_t> DataView::getContentFingerprint() const
+    {
+        return std::nullopt;
+    }
+
+    bool DataView::hasEqualContent(const DataView&) const
+    {
+        return false;
+    }
+
+    std::optional<uint64_t> DataView::getDatFingerprint() const
+    {
+        const auto contentFingerprint = getContentFingerprint();
+
+        // *INDENT-OFF*
+        if (!contentFingerprint) {return std::nullopt;}
+        // *INDENT-ON*
+
+        return hashString(dataFilename, contentFingerprint.value());
+    }
+
+    bool DataView::writeDatablock(std::ostream&, const std::string&) const
+    {
+        return false;
+    }
+
+    bool DataView::writeArchiveData(std::ostream&) const
+    {
+        return false;
+    }
+
+    bool DataView::hasDataFile() const
+    {
+        return !isFunction() && !isDummy();
+    }
+
+    bool DataView::writeDatDataIfChanged() const
+    {
+        const auto fingerprint = getDatFingerprint();
+
+        // *INDENT-OFF*
+        if (fingerprint && fingerprint == lastDatFingerprint && std::filesystem::exists(dataFilename)) {return false;}
+        // *INDENT-ON*
+
+        writeDatData();
+        lastDatFingerprint = fingerprint;
+
+        return true;
+    }
 }
@@ -1,9 +1,10 @@
 #ifndef DATAVIEW_H
 #define DATAVIEW_H
 
+#include <optional>
 #include <string>
 
-#include "../definitions/constants.h"
+#include "../definitions/types.h"
 
 namespace Plotypus
 {
@@ -19,8 +20,9 @@ namespace Plotypus
             std::string options = "";
 
             mutable std::string dataFilename = "";
+            mutable std::string datablockName = "";
+            mutable std::optional<ArchiveSlice> archiveSlice;
 
-            int         numberPrecision = -1;
             std::string columnSeparatorTxt = "\t";
             std::string columnSeparatorDat = "\t";
 
@@ -30,6 +32,11 @@ namespace Plotypus
             columnAssignmentList_t columnAssignments = {COLUMN_UNUSED, COLUMN_UNUSED, COLUMN_UNUSED, COLUMN_UNUSED, COLUMN_UNUSED, COLUMN_UNUSED};
             columnFormatList_t     columnFormats     = {COLUMN_FORMAT_DEFAULT, COLUMN_FORMAT_DEFAULT, COLUMN_FORMAT_DEFAULT, COLUMN_FORMAT_DEFAULT, COLUMN_FORMAT_DEFAULT, COLUMN_FORMAT_DEFAULT};
             columnFormatList_t     columnHeadlines   = {};
+            columnDataTypeList_t   columnDataTypes   = {ColumnDataType::Float64, ColumnDataType::Float64, ColumnDataType::Float64, ColumnDataType::Float64, ColumnDataType::Float64, ColumnDataType::Float64};
+            columnPrecisionList_t  columnPrecisions  = {COLUMN_PRECISION_SHORTEST, COLUMN_PRECISION_SHORTEST, COLUMN_PRECISION_SHORTEST, COLUMN_PRECISION_SHORTEST, COLUMN_PRECISION_SHORTEST, COLUMN_PRECISION_SHORTEST};
+
+            //! @brief fingerprint of the data file as of the last call of writeDatDataIfChanged
+            mutable std::optional<uint64_t> lastDatFingerprint;
 
             virtual void clearFunctionMembers   () = 0;
             virtual void clearNonFunctionMembers() = 0;
@@ -59,25 +66,37 @@ namespace Plotypus
             void                setAutoGenerateDataFilename(bool newAutoGenerateDataFilename);
             const std::string&  getDataFilename() const;
             void                setDataFilename(const std::string& newDataFilename) const;
-
-            int                 getNumberPrecision() const;
-            void                setNumberPrecision(int newNumberPrecision);
+            //! @brief returns the name of the datablock holding the data in the script, or an empty string if the data file is used.
+            const std::string&  getDatablockName() const;
+            void                setDatablockName(const std::string& newDatablockName) const;
+            //! @brief returns where writeArchiveData put the records in the data file, or std::nullopt if the data file is the view's own.
+            const std::optional<ArchiveSlice>& getArchiveSlice() const;
+            void                setArchiveSlice(const std::optional<ArchiveSlice>& newArchiveSlice) const;
 
             const std::string&  getColumnSeparatorTxt() const;
             void                setColumnSeparatorTxt(const std::string& newSeparatorTXT);
             const std::string&  getColumnSeparatorDat() const;
             void                setColumnSeparatorDat(const std::string& newSeparatorDAT);
 
+            const columnAssignmentList_t& getColumnAssignments() const;
+            const columnFormatList_t&     getColumnFormats() const;
+
             size_t&             columnAssignment(const size_t       columnID);
             size_t&             columnAssignment(const ColumnType  columnType);
             std::string&        columnFormat    (const size_t       columnID);
             std::string&        columnFormat    (const ColumnType  columnType);
             std::string&        columnHeadline  (const size_t       columnID);
             std::string&        columnHeadline  (const ColumnType  columnType);
+            ColumnDataType&     columnDataType  (const size_t       columnID);
+            ColumnDataType&     columnDataType  (const ColumnType  columnType);
+            int&                columnPrecision (const size_t       columnID);
+            int&                columnPrecision (const ColumnType  columnType);
 
             virtual bool isFunction() const = 0;
             virtual bool isDummy() const = 0;
             virtual bool isComplete() const = 0;
+            //! @brief returns whether writeDatData writes a data file, i.e. whether the view is neither a function nor a dummy.
+            bool hasDataFile() const;
 
             virtual size_t getColumnID(const ColumnType columnType) const = 0;
 
@@ -86,6 +105,37 @@ namespace Plotypus
 
             virtual void writeTxtData   (std::ostream& hFile)                                           const = 0;
             virtual void writeDatData   ()                                                              const = 0;
+
+            /**
+             * @brief returns a hash of everything that determines the content of the data file, or std::nullopt
+             *  if this cannot be determined without writing the file. Views with equal content fingerprints
+             *  write identical data files, up to hash collisions.
+             */
+            virtual std::optional<uint64_t> getContentFingerprint() const;
+            /**
+             * @brief returns whether the data file of `other` would be identical to the one of this view, by comparing
+             *  the settings and data rather than their hashes. Meant to confirm equal content fingerprints; returns
+             *  false if this cannot be determined without writing the files.
+             */
+            virtual bool                    hasEqualContent(const DataView& other) const;
+            //! @brief returns a hash of the name and the content fingerprint of the data file, or std::nullopt if the latter is unknown.
+            std::optional<uint64_t> getDatFingerprint() const;
+            /**
+             * @brief calls writeDatData unless the fingerprint equals the one of the previous call and the data
+             *  file still exists. Returns whether the data file was written.
+             */
+            bool writeDatDataIfChanged() const;
+
+            /**
+             * @brief writes the data as gnuplot datablock `name` to the script, and returns whether the view has
+             *  data to embed at all. Does not change the datablock name the view refers to in writeScriptData.
+             */
+            virtual bool writeDatablock(std::ostream& hFile, const std::string& name) const;
+            /**
+             * @brief appends the binary data to the archive `hFile` and sets the archive slice, or returns false if
+             *  the view has no binary data to archive (functions, ASCII output, external input).
+             */
+            virtual bool writeArchiveData(std::ostream& hFile) const;
             virtual void writeScriptData(std::ostream& hFile, const StylesCollection& stylesColloction) const = 0;
     };
 }
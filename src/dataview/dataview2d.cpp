@@ -1,38 +1,1000 @@
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include "dataview2d.h"
 
-namespace Plotypus
-{
-    void DataView2D::clearFunctionMembers()
+namespace Plotypus
+{
+    void DataView2D::clearFunctionMembers()
+    {
+        func = "";
+    }
+
+    void DataView2D::clearDataCaches() const
+    {
+        resolvedColumnDataTypes.clear();
+        invalidateStatistics();
+    }
+
+    std::optional<RawRecordLayout> DataView2D::getRawRecordLayout(const ColumnPlan&) const
+    {
+        return std::nullopt;
+    }
+
+    ColumnPlan DataView2D::getColumnPlan() const
+    {
+        const auto isUnusedColumn = [] (const size_t assignment) {return assignment == COLUMN_UNUSED;};
+        const bool missingXColumn = (columnAssignments[0] == COLUMN_UNUSED);
+
+        ColumnPlan columnPlan;
+        columnPlan.lineLength = getConsecutiveEntriesCount(columnAssignments, isUnusedColumn);
+
+        // *INDENT-OFF*
+        for (auto i : columnAssignments) {
+            if (i == COLUMN_UNUSED) {continue;}         // ignore unused columns
+            --i;                                        // zero based indices
+
+            const size_t target = i - missingXColumn;   // correct for maybe missing X column
+            if (target >= columnPlan.lineLength) {throw UnsupportedOperationError("Column assignment " + std::to_string(i + 1) + " exceeds the number of occupied columns");}
+
+            columnPlan.sources.push_back(i);
+            columnPlan.targets.push_back(target);
+        }
+        // *INDENT-ON*
+
+        return columnPlan;
+    }
+
+    std::optional<RawRecordLayout> DataView2D::getActiveRawRecordLayout(const ColumnPlan& columnPlan) const
+    {
+        // *INDENT-OFF*
+        if (!binaryDataOutput || !rawDataOutput || isFunction() || getArity() == 0 || selectionActive) {return std::nullopt;}
+        // *INDENT-ON*
+
+        return getRawRecordLayout(columnPlan);
+    }
+
+    bool DataView2D::isLineLikeStyle(const PlotStyle2D style)
+    {
+        switch (style)
+        {
+            case PlotStyle2D::Lines:
+            case PlotStyle2D::Steps:
+            case PlotStyle2D::FSteps:
+            case PlotStyle2D::LinesPoints:
+            case PlotStyle2D::FilledCurves:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    std::tuple<size_t, double, double> DataView2D::getDecimationSettings() const
+    {
+        // *INDENT-OFF*
+        if (decimationPixels) {return {decimationPixels, decimationMin, decimationMax};}
+        // *INDENT-ON*
+        return {autoDecimationPixels, autoDecimationMin, autoDecimationMax};
+    }
+
+    std::vector<size_t> DataView2D::computeDecimation(const ColumnPlan& columnPlan, size_t firstRecord, size_t lastRecord) const
+    {
+        /* M4 decimation: per pixel column, the first, last, minimum and maximum record suffice to
+         * draw the same pixels as the full data. Records left and right of the range are bucketed
+         * as well, so that the lines leaving the visible range keep their slopes.
+         */
+        const bool   missingXColumn = (columnAssignments[0] == COLUMN_UNUSED);
+        const size_t lineLength     = columnPlan.lineLength;
+        const size_t yTarget        = columnAssignments[1] - 1 - missingXColumn;
+
+        std::vector<double> blockBuffer(DATA_BLOCK_SIZE * lineLength);
+
+        const auto forEachRecord = [&] (const auto& action)
+        {
+            for (size_t blockStart = firstRecord; blockStart < lastRecord; blockStart += DATA_BLOCK_SIZE)
+            {
+                const size_t recordCount = std::min(DATA_BLOCK_SIZE, lastRecord - blockStart);
+                fetchBlock(blockBuffer, blockStart, recordCount, columnPlan);
+
+                for (size_t r = 0u; r < recordCount; ++r)
+                {
+                    const double* line = blockBuffer.data() + r * lineLength;
+                    action(blockStart + r, missingXColumn ? static_cast<double>(blockStart + r) : line[columnAssignments[0] - 1], line[yTarget]);
+                }
+            }
+        };
+
+        // without a range of its own, decimation spans the culling range, or else the data
+        const auto [pixels, decimationLow, decimationHigh] = getDecimationSettings();
+        const auto [cullingLow, cullingHigh]                = getCullingLimits();
+        double rangeMin = std::isnan(decimationLow)  ? cullingLow  : decimationLow;
+        double rangeMax = std::isnan(decimationHigh) ? cullingHigh : decimationHigh;
+        if (std::isnan(rangeMin) || std::isnan(rangeMax))
+        {
+            const auto statistics = getStatistics(ColumnType::X);
+
+            // *INDENT-OFF*
+            if (std::isnan(rangeMin)) {rangeMin = statistics.min;}
+            if (std::isnan(rangeMax)) {rangeMax = statistics.max;}
+            // *INDENT-ON*
+        }
+
+        // *INDENT-OFF*
+        if (!(rangeMax > rangeMin) || !std::isfinite(rangeMax - rangeMin)) {return {};}
+        // *INDENT-ON*
+
+        struct Bucket
+        {
+            size_t first    = std::numeric_limits<size_t>::max();
+            size_t last     = 0u;
+            size_t minimum  = 0u;
+            size_t maximum  = 0u;
+            double minimumY =  std::numeric_limits<double>::infinity();
+            double maximumY = -std::numeric_limits<double>::infinity();
+        };
+
+        const double        scale  = pixels / (rangeMax - rangeMin);
+        std::vector<Bucket> buckets(pixels + 2u);       // [0]: left of range, [pixels + 1]: right of range
+        std::vector<size_t> result;
+
+        forEachRecord([&] (const size_t i, const double x, const double y)
+        {
+            // *INDENT-OFF*
+            if (std::isnan(x)) {result.push_back(i); return;}
+
+            size_t bucketID;
+            if      (x <  rangeMin) {bucketID = 0u;}
+            else if (x >  rangeMax) {bucketID = pixels + 1u;}
+            else                    {bucketID = 1u + std::min(static_cast<size_t>((x - rangeMin) * scale), pixels - 1u);}
+
+            auto& bucket = buckets[bucketID];
+            if (bucket.first == std::numeric_limits<size_t>::max()) {bucket.first = i;}
+            bucket.last = i;
+            if (y < bucket.minimumY) {bucket.minimumY = y; bucket.minimum = i;}
+            if (y > bucket.maximumY) {bucket.maximumY = y; bucket.maximum = i;}
+            // *INDENT-ON*
+        });
+
+        for (const auto& bucket : buckets)
+        {
+            // *INDENT-OFF*
+            if (bucket.first == std::numeric_limits<size_t>::max()) {continue;}
+
+            result.push_back(bucket.first);
+            result.push_back(bucket.last);
+            if (std::isfinite(bucket.minimumY)) {result.push_back(bucket.minimum);}
+            if (std::isfinite(bucket.maximumY)) {result.push_back(bucket.maximum);}
+            // *INDENT-ON*
+        }
+
+        std::ranges::sort(result);
+        const auto [first, last] = std::ranges::unique(result);
+        result.erase(first, last);
+
+        return result;
+    }
+
+    void DataView2D::accumulateStatistics(ColumnStatistics& statistics, std::span<const double> values, double previous)
+    {
+        /* Kept free of branches, so that the compiler can vectorize the loops: (v - v == 0.) holds
+         * for finite values only, (v != v) for NaN only, and comparisons with NaN are false.
+         */
+        double minimum  = statistics.min;
+        double maximum  = statistics.max;
+        size_t finite   = 0u;
+        size_t nan      = 0u;
+        size_t descents = (values.front() < previous);
+
+        for (const double value : values)
+        {
+            const bool isFinite = (value - value == 0.);
+            minimum = (isFinite && value < minimum) ? value : minimum;
+            maximum = (isFinite && value > maximum) ? value : maximum;
+            finite += isFinite;
+            nan    += (value != value);
+        }
+
+        for (size_t i = 1u; i < values.size(); ++i)
+        {
+            descents += (values[i] < values[i - 1u]);
+        }
+
+        statistics.min        = minimum;
+        statistics.max        = maximum;
+        statistics.count     += finite;
+        statistics.nanCount  += nan;
+        statistics.infCount  += values.size() - finite - nan;
+        statistics.ascending &= (descents == 0u);
+    }
+
+    void DataView2D::computeStatistics(const ColumnPlan& columnPlan) const
+    {
+        const size_t arity      = getArity();
+        const size_t lineLength = columnPlan.lineLength;
+        const size_t columns    = columnPlan.sources.size();
+
+        std::vector<double>             blockBuffer(DATA_BLOCK_SIZE * lineLength);
+        std::vector<double>             column(DATA_BLOCK_SIZE);
+        std::vector<ColumnStatistics>   statistics(columns);
+        std::vector<double>             previous(columns, std::numeric_limits<double>::quiet_NaN());
+
+        for (size_t blockStart = 0u; blockStart < arity; blockStart += DATA_BLOCK_SIZE)
+        {
+            const size_t blockSize = std::min(DATA_BLOCK_SIZE, arity - blockStart);
+            fetchBlock(blockBuffer, blockStart, blockSize, columnPlan);
+
+            for (size_t c = 0u; c < columns; ++c)
+            {
+                // gather the column first: the reduction then runs over contiguous values
+                const double* source = blockBuffer.data() + columnPlan.targets[c];
+                for (size_t r = 0u; r < blockSize; ++r)
+                {
+                    column[r] = source[r * lineLength];
+                }
+
+                accumulateStatistics(statistics[c], std::span<const double>(column.data(), blockSize), previous[c]);
+                previous[c] = column[blockSize - 1u];
+            }
+        }
+
+        for (size_t c = 0u; c < columns; ++c)
+        {
+            columnStatistics[columnPlan.sources[c]] = statistics[c];
+        }
+    }
+
+    std::pair<size_t, size_t> DataView2D::findCullingInterval(const ColumnPlan& columnPlan) const
+    {
+        const bool   missingXColumn = (columnAssignments[0] == COLUMN_UNUSED);
+        const size_t arity          = getArity();
+
+        std::vector<double> line(columnPlan.lineLength);
+
+        const auto getX = [&] (const size_t record)
+        {
+            // *INDENT-OFF*
+            if (missingXColumn) {return static_cast<double>(record);}
+            // *INDENT-ON*
+
+            fetchBlock(line, record, 1u, columnPlan);
+            return line[columnAssignments[0] - 1];
+        };
+
+        // first record for which isLeft does not hold; one record is fetched per step
+        const auto partitionPoint = [&] (const auto& isLeft)
+        {
+            size_t low  = 0u;
+            size_t high = arity;
+            while (low < high)
+            {
+                const size_t middle = low + (high - low) / 2u;
+                // *INDENT-OFF*
+                if (isLeft(getX(middle))) {low  = middle + 1u;}
+                else                      {high = middle;}
+                // *INDENT-ON*
+            }
+            return low;
+        };
+
+        const auto [rangeMin, rangeMax] = getCullingLimits();
+
+        size_t first = std::isnan(rangeMin) ? 0u    : partitionPoint([rangeMin] (const double x) {return x <  rangeMin;});
+        size_t last  = std::isnan(rangeMax) ? arity : partitionPoint([rangeMax] (const double x) {return x <= rangeMax;});
+
+        if (isLineLikeStyle(styleID))
+        {
+            first -= (first > 0u);
+            last  += (last  < arity);
+        }
+
+        return {first, std::max(first, last)};
+    }
+
+    std::pair<double, double> DataView2D::getCullingLimits() const
+    {
+        const bool   ownRange = !std::isnan(cullingMin) || !std::isnan(cullingMax);
+        const double low      = (ownRange ? cullingMin : autoCullingMin);
+        const double high     = (ownRange ? cullingMax : autoCullingMax);
+
+        // like gnuplot's axes, a range may be given in reverse
+        // *INDENT-OFF*
+        if (low > high) {return {high, low};}
+        // *INDENT-ON*
+        return {low, high};
+    }
+
+    std::vector<size_t> DataView2D::computeCulling(const ColumnPlan& columnPlan) const
+    {
+        /* Each record is left of (-1), in (0) or right of (1) the range, or interrupts lines (2). A line
+         * segment can only be seen if its ends are not on the same side of the range, hence both ends of
+         * such segments are kept. Of the segments dropped in between, all ends are on the same side as
+         * the kept ends around them, so the segment joining those does not enter the range either.
+         */
+        const bool   missingXColumn = (columnAssignments[0] == COLUMN_UNUSED);
+        const bool   lineLike       = isLineLikeStyle(styleID);
+        const size_t arity          = getArity();
+        const size_t lineLength     = columnPlan.lineLength;
+        const auto   [low, high]    = getCullingLimits();
+        const double rangeMin       = std::isnan(low)  ? -std::numeric_limits<double>::infinity() : low;
+        const double rangeMax       = std::isnan(high) ?  std::numeric_limits<double>::infinity() : high;
+
+        std::vector<double> blockBuffer(DATA_BLOCK_SIZE * lineLength);
+        std::vector<size_t> result;
+
+        const auto keep = [&result] (const size_t record)
+        {
+            // *INDENT-OFF*
+            if (result.empty() || result.back() != record) {result.push_back(record);}
+            // *INDENT-ON*
+        };
+
+        int previousSide = 2;
+        for (size_t blockStart = 0u; blockStart < arity; blockStart += DATA_BLOCK_SIZE)
+        {
+            const size_t recordCount = std::min(DATA_BLOCK_SIZE, arity - blockStart);
+            fetchBlock(blockBuffer, blockStart, recordCount, columnPlan);
+
+            for (size_t r = 0u; r < recordCount; ++r)
+            {
+                const size_t i = blockStart + r;
+                const double x = missingXColumn ? static_cast<double>(i) : blockBuffer[r * lineLength + columnAssignments[0] - 1];
+
+                // *INDENT-OFF*
+                int side;
+                if      (std::isnan(x)) {side = 2;}
+                else if (x < rangeMin)  {side = -1;}
+                else if (x > rangeMax)  {side = 1;}
+                else                    {side = 0;}
+
+                const bool visibleSegment = lineLike && side != 2 && previousSide != 2 && (side == 0 || side != previousSide);
+                if      (visibleSegment)                            {keep(i - 1u); keep(i);}
+                else if (side == 0 || (lineLike && side == 2))      {keep(i);}
+                // *INDENT-ON*
+
+                previousSide = side;
+            }
+        }
+
+        return result;
+    }
+
+    void DataView2D::selectRecords(const ColumnPlan& columnPlan) const
+    {
+        selectionActive = false;
+        selectedRecords.clear();
+
+        // *INDENT-OFF*
+        if (isFunction()) {return;}
+        // *INDENT-ON*
+
+        const size_t arity = getArity();
+        const auto   [cullingLow, cullingHigh] = getCullingLimits();
+        const bool   cull  = arity && (!std::isnan(cullingLow) || !std::isnan(cullingHigh));
+
+        size_t              first  = 0u;        // records left by culling: [first, last) if X is ascending, else culledRecords
+        size_t              last   = arity;
+        bool                sorted = true;
+        std::vector<size_t> culledRecords;
+
+        if (cull)
+        {
+            // the order of X may have changed in client memory since the statistics were taken
+            invalidateStatistics();
+            const auto x = getStatistics(ColumnType::X);
+            sorted = x.ascending && !x.nanCount;
+
+            // *INDENT-OFF*
+            if (sorted) {std::tie(first, last) = findCullingInterval(columnPlan);}
+            else        {culledRecords = computeCulling(columnPlan);}
+            // *INDENT-ON*
+        }
+
+        const size_t candidates = (sorted ? last - first : culledRecords.size());
+        const size_t pixels     = std::get<0>(getDecimationSettings());
+        const bool   decimate   = pixels && isLineLikeStyle(styleID) &&
+                                  columnAssignments[1] != COLUMN_UNUSED &&
+                                  candidates > 4u * (pixels + 2u);
+
+        if (decimate)
+        {
+            selectedRecords = computeDecimation(columnPlan, first, last);
+
+            if (!sorted && !selectedRecords.empty())
+            {
+                std::vector<size_t> intersection;
+                std::ranges::set_intersection(selectedRecords, culledRecords, std::back_inserter(intersection));
+                selectedRecords = std::move(intersection);
+            }
+        }
+
+        if (selectedRecords.empty() && cull)
+        {
+            // *INDENT-OFF*
+            if (sorted && first == 0u && last == arity) {return;}
+            // *INDENT-ON*
+
+            if (sorted)
+            {
+                selectedRecords.resize(last - first);
+                std::iota(selectedRecords.begin(), selectedRecords.end(), first);
+            }
+            else
+            {
+                selectedRecords = std::move(culledRecords);
+            }
+
+            // leave gnuplot a record to clip rather than a data file without records
+            // *INDENT-OFF*
+            if (selectedRecords.empty()) {selectedRecords.push_back(std::min(first, arity - 1u));}
+            // *INDENT-ON*
+        }
+
+        selectionActive = !selectedRecords.empty();
+    }
+
+    void DataView2D::clearRecordSelection() const
+    {
+        selectionActive = false;
+        selectedRecords.clear();
+    }
+
+    size_t DataView2D::getExportArity() const
+    {
+        return (selectionActive ? selectedRecords.size() : getArity());
+    }
+
+    void DataView2D::fetchRecords(std::span<double> buffer, size_t firstRecord, size_t recordCount, const ColumnPlan& columnPlan) const
+    {
+        // *INDENT-OFF*
+        if (!selectionActive) {fetchBlock(buffer, firstRecord, recordCount, columnPlan); return;}
+        // *INDENT-ON*
+
+        // runs of consecutive selected records are fetched in one go
+        const size_t lineLength = columnPlan.lineLength;
+        const size_t lastRecord = firstRecord + recordCount;
+
+        for (size_t runStart = firstRecord; runStart < lastRecord;)
+        {
+            size_t runEnd = runStart + 1u;
+            while (runEnd < lastRecord && selectedRecords[runEnd] == selectedRecords[runEnd - 1u] + 1u)
+            {
+                ++runEnd;
+            }
+
+            fetchBlock(buffer.subspan((runStart - firstRecord) * lineLength, (runEnd - runStart) * lineLength),
+                       selectedRecords[runStart], runEnd - runStart, columnPlan);
+            runStart = runEnd;
+        }
+    }
+
+    std::vector<ColumnDataType> DataView2D::resolveColumnDataTypes(const ColumnPlan& columnPlan) const
+    {
+        const bool missingXColumn = (columnAssignments[0] == COLUMN_UNUSED);
+
+        std::vector<ColumnDataType> result(columnPlan.lineLength, ColumnDataType::Float64);
+        for (size_t i = 0u; i < columnAssignments.size(); ++i)
+        {
+            // *INDENT-OFF*
+            if (columnAssignments[i] == COLUMN_UNUSED) {continue;}
+            // *INDENT-ON*
+
+            result[columnAssignments[i] - 1 - missingXColumn] = columnDataTypes[i];
+        }
+
+        if (std::ranges::find(result, ColumnDataType::Auto) != result.end())
+        {
+            narrowColumnDataTypes(result, columnPlan);
+        }
+
+        return result;
+    }
+
+    void DataView2D::updateResolvedColumnDataTypes(const ColumnPlan& columnPlan) const
+    {
+        resolvedColumnDataTypes    = resolveColumnDataTypes(columnPlan);
+        resolvedColumnAssignments  = columnAssignments;
+        resolvedRequestedDataTypes = columnDataTypes;
+    }
+
+    void DataView2D::narrowColumnDataTypes(std::vector<ColumnDataType>& columnDataTypes, const ColumnPlan& columnPlan) const
+    {
+        /* One pass over the data: a column can be stored as integer if all its values are finite
+         * and integral, and as float32 if all of them survive the round trip through float.
+         */
+        struct ColumnScan
+        {
+            bool   integral = true;
+            bool   float32  = true;
+            double min      =  std::numeric_limits<double>::infinity();
+            double max      = -std::numeric_limits<double>::infinity();
+        };
+
+        const size_t arity      = getExportArity();
+        const size_t lineLength = columnPlan.lineLength;
+
+        std::vector<ColumnScan> scans(lineLength);
+        std::vector<double>     blockBuffer(DATA_BLOCK_SIZE * lineLength);
+
+        for (size_t firstRecord = 0u; firstRecord < arity; firstRecord += DATA_BLOCK_SIZE)
+        {
+            const size_t recordCount = std::min(DATA_BLOCK_SIZE, arity - firstRecord);
+            fetchRecords(blockBuffer, firstRecord, recordCount, columnPlan);
+
+            for (size_t j = 0u; j < lineLength; ++j)
+            {
+                // *INDENT-OFF*
+                if (columnDataTypes[j] != ColumnDataType::Auto) {continue;}
+                // *INDENT-ON*
+
+                auto& scan = scans[j];
+                for (size_t i = j; i < recordCount * lineLength; i += lineLength)
+                {
+                    const double value = blockBuffer[i];
+
+                    scan.integral &= std::isfinite(value) && (value == std::trunc(value));
+                    scan.float32  &= std::isnan(value) || (static_cast<double>(static_cast<float>(value)) == value);
+                    scan.min       = std::min(scan.min, value);
+                    scan.max       = std::max(scan.max, value);
+                }
+            }
+        }
+
+        for (size_t j = 0u; j < lineLength; ++j)
+        {
+            // *INDENT-OFF*
+            if (columnDataTypes[j] != ColumnDataType::Auto) {continue;}
+
+            const auto& scan = scans[j];
+            auto& type = columnDataTypes[j];
+
+            if      (arity == 0u)   {type = ColumnDataType::Float64;}
+            else if (scan.integral && scan.min >= 0.) {
+                if      (scan.max <= std::numeric_limits<uint8_t >::max()) {type = ColumnDataType::UInt8;}
+                else if (scan.max <= std::numeric_limits<uint16_t>::max()) {type = ColumnDataType::UInt16;}
+                else if (scan.max <= std::numeric_limits<uint32_t>::max()) {type = ColumnDataType::UInt32;}
+            }
+            else if (scan.integral) {
+                if      (scan.min >= std::numeric_limits<int8_t >::min() && scan.max <= std::numeric_limits<int8_t >::max()) {type = ColumnDataType::Int8;}
+                else if (scan.min >= std::numeric_limits<int16_t>::min() && scan.max <= std::numeric_limits<int16_t>::max()) {type = ColumnDataType::Int16;}
+                else if (scan.min >= std::numeric_limits<int32_t>::min() && scan.max <= std::numeric_limits<int32_t>::max()) {type = ColumnDataType::Int32;}
+            }
+
+            if (type == ColumnDataType::Auto) {type = (scan.float32 ? ColumnDataType::Float32 : ColumnDataType::Float64);}
+            // *INDENT-ON*
+        }
+    }
+
+    void DataView2D::encodeColumn(const ColumnDataType columnDataType, const double* source, size_t sourceStride, size_t count, std::byte* target, size_t targetStride)
+    {
+        const auto encode = [&] <class Element> ()
+        {
+            // the values that truncate to a valid integer; NaN fails either comparison
+            constexpr bool   isInteger = std::is_integral_v<Element>;
+            constexpr double lowest    = static_cast<double>(std::numeric_limits<Element>::lowest()) - 1.;
+            constexpr double highest   = static_cast<double>(std::numeric_limits<Element>::max())    + 1.;
+
+            for (size_t i = 0u; i < count; ++i)
+            {
+                // *INDENT-OFF*
+                if (isInteger && !(*source > lowest && *source < highest)) {throw InvalidArgumentError("Value " + std::to_string(*source) + " does not fit column data type " + getColumnDataTypeName(columnDataType));}
+                // *INDENT-ON*
+
+                const Element element = static_cast<Element>(*source);
+                std::memcpy(target, &element, sizeof(Element));
+
+                source += sourceStride;
+                target += targetStride;
+            }
+        };
+
+        // *INDENT-OFF*
+        switch (columnDataType)
+        {
+            case ColumnDataType::Float64:   encode.template operator()<double  >(); break;
+            case ColumnDataType::Float32:   encode.template operator()<float   >(); break;
+            case ColumnDataType::Int32:     encode.template operator()<int32_t >(); break;
+            case ColumnDataType::Int16:     encode.template operator()<int16_t >(); break;
+            case ColumnDataType::Int8:      encode.template operator()<int8_t  >(); break;
+            case ColumnDataType::UInt32:    encode.template operator()<uint32_t>(); break;
+            case ColumnDataType::UInt16:    encode.template operator()<uint16_t>(); break;
+            case ColumnDataType::UInt8:     encode.template operator()<uint8_t >(); break;
+            case ColumnDataType::Auto:      throw InvalidArgumentError("Column data type must be resolved before encoding");
+        }
+        // *INDENT-ON*
+    }
+
+    std::vector<int> DataView2D::getLinePrecisions(const ColumnPlan& columnPlan) const
+    {
+        const bool missingXColumn = (columnAssignments[0] == COLUMN_UNUSED);
+
+        std::vector<int> result(columnPlan.lineLength, COLUMN_PRECISION_SHORTEST);
+        for (size_t i = 0u; i < columnAssignments.size(); ++i)
+        {
+            // *INDENT-OFF*
+            if (columnAssignments[i] == COLUMN_UNUSED) {continue;}
+            // *INDENT-ON*
+
+            result[columnAssignments[i] - 1 - missingXColumn] = columnPrecisions[i];
+        }
+
+        return result;
+    }
+
+    void DataView2D::formatAsciiRecords(const dataSink_t& sink, const ColumnPlan& columnPlan, const std::string& separator, size_t firstRecord, size_t recordCount) const
+    {
+        /* Values are formatted with std::to_chars into a buffer that is only handed to the sink
+         * when full. The buffer is kept per thread, so that it is allocated once and not shared.
+         */
+        thread_local std::vector<char> textBuffer(ASCII_BUFFER_SIZE);
+
+        const size_t lastRecord = firstRecord + recordCount;
+        const size_t lineLength = columnPlan.lineLength;
+        const auto   precisions = getLinePrecisions(columnPlan);
+
+        std::vector<double> blockBuffer(DATA_BLOCK_SIZE * lineLength);
+
+        char*       cursor = textBuffer.data();
+        char* const end    = textBuffer.data() + textBuffer.size();
+
+        const auto flush = [&] ()
+        {
+            sink(textBuffer.data(), cursor - textBuffer.data());
+            cursor = textBuffer.data();
+        };
+
+        const auto format = [&end] (char* first, const double value, const int precision)
+        {
+            // *INDENT-OFF*
+            if (precision < 0)  {return std::to_chars(first, end, value);}
+            else                {return std::to_chars(first, end, value, std::chars_format::general, precision);}
+            // *INDENT-ON*
+        };
+
+        const auto appendValue = [&] (const double value, const int precision)
+        {
+            auto result = format(cursor, value, precision);
+            if (result.ec != std::errc())
+            {
+                flush();
+                result = format(cursor, value, precision);
+
+                // *INDENT-OFF*
+                if (result.ec != std::errc()) {throw UnsupportedOperationError("Column precision " + std::to_string(precision) + " exceeds the ASCII buffer size");}
+                // *INDENT-ON*
+            }
+            cursor = result.ptr;
+        };
+
+        const auto appendText = [&] (const std::string_view text)
+        {
+            // *INDENT-OFF*
+            if (static_cast<size_t>(end - cursor) < text.size()) {flush();}
+            if (static_cast<size_t>(end - cursor) < text.size()) {sink(text.data(), text.size()); return;}
+            // *INDENT-ON*
+
+            cursor = std::copy(text.begin(), text.end(), cursor);
+        };
+
+        for (size_t blockStart = firstRecord; blockStart < lastRecord; blockStart += DATA_BLOCK_SIZE)
+        {
+            const size_t blockSize = std::min(DATA_BLOCK_SIZE, lastRecord - blockStart);
+            fetchRecords(blockBuffer, blockStart, blockSize, columnPlan);
+
+            for (size_t i = 0u; i < blockSize * lineLength; i += lineLength)
+            {
+                for (size_t j = 0u; j < lineLength; ++j)
+                {
+                    appendValue(blockBuffer[i + j], precisions[j]);
+                    appendText(separator);
+                }
+                appendText("\n");
+            }
+        }
+
+        flush();
+    }
+
+    void DataView2D::encodeBinaryRecords(const dataSink_t& sink, const ColumnPlan& columnPlan, size_t firstRecord, size_t recordCount) const
+    {
+        const size_t lastRecord = firstRecord + recordCount;
+        const size_t recordSize = getBinaryRecordSize();
+
+        std::vector<std::byte> encodedBuffer(DATA_BLOCK_SIZE * recordSize);
+
+        for (size_t blockStart = firstRecord; blockStart < lastRecord; blockStart += DATA_BLOCK_SIZE)
+        {
+            const size_t blockSize = std::min(DATA_BLOCK_SIZE, lastRecord - blockStart);
+            encodeBinaryRecordsInto(encodedBuffer.data(), columnPlan, blockStart, blockSize);
+
+            sink(reinterpret_cast<const char*>(encodedBuffer.data()), blockSize * recordSize);
+        }
+    }
+
+    size_t DataView2D::getBinaryRecordSize() const
+    {
+        size_t recordSize = 0u;
+        for (const auto type : resolvedColumnDataTypes)
+        {
+            recordSize += getColumnDataTypeSize(type);
+        }
+        return recordSize;
+    }
+
+    void DataView2D::encodeBinaryRecordsInto(std::byte* target, const ColumnPlan& columnPlan, size_t firstRecord, size_t recordCount) const
+    {
+        const size_t lastRecord = firstRecord + recordCount;
+        const size_t lineLength = columnPlan.lineLength;
+        const auto&  types      = resolvedColumnDataTypes;
+
+        if (std::ranges::all_of(types, [] (const ColumnDataType type) {return type == ColumnDataType::Float64;}))
+        {
+            double* lines = reinterpret_cast<double*>(target);
+            for (size_t blockStart = firstRecord; blockStart < lastRecord; blockStart += DATA_BLOCK_SIZE)
+            {
+                const size_t blockSize = std::min(DATA_BLOCK_SIZE, lastRecord - blockStart);
+                fetchRecords(std::span<double>(lines, blockSize * lineLength), blockStart, blockSize, columnPlan);
+                lines += blockSize * lineLength;
+            }
+            return;
+        }
+
+        std::vector<size_t> offsets(lineLength);
+        size_t              recordSize = 0u;
+        for (size_t j = 0u; j < lineLength; ++j)
+        {
+            offsets[j]  = recordSize;
+            recordSize += getColumnDataTypeSize(types[j]);
+        }
+
+        std::vector<double> blockBuffer(DATA_BLOCK_SIZE * lineLength);
+
+        for (size_t blockStart = firstRecord; blockStart < lastRecord; blockStart += DATA_BLOCK_SIZE)
+        {
+            const size_t blockSize = std::min(DATA_BLOCK_SIZE, lastRecord - blockStart);
+            fetchRecords(blockBuffer, blockStart, blockSize, columnPlan);
+
+            for (size_t j = 0u; j < lineLength; ++j)
+            {
+                encodeColumn(types[j], blockBuffer.data() + j, lineLength, blockSize, target + offsets[j], recordSize);
+            }
+            target += blockSize * recordSize;
+        }
+    }
+
+    void DataView2D::writeAsciiData(std::ostream& hFile, const ColumnPlan& columnPlan, const std::string& separator) const
+    {
+        const auto sink = [&hFile] (const char* data, size_t size) {hFile.write(data, size);};
+
+        formatAsciiRecords(sink, columnPlan, separator, 0u, getExportArity());
+    }
+
+    void DataView2D::writeAsciiDataChunked(std::ostream& hFile, const ColumnPlan& columnPlan, const std::string& separator, size_t threadCount) const
     {
-        func = "";
+        /* Chunks are formatted concurrently in rounds of a few chunks per thread, then written in order,
+         * so that no more than one round of text is held in memory.
+         */
+        const size_t arity      = getExportArity();
+        const size_t chunkCount = (arity + EXPORT_CHUNK_SIZE - 1u) / EXPORT_CHUNK_SIZE;
+        const size_t roundSize  = 2u * threadCount;
+
+        std::vector<std::string> chunkTexts(roundSize);
+
+        for (size_t firstChunk = 0u; firstChunk < chunkCount; firstChunk += roundSize)
+        {
+            const size_t roundChunks = std::min(roundSize, chunkCount - firstChunk);
+
+            runParallel(roundChunks, threadCount, [&] (const size_t i)
+            {
+                const size_t firstRecord = (firstChunk + i) * EXPORT_CHUNK_SIZE;
+                const size_t recordCount = std::min(EXPORT_CHUNK_SIZE, arity - firstRecord);
+
+                std::string& text = chunkTexts[i];
+                text.clear();
+                formatAsciiRecords([&text] (const char* data, size_t size) {text.append(data, size);},
+                                   columnPlan, separator, firstRecord, recordCount);
+            });
+
+            for (size_t i = 0u; i < roundChunks; ++i)
+            {
+                hFile.write(chunkTexts[i].data(), chunkTexts[i].size());
+            }
+        }
+    }
+
+    void DataView2D::writeDatDataBin(std::ostream& hFile, const ColumnPlan& columnPlan) const
+    {
+        const auto sink = [&hFile] (const char* data, size_t size) {hFile.write(data, size);};
+
+        encodeBinaryRecords(sink, columnPlan, 0u, getExportArity());
+    }
+
+    void DataView2D::writeDatDataBinMapped(const ColumnPlan& columnPlan, size_t threadCount) const
+    {
+        const size_t arity    = getExportArity();
+        const size_t fileSize = arity * getBinaryRecordSize();
+
+        const int fd = ::open(dataFilename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        // *INDENT-OFF*
+        if (fd < 0)         {throw FileIOError("Could not open '" + dataFilename + "'");}
+        if (fileSize == 0u) {::close(fd); return;}
+        // *INDENT-ON*
+
+        // posix_fallocate reserves the blocks up front; file systems without support fall back to a sparse file
+        const int allocationError = ::posix_fallocate(fd, 0, fileSize);
+        if ((allocationError && allocationError != EOPNOTSUPP && allocationError != EINVAL) || ::ftruncate(fd, fileSize) != 0)
+        {
+            ::close(fd);
+            throw FileIOError("Could not allocate " + std::to_string(fileSize) + " bytes for '" + dataFilename + "'");
+        }
+
+        void* mapping = ::mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        // *INDENT-OFF*
+        if (mapping == MAP_FAILED) {throw FileIOError("Could not map '" + dataFilename + "'");}
+        // *INDENT-ON*
+
+        std::byte* const mappedBytes = static_cast<std::byte*>(mapping);
+        const size_t     recordSize  = getBinaryRecordSize();
+        const size_t     chunkCount  = (arity + EXPORT_CHUNK_SIZE - 1u) / EXPORT_CHUNK_SIZE;
+
+        try
+        {
+            runParallel(chunkCount, threadCount, [&] (const size_t i)
+            {
+                const size_t firstRecord = i * EXPORT_CHUNK_SIZE;
+                const size_t recordCount = std::min(EXPORT_CHUNK_SIZE, arity - firstRecord);
+
+                encodeBinaryRecordsInto(mappedBytes + firstRecord * recordSize, columnPlan, firstRecord, recordCount);
+            });
+        }
+        catch (...)
+        {
+            ::munmap(mapping, fileSize);
+            throw;
+        }
+
+        ::munmap(mapping, fileSize);
     }
 
-    void DataView2D::writeDatDataAsc(std::ostream& hFile, std::vector<double>& lineBuffer, bool missingXColumn) const
+    void DataView2D::writeDatDataBinChunked(const ColumnPlan& columnPlan, size_t threadCount) const
     {
-        for (size_t i = 0u; i < getArity(); ++i)
+        /* The size of the binary file is known in advance, hence each chunk can be written to its
+         * final position independently of the others.
+         */
+        const size_t arity      = getExportArity();
+        const size_t chunkCount = (arity + EXPORT_CHUNK_SIZE - 1u) / EXPORT_CHUNK_SIZE;
+        const size_t recordSize = getBinaryRecordSize();
+
+        const int fd = ::open(dataFilename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        // *INDENT-OFF*
+        if (fd < 0) {throw FileIOError("Could not open '" + dataFilename + "'");}
+        // *INDENT-ON*
+
+        try
         {
-            fetchData(lineBuffer, i, missingXColumn);
-            for (const auto datapoint : lineBuffer)
+            if (::ftruncate(fd, arity * recordSize) != 0)
             {
-                hFile << datapoint << columnSeparatorDat;
+                throw FileIOError("Could not resize '" + dataFilename + "'");
             }
-            hFile << std::endl;
+
+            runParallel(chunkCount, threadCount, [&] (const size_t i)
+            {
+                const size_t firstRecord = i * EXPORT_CHUNK_SIZE;
+                const size_t recordCount = std::min(EXPORT_CHUNK_SIZE, arity - firstRecord);
+                off_t        offset      = firstRecord * recordSize;
+
+                const auto sink = [&] (const char* data, size_t size)
+                {
+                    while (size)
+                    {
+                        const ssize_t written = ::pwrite(fd, data, size, offset);
+                        // *INDENT-OFF*
+                        if (written < 0 && errno == EINTR)  {continue;}         // interrupted by a signal before writing anything
+                        if (written <= 0)                   {throw FileIOError("Could not write to '" + dataFilename + "'");}
+                        // *INDENT-ON*
+                        data   += written;
+                        size   -= written;
+                        offset += written;
+                    }
+                };
+
+                encodeBinaryRecords(sink, columnPlan, firstRecord, recordCount);
+            });
+        }
+        catch (...)
+        {
+            ::close(fd);
+            throw;
+        }
+
+        ::close(fd);
+    }
+
+    void DataView2D::writeBinaryFormat(std::ostream& hFile) const
+    {
+        const auto isFloat64 = [] (const ColumnDataType type) {return type == ColumnDataType::Float64;};
+
+        hFile << "binary ";
+
+        // *INDENT-OFF*
+        if (archiveSlice) {hFile << "skip=" << archiveSlice->offset << " record=" << archiveSlice->recordCount << " ";}
+
+        if (std::ranges::all_of(columnDataTypes, isFloat64)) {hFile << "format=\"%float64\" "; return;}
+
+        // the types of the last data file written, unless the view has changed since
+        const bool resolved = !resolvedColumnDataTypes.empty() && resolvedColumnAssignments == columnAssignments && resolvedRequestedDataTypes == columnDataTypes;
+        if (!resolved) {updateResolvedColumnDataTypes(getColumnPlan());}
+        // *INDENT-ON*
+
+        hFile << "format=\"";
+        for (const auto type : resolvedColumnDataTypes)
+        {
+            hFile << "%" << getColumnDataTypeName(type);
         }
+        hFile << "\" ";
     }
 
-    void DataView2D::writeDatDataBin(std::ostream& hFile, std::vector<double>& lineBuffer, bool missingXColumn) const
+    void DataView2D::writeRawBinaryFormat(std::ostream& hFile, const RawRecordLayout& layout, const ColumnPlan& columnPlan, columnAssignmentList_t& fileColumns) const
     {
-        for (size_t i = 0u; i < getArity(); ++i)
+        /* gnuplot numbers the fields of a binary record in the order of their appearance in the record,
+         * skipped bytes aside. Hence, the used members are sorted by their offset, and the gaps between
+         * them (as well as the trailing padding) are declared as skipped bytes.
+         */
+        std::vector<size_t> fieldOffsets;
+        for (const auto source : columnPlan.sources)
+        {
+            fieldOffsets.push_back(layout.offsets[source]);
+        }
+        std::ranges::sort(fieldOffsets);
+        const auto [first, last] = std::ranges::unique(fieldOffsets);
+        fieldOffsets.erase(first, last);
+
+        const auto writeSkip = [&hFile] (size_t bytes)
+        {
+            // *INDENT-OFF*
+            if      (bytes == 1u) {hFile << "%*uint8";}
+            else if (bytes >  1u) {hFile << "%*" << bytes << "uint8";}
+            // *INDENT-ON*
+        };
+
+        hFile << "binary ";
+        // *INDENT-OFF*
+        if (archiveSlice) {hFile << "skip=" << archiveSlice->offset << " ";}
+        // *INDENT-ON*
+        hFile << "record=" << getArity() << " format=\"";
+        size_t position = 0u;
+        for (const auto offset : fieldOffsets)
+        {
+            writeSkip(offset - position);
+            hFile << "%float64";
+            position = offset + sizeof(double);
+        }
+        writeSkip(layout.recordSize - position);
+        hFile << "\" ";
+
+        fileColumns = columnAssignments;
+        for (auto& assignment : fileColumns)
         {
-            fetchData(lineBuffer, i, missingXColumn);
-            hFile.write(
-                reinterpret_cast<char*>(lineBuffer.data()),
-                (lineBuffer.size() - missingXColumn) * sizeof(double)
-            );
+            // *INDENT-OFF*
+            if (assignment == COLUMN_UNUSED) {continue;}
+            // *INDENT-ON*
+
+            const auto field = std::ranges::find(fieldOffsets, layout.offsets[assignment - 1]);
+            assignment = (field - fieldOffsets.begin()) + 1;
         }
     }
 
-    void DataView2D::writeUsingSpecification(std::ostream& hFile) const
+    void DataView2D::writeUsingSpecification(std::ostream& hFile, const columnAssignmentList_t& fileColumns) const
     {
         // *INDENT-OFF*
         if (isFunction()) {return;}
@@ -41,17 +1003,17 @@ namespace Plotypus
         bool firstValue = true;
 
         hFile << "using ";
-        for (auto i = 0u; i < columnAssignments.size(); ++i)
+        for (auto i = 0u; i < fileColumns.size(); ++i)
         {
 
-            if (columnAssignments[i] != COLUMN_UNUSED)
+            if (fileColumns[i] != COLUMN_UNUSED)
             {
                 // *INDENT-OFF*
                 if (firstValue) {firstValue = false;}
                 else            {hFile << ":";}
                 // *INDENT-ON*
 
-                hFile << generateColumnFormat(columnFormats[i], columnAssignments[i], columnAssignments);
+                hFile << generateColumnFormat(columnFormats[i], fileColumns[i], fileColumns);
             }
         }
         hFile << " ";
@@ -78,6 +1040,25 @@ namespace Plotypus
 
         lineStyle  = -1;
         pointStyle = -1;
+
+        rawDataOutput = false;
+
+        decimationPixels    = 0u;
+        decimationMin       = AXIS_AUTO_RANGE;
+        decimationMax       = AXIS_AUTO_RANGE;
+        autoDecimationPixels = 0u;
+        autoDecimationMin   = AXIS_AUTO_RANGE;
+        autoDecimationMax   = AXIS_AUTO_RANGE;
+        cullingMin          = AXIS_AUTO_RANGE;
+        cullingMax          = AXIS_AUTO_RANGE;
+        autoCullingMin      = AXIS_AUTO_RANGE;
+        autoCullingMax      = AXIS_AUTO_RANGE;
+
+        mappedDataOutput    = false;
+        exportThreadCount   = 1u;
+        selectorsThreadSafe = false;
+
+        clearDataCaches();
     }
 
     const std::string& DataView2D::getFunc() const
@@ -89,6 +1070,7 @@ namespace Plotypus
     {
         func        = newFunc;
         clearNonFunctionMembers();
+        clearDataCaches();
     }
 
     size_t DataView2D::getLineStyle() const
@@ -101,6 +1083,140 @@ namespace Plotypus
         lineStyle = newLineStyle;
     }
 
+    size_t DataView2D::getPointStyle() const
+    {
+        return pointStyle;
+    }
+
+    void DataView2D::setPointStyle(size_t newPointStyle)
+    {
+        pointStyle = newPointStyle;
+    }
+
+    bool DataView2D::getRawDataOutput() const
+    {
+        return rawDataOutput;
+    }
+
+    void DataView2D::setRawDataOutput(bool newRawDataOutput)
+    {
+        rawDataOutput = newRawDataOutput;
+    }
+
+    size_t DataView2D::getDecimationPixels() const
+    {
+        return decimationPixels;
+    }
+
+    void DataView2D::setDecimationPixels(size_t newDecimationPixels)
+    {
+        decimationPixels = newDecimationPixels;
+    }
+
+    std::pair<double, double> DataView2D::getDecimationRange() const
+    {
+        return {decimationMin, decimationMax};
+    }
+
+    void DataView2D::setDecimationRange(double newDecimationMin, double newDecimationMax)
+    {
+        decimationMin = newDecimationMin;
+        decimationMax = newDecimationMax;
+    }
+
+    std::pair<double, double> DataView2D::getCullingRange() const
+    {
+        return {cullingMin, cullingMax};
+    }
+
+    void DataView2D::setCullingRange(double newCullingMin, double newCullingMax)
+    {
+        cullingMin = newCullingMin;
+        cullingMax = newCullingMax;
+    }
+
+    void DataView2D::setAutoDecimation(size_t newAutoDecimationPixels, double newAutoDecimationMin, double newAutoDecimationMax) const
+    {
+        autoDecimationPixels = newAutoDecimationPixels;
+        autoDecimationMin    = newAutoDecimationMin;
+        autoDecimationMax    = newAutoDecimationMax;
+    }
+
+    void DataView2D::setAutoCullingRange(double newAutoCullingMin, double newAutoCullingMax) const
+    {
+        autoCullingMin = newAutoCullingMin;
+        autoCullingMax = newAutoCullingMax;
+    }
+
+    bool DataView2D::getMappedDataOutput() const
+    {
+        return mappedDataOutput;
+    }
+
+    void DataView2D::setMappedDataOutput(bool newMappedDataOutput)
+    {
+        mappedDataOutput = newMappedDataOutput;
+    }
+
+    size_t DataView2D::getExportThreadCount() const
+    {
+        return exportThreadCount;
+    }
+
+    void DataView2D::setExportThreadCount(size_t newExportThreadCount)
+    {
+        exportThreadCount = newExportThreadCount;
+    }
+
+    bool DataView2D::getSelectorsThreadSafe() const
+    {
+        return selectorsThreadSafe;
+    }
+
+    void DataView2D::setSelectorsThreadSafe(bool newSelectorsThreadSafe)
+    {
+        selectorsThreadSafe = newSelectorsThreadSafe;
+    }
+
+    ColumnStatistics DataView2D::getStatistics(const ColumnType columnType) const
+    {
+        // *INDENT-OFF*
+        if (isDummy() || isFunction()) {return ColumnStatistics();}
+        if (!isComplete()) {throw UnsupportedOperationError("Unsupported column type or non-consecutive list of columns detected");}
+        // *INDENT-ON*
+
+        const size_t columnID = getColumnID(columnType);
+        if (columnID == COLUMN_UNSUPPORTED)
+        {
+            throw UnsupportedOperationError("Column type \"" + getColumnIDName(columnType) + "\" not supported for plot type \"" + getPlotStyleName(styleID) + "\"");
+        }
+
+        const size_t assignment = columnAssignments[columnID - 1];
+        if (assignment == COLUMN_UNUSED)
+        {
+            ColumnStatistics statistics;
+            const size_t     arity = getArity();
+
+            // *INDENT-OFF*
+            if (columnID == 1 && arity) {statistics = {0., static_cast<double>(arity - 1u), arity, 0u, 0u, true};}
+            // *INDENT-ON*
+
+            return statistics;
+        }
+
+        auto& statistics = columnStatistics[assignment - 1];
+        // *INDENT-OFF*
+        if (!statistics) {computeStatistics(getColumnPlan());}
+        // *INDENT-ON*
+
+        return statistics.value();
+    }
+
+    void DataView2D::invalidateStatistics() const
+    {
+        columnStatistics = {};
+    }
+
     bool DataView2D::isFunction() const
     {
         return !func.empty();
@@ -339,6 +1455,48 @@ namespace Plotypus
         return COLUMN_UNSUPPORTED;
     }
 
+    void DataView2D::visitRecords(const recordVisitor_t& visitor) const
+    {
+        // *INDENT-OFF*
+        if (isDummy() || isFunction()) {return;}
+        if (!isComplete()) {throw UnsupportedOperationError("Unsupported column type or non-consecutive list of columns detected");}
+        // *INDENT-ON*
+
+        const ColumnPlan columnPlan = getColumnPlan();
+        const bool       missingX   = (columnAssignments[0] == COLUMN_UNUSED);
+        selectRecords(columnPlan);
+
+        const size_t arity      = getExportArity();
+        const size_t lineLength = columnPlan.lineLength;
+
+        std::vector<double>                 blockBuffer(DATA_BLOCK_SIZE * lineLength);
+        std::vector<std::array<double, 6>>  records(std::min(DATA_BLOCK_SIZE, arity));
+
+        for (size_t blockStart = 0u; blockStart < arity; blockStart += DATA_BLOCK_SIZE)
+        {
+            const size_t blockSize = std::min(DATA_BLOCK_SIZE, arity - blockStart);
+            fetchRecords(blockBuffer, blockStart, blockSize, columnPlan);
+
+            for (size_t r = 0u; r < blockSize; ++r)
+            {
+                const double* line   = blockBuffer.data() + r * lineLength;
+                auto&         record = records[r];
+
+                for (size_t c = 0u; c < record.size(); ++c)
+                {
+                    const size_t assignment = columnAssignments[c];
+                    // *INDENT-OFF*
+                    if      (assignment != COLUMN_UNUSED) {record[c] = line[assignment - 1u - missingX];}
+                    else if (c == 0u)                     {record[c] = blockStart + r;}
+                    else                                  {record[c] = std::numeric_limits<double>::quiet_NaN();}
+                    // *INDENT-ON*
+                }
+            }
+
+            visitor(std::span<const std::array<double, 6>>(records.data(), blockSize));
+        }
+    }
+
     // ====================================================================== //
 
     void DataView2D::writeTxtData(std::ostream& hFile) const
@@ -350,32 +1508,16 @@ namespace Plotypus
         // *INDENT-ON*
         else
         {
-            const auto isUnusedColumn = [] (const size_t assignment)
-            {
-                return assignment == COLUMN_UNUSED;
-            };
-
-            bool missingXColumn = (columnAssignments[0] == COLUMN_UNUSED);
-            auto lineLength     = getConsecutiveEntriesCount(columnAssignments, isUnusedColumn);
-
-            std::vector<double> lineBuffer(lineLength);
+            const ColumnPlan columnPlan = getColumnPlan();
+            clearRecordSelection();
 
             for (const auto& headline : columnHeadlines)
             {
                 hFile << headline << columnSeparatorTxt;
             }
-            hFile << std::endl;
+            hFile << "\n";
 
-            hFile << std::setprecision(numberPrecision);
-            for (size_t i = 0u; i < getArity(); ++i)
-            {
-                fetchData(lineBuffer, i, missingXColumn);
-                for (const auto datapoint : lineBuffer)
-                {
-                    hFile << datapoint << columnSeparatorTxt;
-                }
-                hFile << std::endl;
-            }
+            writeAsciiData(hFile, columnPlan, columnSeparatorTxt);
         }
     }
 
@@ -386,29 +1528,194 @@ namespace Plotypus
         if (isFunction())   {return;}
         if (!isComplete())  {throw UnsupportedOperationError("Unsupported column type or non-consecutive list of columns detected");}
 
-        const auto isUnusedColumn = [] (const size_t assignment) {return assignment == COLUMN_UNUSED;};
+        const ColumnPlan columnPlan = getColumnPlan();
+        selectRecords(columnPlan);
+        const auto       rawLayout  = getActiveRawRecordLayout(columnPlan);
+
+        const size_t threadCount = (exportThreadCount ? exportThreadCount : std::max(1u, std::thread::hardware_concurrency()));
+        const bool   chunked     = selectorsThreadSafe && threadCount > 1u && getExportArity() > EXPORT_CHUNK_SIZE;
+
+        if (binaryDataOutput && !rawLayout) {updateResolvedColumnDataTypes(columnPlan);}
 
-        bool missingXColumn = (columnAssignments[0] == COLUMN_UNUSED);
-        auto lineLength     = getConsecutiveEntriesCount(columnAssignments, isUnusedColumn);
+        if (binaryDataOutput && !rawLayout && mappedDataOutput) {writeDatDataBinMapped (columnPlan, chunked ? threadCount : 1u); return;}
+        if (binaryDataOutput && !rawLayout && chunked)          {writeDatDataBinChunked(columnPlan, threadCount); return;}
 
-        std::vector<double> lineBuffer(lineLength);
         std::fstream hFile = openOrThrow(dataFilename);
 
-        if (binaryDataOutput)   {writeDatDataBin(hFile, lineBuffer, missingXColumn);}
-        else                    {writeDatDataAsc(hFile, lineBuffer, missingXColumn);}
+        if      (rawLayout)         {hFile.write(reinterpret_cast<const char*>(rawLayout->bytes.data()), rawLayout->bytes.size());}
+        else if (binaryDataOutput)  {writeDatDataBin(hFile, columnPlan);}
+        else if (chunked)           {writeAsciiDataChunked(hFile, columnPlan, columnSeparatorDat, threadCount);}
+        else                        {writeAsciiData(hFile, columnPlan, columnSeparatorDat);}
+        // *INDENT-ON*
+    }
+
+    std::optional<uint64_t> DataView2D::getContentFingerprint() const
+    {
+        // *INDENT-OFF*
+        if (isDummy() || isFunction() || !isComplete()) {return std::nullopt;}
+        // *INDENT-ON*
+
+        /* The spans of a view refer to memory of the client, hence changes to the data cannot be
+         * tracked via setters; the data are hashed as they would be fetched for writing instead.
+         */
+        const ColumnPlan columnPlan = getColumnPlan();
+        selectRecords(columnPlan);
+        const auto       rawLayout  = getActiveRawRecordLayout(columnPlan);
+
+        uint64_t hash = hashString(columnSeparatorDat);
+        hash = hashBytes(&binaryDataOutput,         sizeof(binaryDataOutput),   hash);
+        hash = hashBytes(&rawDataOutput,            sizeof(rawDataOutput),      hash);
+        hash = hashBytes(columnAssignments.data(),  sizeof(columnAssignments),  hash);
+        hash = hashBytes(columnDataTypes.data(),    sizeof(columnDataTypes),    hash);
+        hash = hashBytes(columnPrecisions.data(),   sizeof(columnPrecisions),   hash);
+
+        if (rawLayout)
+        {
+            hash = hashBytes(rawLayout->bytes.data(), rawLayout->bytes.size(), hash);
+            return hashBytes(rawLayout->offsets.data(), sizeof(rawLayout->offsets), hash);
+        }
+
+        const size_t arity = getExportArity();
+        std::vector<double> blockBuffer(DATA_BLOCK_SIZE * columnPlan.lineLength);
+
+        hash = hashBytes(&arity, sizeof(arity), hash);
+        for (size_t firstRecord = 0u; firstRecord < arity; firstRecord += DATA_BLOCK_SIZE)
+        {
+            const size_t recordCount = std::min(DATA_BLOCK_SIZE, arity - firstRecord);
+            fetchRecords(blockBuffer, firstRecord, recordCount, columnPlan);
+
+            hash = hashBytes(blockBuffer.data(), recordCount * columnPlan.lineLength * sizeof(double), hash);
+        }
+
+        return hash;
+    }
+
+    bool DataView2D::hasEqualContent(const DataView& other) const
+    {
+        const auto otherView = dynamic_cast<const DataView2D*>(&other);
+
+        // *INDENT-OFF*
+        if (!otherView)                                                                     {return false;}
+        if (isDummy() || isFunction() || !isComplete())                                     {return false;}
+        if (otherView->isDummy() || otherView->isFunction() || !otherView->isComplete())    {return false;}
+        // *INDENT-ON*
+
+        const bool sameSettings = columnSeparatorDat == otherView->columnSeparatorDat &&
+                                  binaryDataOutput   == otherView->binaryDataOutput   &&
+                                  rawDataOutput      == otherView->rawDataOutput      &&
+                                  columnAssignments  == otherView->columnAssignments  &&
+                                  columnDataTypes    == otherView->columnDataTypes    &&
+                                  columnPrecisions   == otherView->columnPrecisions;
+        // *INDENT-OFF*
+        if (!sameSettings) {return false;}
+        // *INDENT-ON*
+
+        // the same sequence as getContentFingerprint, comparing instead of hashing
+        const ColumnPlan columnPlan      = getColumnPlan();
+        const ColumnPlan otherColumnPlan = otherView->getColumnPlan();
+        selectRecords(columnPlan);
+        otherView->selectRecords(otherColumnPlan);
+        const auto       rawLayout       = getActiveRawRecordLayout(columnPlan);
+        const auto       otherRawLayout  = otherView->getActiveRawRecordLayout(otherColumnPlan);
+
+        // *INDENT-OFF*
+        if (rawLayout.has_value() != otherRawLayout.has_value()) {return false;}
+        if (rawLayout) {
+            return rawLayout->offsets == otherRawLayout->offsets && rawLayout->bytes.size() == otherRawLayout->bytes.size() &&
+                   std::equal(rawLayout->bytes.begin(), rawLayout->bytes.end(), otherRawLayout->bytes.begin());
+        }
+        // *INDENT-ON*
+
+        const size_t arity = getExportArity();
+        // *INDENT-OFF*
+        if (arity != otherView->getExportArity() || columnPlan.lineLength != otherColumnPlan.lineLength) {return false;}
+        // *INDENT-ON*
+
+        std::vector<double> blockBuffer     (DATA_BLOCK_SIZE * columnPlan.lineLength);
+        std::vector<double> otherBlockBuffer(DATA_BLOCK_SIZE * columnPlan.lineLength);
+
+        for (size_t firstRecord = 0u; firstRecord < arity; firstRecord += DATA_BLOCK_SIZE)
+        {
+            const size_t recordCount = std::min(DATA_BLOCK_SIZE, arity - firstRecord);
+            fetchRecords           (blockBuffer,      firstRecord, recordCount, columnPlan);
+            otherView->fetchRecords(otherBlockBuffer, firstRecord, recordCount, otherColumnPlan);
+
+            // bytewise like the hash, so that e.g. NaNs compare equal and signed zeros do not
+            // *INDENT-OFF*
+            if (std::memcmp(blockBuffer.data(), otherBlockBuffer.data(), recordCount * columnPlan.lineLength * sizeof(double))) {return false;}
+            // *INDENT-ON*
+        }
+
+        return true;
+    }
+
+    bool DataView2D::writeDatablock(std::ostream& hFile, const std::string& name) const
+    {
+        // *INDENT-OFF*
+        if (isDummy() || isFunction()) {return false;}
+        if (!isComplete()) {throw UnsupportedOperationError("Unsupported column type or non-consecutive list of columns detected");}
+        // *INDENT-ON*
+
+        const ColumnPlan columnPlan = getColumnPlan();
+        selectRecords(columnPlan);
+
+        hFile << name << " << EOD\n";
+        formatAsciiRecords([&hFile] (const char* data, size_t size) {hFile.write(data, size);},
+                           columnPlan, columnSeparatorDat, 0u, getExportArity());
+        hFile << "EOD\n";
+
+        return true;
+    }
+
+    bool DataView2D::writeArchiveData(std::ostream& hFile) const
+    {
+        // *INDENT-OFF*
+        if (isDummy() || isFunction() || !binaryDataOutput) {return false;}
+        if (!isComplete()) {throw UnsupportedOperationError("Unsupported column type or non-consecutive list of columns detected");}
+        // *INDENT-ON*
+
+        const ColumnPlan columnPlan = getColumnPlan();
+        selectRecords(columnPlan);
+        const auto       rawLayout  = getActiveRawRecordLayout(columnPlan);
+        const size_t     offset     = static_cast<size_t>(hFile.tellp());
+
+        if (rawLayout)
+        {
+            hFile.write(reinterpret_cast<const char*>(rawLayout->bytes.data()), rawLayout->bytes.size());
+            archiveSlice = ArchiveSlice{offset, getArity()};
+        }
+        else
+        {
+            updateResolvedColumnDataTypes(columnPlan);
+            writeDatDataBin(hFile, columnPlan);
+            archiveSlice = ArchiveSlice{offset, getExportArity()};
+        }
+
+        // *INDENT-OFF*
+        if (!hFile) {throw FileIOError("Could not write to '" + dataFilename + "'");}
         // *INDENT-ON*
+
+        return true;
     }
 
     void DataView2D::writeScriptData(std::ostream& hFile, const StylesCollection& stylesColloction) const
     {
+        columnAssignmentList_t fileColumns = columnAssignments;
+
         // *INDENT-OFF*
-        if (isFunction()) {hFile << func << " ";}
+        if      (isFunction())              {hFile << func << " ";}
+        else if (!datablockName.empty())    {hFile << datablockName << " ";}
         else
         {
             hFile << std::quoted(dataFilename) << " ";
-            if (binaryDataOutput) {hFile << "binary format=\"%float64\" ";}
+
+            const ColumnPlan columnPlan = (rawDataOutput ? getColumnPlan() : ColumnPlan());
+            const auto       rawLayout  = getActiveRawRecordLayout(columnPlan);
+
+            if      (rawLayout)         {writeRawBinaryFormat(hFile, rawLayout.value(), columnPlan, fileColumns);}
+            else if (binaryDataOutput)  {writeBinaryFormat(hFile);}
         }
-        writeUsingSpecification(hFile);
+        writeUsingSpecification(hFile, fileColumns);
 
         if (!options.empty()) {hFile << options << " ";}
         hFile << optionalQuotedTextString("title", title);
@@ -3,8 +3,10 @@
 
 #include <array>
 #include <concepts>
+#include <optional>
 #include <span>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "dataview.h"
@@ -19,13 +21,105 @@ namespace Plotypus
             size_t lineStyle  = STYLE_ID_DEFAULT;
             size_t pointStyle = STYLE_ID_DEFAULT;
 
+            bool rawDataOutput = false;
+
+            size_t decimationPixels    = 0u;
+            double decimationMin       = AXIS_AUTO_RANGE;
+            double decimationMax       = AXIS_AUTO_RANGE;
+
+            double cullingMin          = AXIS_AUTO_RANGE;
+            double cullingMax          = AXIS_AUTO_RANGE;
+
+            //! @brief decimation set by a Report for the current export, see setAutoDecimation
+            mutable size_t autoDecimationPixels = 0u;
+            mutable double autoDecimationMin    = AXIS_AUTO_RANGE;
+            mutable double autoDecimationMax    = AXIS_AUTO_RANGE;
+
+            //! @brief culling range set by a Report for the current export, see setAutoCullingRange
+            mutable double autoCullingMin       = AXIS_AUTO_RANGE;
+            mutable double autoCullingMax       = AXIS_AUTO_RANGE;
+
+            //! @brief records written by writeDatData if selectionActive, in ascending order
+            mutable std::vector<size_t> selectedRecords;
+            mutable bool                selectionActive = false;
+
+            bool   mappedDataOutput    = false;
+            size_t exportThreadCount   = 1u;
+            bool   selectorsThreadSafe = false;
+
+            //! @brief column data types of the last binary data file written, per position in line, with ColumnDataType::Auto resolved
+            mutable std::vector<ColumnDataType> resolvedColumnDataTypes;
+            //! @brief column assignments and requested column data types that resolvedColumnDataTypes was resolved for
+            mutable columnAssignmentList_t      resolvedColumnAssignments;
+            mutable columnDataTypeList_t        resolvedRequestedDataTypes;
+
+            //! @brief statistics per source column (zero based), computed on demand by getStatistics
+            mutable std::array<std::optional<ColumnStatistics>, 6> columnStatistics;
+
             virtual void clearFunctionMembers();
-            virtual void fetchData(std::vector<double>& buffer, size_t recordID, bool missingXColumn) const = 0;
+            //! @brief drops everything derived from the data; to be called whenever the data or selectors are replaced.
+            void         clearDataCaches() const;
+
+            /**
+             * @brief fills `recordCount` consecutive records, starting at `firstRecord`, into `buffer`.
+             *
+             * Records are stored line by line, i.e. the value for column `columnPlan.targets[c]` of
+             * the `r`<sup>th</sup> record of the block goes to `buffer[r * columnPlan.lineLength + columnPlan.targets[c]]`.
+             */
+            virtual void fetchBlock(std::span<double> buffer, size_t firstRecord, size_t recordCount, const ColumnPlan& columnPlan) const = 0;
+
+            /**
+             * @brief returns the byte layout of the underlying records if they can be written to the data file
+             *  unchanged, i.e. if every column in `columnPlan` is read directly from a double member of a
+             *  trivially copyable record type.
+             */
+            virtual std::optional<RawRecordLayout> getRawRecordLayout(const ColumnPlan& columnPlan) const;
+
+            ColumnPlan getColumnPlan() const;
+
+            static bool         isLineLikeStyle(const PlotStyle2D style);
+            //! @brief returns the pixel budget and X range of the decimation in effect, i.e. the own ones or else the automatic ones.
+            std::tuple<size_t, double, double> getDecimationSettings() const;
+            std::vector<size_t> computeDecimation(const ColumnPlan& columnPlan, size_t firstRecord, size_t lastRecord) const;
+            //! @brief returns the culling range in effect, i.e. the own one or else the automatic one, with the lower limit first.
+            std::pair<double, double> getCullingLimits() const;
+            //! @brief returns the records [first, last) that survive culling, given that the X column is ascending.
+            std::pair<size_t, size_t> findCullingInterval(const ColumnPlan& columnPlan) const;
+            std::vector<size_t>       computeCulling     (const ColumnPlan& columnPlan) const;
+            void                selectRecords(const ColumnPlan& columnPlan) const;
+            void                clearRecordSelection() const;
 
-            void writeDatDataAsc(std::ostream& hFile, std::vector<double>& lineBuffer, bool missingXColumn) const;
-            void writeDatDataBin(std::ostream& hFile, std::vector<double>& lineBuffer, bool missingXColumn) const;
+            static void accumulateStatistics(ColumnStatistics& statistics, std::span<const double> values, double previous);
+            void        computeStatistics(const ColumnPlan& columnPlan) const;
 
-            void writeUsingSpecification(std::ostream& hFile) const;
+            //! @brief number of records to be written, i.e. the number of selected records if a selection is active
+            size_t getExportArity() const;
+            //! @brief same as fetchBlock, but with record indices referring to the selected records if a selection is active
+            void   fetchRecords(std::span<double> buffer, size_t firstRecord, size_t recordCount, const ColumnPlan& columnPlan) const;
+            std::optional<RawRecordLayout> getActiveRawRecordLayout(const ColumnPlan& columnPlan) const;
+
+            std::vector<ColumnDataType> resolveColumnDataTypes(const ColumnPlan& columnPlan) const;
+            void                        updateResolvedColumnDataTypes(const ColumnPlan& columnPlan) const;
+            void                        narrowColumnDataTypes (std::vector<ColumnDataType>& columnDataTypes, const ColumnPlan& columnPlan) const;
+            static void                 encodeColumn(const ColumnDataType columnDataType, const double* source, size_t sourceStride, size_t count, std::byte* target, size_t targetStride);
+
+            std::vector<int>            getLinePrecisions(const ColumnPlan& columnPlan) const;
+
+            void   formatAsciiRecords (const dataSink_t& sink, const ColumnPlan& columnPlan, const std::string& separator, size_t firstRecord, size_t recordCount) const;
+            //! @brief fetches and encodes records as specified by resolvedColumnDataTypes to `target`, which must hold `recordCount` records.
+            void   encodeBinaryRecordsInto(std::byte* target, const ColumnPlan& columnPlan, size_t firstRecord, size_t recordCount) const;
+            void   encodeBinaryRecords(const dataSink_t& sink, const ColumnPlan& columnPlan, size_t firstRecord, size_t recordCount) const;
+            size_t getBinaryRecordSize() const;
+
+            void writeAsciiData         (std::ostream& hFile, const ColumnPlan& columnPlan, const std::string& separator) const;
+            void writeAsciiDataChunked  (std::ostream& hFile, const ColumnPlan& columnPlan, const std::string& separator, size_t threadCount) const;
+            void writeDatDataBin        (std::ostream& hFile, const ColumnPlan& columnPlan) const;
+            void writeDatDataBinChunked (const ColumnPlan& columnPlan, size_t threadCount) const;
+            void writeDatDataBinMapped  (const ColumnPlan& columnPlan, size_t threadCount) const;
+
+            void writeBinaryFormat      (std::ostream& hFile) const;
+            void writeRawBinaryFormat   (std::ostream& hFile, const RawRecordLayout& layout, const ColumnPlan& columnPlan, columnAssignmentList_t& fileColumns) const;
+            void writeUsingSpecification(std::ostream& hFile, const columnAssignmentList_t& fileColumns) const;
 
         public:
             DataView2D(const PlotStyle2D  style, const std::string& label = "");
@@ -40,16 +134,122 @@ namespace Plotypus
 
             size_t                      getLineStyle() const;
             void                        setLineStyle(size_t newLineStyle);
+            size_t                      getPointStyle() const;
+            void                        setPointStyle(size_t newPointStyle);
+
+            /**
+             * @brief requests writing the records of the underlying data to the binary data file byte by byte.
+             *
+             * Only takes effect for binary data output, and only if the view can provide a RawRecordLayout
+             * (see DataView2DCompound::setSelector with a pointer to a double member). Otherwise, the data
+             * are re-packed as usual. Raw records keep their member types, hence columnDataType is
+             * ignored in this mode.
+             */
+            bool                        getRawDataOutput() const;
+            void                        setRawDataOutput(bool newRawDataOutput);
+
+            /**
+             * @brief reduces the records written to the data file to what can be seen at a width of `pixels` columns.
+             *
+             * Applies to line-like styles (Lines, Steps, FSteps, LinesPoints, FilledCurves) only. The X range set by
+             * setDecimationRange (by default, the range of the data) is split into `pixels` columns, and per column
+             * only the first, last, lowest and highest record (by Y) are kept (M4 decimation). Records outside the
+             * range are treated as two more columns. Intended for data sorted by X; zero disables decimation.
+             */
+            size_t                      getDecimationPixels() const;
+            void                        setDecimationPixels(size_t newDecimationPixels);
+            std::pair<double, double>   getDecimationRange() const;
+            //! @brief sets the X range mapped to the decimation pixels; AXIS_AUTO_RANGE takes the respective limit from the data.
+            void                        setDecimationRange(double newDecimationMin, double newDecimationMax);
+            /**
+             * @brief sets the decimation of the next exports for views without a pixel budget of their own.
+             *
+             * Used by Report::setAutoDecimation, which sets it anew on every export; the settings of the view are
+             * left untouched. Zero `newAutoDecimationPixels` disables it.
+             */
+            void                        setAutoDecimation(size_t newAutoDecimationPixels, double newAutoDecimationMin, double newAutoDecimationMax) const;
+
+            /**
+             * @brief restricts the records written to the data file to those with X in [`newCullingMin`, `newCullingMax`].
+             *
+             * For line-like styles, the records next to the range are kept as well, so that the lines crossing its
+             * borders are drawn as before; records that interrupt lines (X is NaN) are kept, too. Only X is taken
+             * into account: symbols and error bars of records outside the range that reach into it are lost. If
+             * the X column is ascending (see getStatistics), the range is found by binary search, otherwise all
+             * records are checked; the order is checked anew on each export. Culling precedes decimation. The
+             * limits may be given in either order. AXIS_AUTO_RANGE leaves the respective side open; both limits
+             * AXIS_AUTO_RANGE (the default) disable culling.
+             */
+            std::pair<double, double>   getCullingRange() const;
+            void                        setCullingRange(double newCullingMin, double newCullingMax);
+            /**
+             * @brief sets the culling range of the next exports for views without a culling range of their own.
+             *
+             * Used by Report::setAutoCulling, which sets it anew on every export; the settings of the view are
+             * left untouched.
+             */
+            void                        setAutoCullingRange(double newAutoCullingMin, double newAutoCullingMax) const;
+
+            /**
+             * @brief requests writing binary data files through a memory mapping of the preallocated file.
+             *
+             * The records are fetched (and, if need be, narrowed) directly into the mapped file, bypassing
+             * std::fstream. Combines with the chunked export (see setExportThreadCount). Ignored for raw and
+             * ASCII output.
+             */
+            bool                        getMappedDataOutput() const;
+            void                        setMappedDataOutput(bool newMappedDataOutput);
+
+            /**
+             * @brief number of threads writing the data file of this view; zero uses one thread per hardware thread.
+             *
+             * With more than one thread, the records are split into chunks of EXPORT_CHUNK_SIZE records that are
+             * fetched and encoded concurrently: binary chunks are written to their final position in the file,
+             * ASCII chunks are concatenated in order. This only takes effect once the selectors have been declared
+             * thread-safe with setSelectorsThreadSafe.
+             */
+            size_t                      getExportThreadCount() const;
+            void                        setExportThreadCount(size_t newExportThreadCount);
+            //! @brief declares that the data source and selectors of this view may be called from several threads at once.
+            bool                        getSelectorsThreadSafe() const;
+            void                        setSelectorsThreadSafe(bool newSelectorsThreadSafe);
 
             virtual bool isFunction() const;
             virtual size_t getColumnID(const ColumnType columnType) const;
 
+            /**
+             * @brief returns the statistics of the values in the plot column `columnType` over all records, before decimation.
+             *
+             * All columns in use are summarized in one pass over the data when the first of them is requested;
+             * the results are kept until the data or selectors are replaced, or a Report preprocesses the
+             * sheet of the view for an export. Other changes of the data in client memory go unnoticed, call
+             * invalidateStatistics after them. An unassigned X column yields the
+             * statistics of the record numbers, other unassigned columns and functions yield no values.
+             */
+            ColumnStatistics getStatistics(const ColumnType columnType) const;
+            void             invalidateStatistics() const;
+
+            /**
+             * @brief hands the records to `visitor` in blocks of up to DATA_BLOCK_SIZE, as they would be written to
+             *  the data file, i.e. after decimation.
+             *
+             * Each record holds the values in order of the plot columns (X, Y, ...), as addressed by the using
+             * specification: an unassigned X column holds the number of the record, other unassigned columns
+             * hold NaN. Does nothing for functions and views without data.
+             */
+            void visitRecords(const recordVisitor_t& visitor) const;
+
             // -------------------------------------------------------------- //
             // writers
 
             virtual void writeTxtData   (std::ostream& hFile) const;
             virtual void writeDatData   ()                    const;
             virtual void writeScriptData(std::ostream& hFile, const StylesCollection& stylesColloction) const;
+
+            virtual std::optional<uint64_t> getContentFingerprint() const;
+            virtual bool                    hasEqualContent(const DataView& other) const;
+            virtual bool                    writeDatablock(std::ostream& hFile, const std::string& name) const;
+            virtual bool                    writeArchiveData(std::ostream& hFile) const;
     };
 }
 
@@ -13,10 +13,12 @@ namespace Plotypus
         protected:
             std::span<T>                        data;
             std::array<DataSelector_t<T>, 6>    selectors;
+            std::array<DataMember_t<T>, 6>      members = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
 
             virtual void clearNonFunctionMembers();
 
-            virtual void fetchData(std::vector<double>& buffer, size_t recordID, bool missingXColumn) const;
+            virtual void fetchBlock(std::span<double> buffer, size_t firstRecord, size_t recordCount, const ColumnPlan& columnPlan) const;
+            virtual std::optional<RawRecordLayout> getRawRecordLayout(const ColumnPlan& columnPlan) const;
 
         public:
             DataView2DCompound(const PlotStyle2D  style, const std::string& label = "");
@@ -33,6 +35,13 @@ namespace Plotypus
             const std::array<DataSelector_t<T>, 6>& getSelectors() const;
             void                                    setSelectors(const std::array<DataSelector_t<T>, 6>& newSelectors);
             void                                    setSelector (const ColumnType column, const DataSelector_t<T>& selector);
+            /**
+             * @brief sets the selector for `column` to read the double `member` of each record.
+             *
+             * Unlike an equivalent lambda, this allows writing the records to a binary data file unchanged,
+             * cf. DataView2D::setRawDataOutput.
+             */
+            void                                    setSelector (const ColumnType column, DataMember_t<T> member) requires std::is_class_v<T>;
 
             virtual bool isDummy() const;
             virtual bool isComplete() const;
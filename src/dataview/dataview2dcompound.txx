@@ -10,23 +10,64 @@ namespace Plotypus
     {
         data = std::span<T>();
         selectors = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
+        members   = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
     }
 
     template<class T>
-    void DataView2DCompound<T>::fetchData(std::vector<double>& buffer, size_t recordID, bool missingXColumn) const
+    void DataView2DCompound<T>::fetchBlock(std::span<double> buffer, size_t firstRecord, size_t recordCount, const ColumnPlan& columnPlan) const
     {
-        // *INDENT-OFF*
-        const T& datapoint = data[recordID];
-        for (auto i : columnAssignments) {
-            if (i == COLUMN_UNUSED) {continue;}         // ignore unused columns
-            --i;                                        // zero based indices
+        /* column by column rather than record by record: the selector is resolved
+         * once per block, and the inner loop only walks the records.
+         */
+        const auto block      = data.subspan(firstRecord, recordCount);
+        const auto lineLength = columnPlan.lineLength;
 
-            const auto& selector = selectors[i];        // fetch correct selector
-            i -= missingXColumn;                        // correct for maybe missing X column
+        for (size_t i = 0u; i < columnPlan.sources.size(); ++i)
+        {
+            const auto& selector = selectors[columnPlan.sources[i]];
+            double*     target   = buffer.data() + columnPlan.targets[i];
+
+            for (const T& datapoint : block)
+            {
+                *target = selector(datapoint);
+                target += lineLength;
+            }
+        }
+    }
 
-            buffer[i] = selector(datapoint);
+    template<class T>
+    std::optional<RawRecordLayout> DataView2DCompound<T>::getRawRecordLayout(const ColumnPlan& columnPlan) const
+    {
+        if constexpr (!std::is_class_v<T> || !std::is_trivially_copyable_v<T>)
+        {
+            return std::nullopt;
+        }
+        else
+        {
+            // *INDENT-OFF*
+            if (data.empty()) {return std::nullopt;}
+            // *INDENT-ON*
+
+            const T&    front = data.front();
+            const auto* base  = reinterpret_cast<const std::byte*>(&front);
+
+            RawRecordLayout layout;
+            layout.bytes      = std::as_bytes(data);
+            layout.recordSize = sizeof(T);
+
+            for (const auto source : columnPlan.sources)
+            {
+                const auto member = members[source];
+
+                // *INDENT-OFF*
+                if (!member) {return std::nullopt;}
+                // *INDENT-ON*
+
+                layout.offsets[source] = reinterpret_cast<const std::byte*>(&(front.*member)) - base;
+            }
+
+            return layout;
         }
-        // *INDENT-ON*
     }
 
     // ====================================================================== //
@@ -59,12 +100,14 @@ namespace Plotypus
     void DataView2DCompound<T>::setData(const std::span<T>& newDataSource)
     {
         data = newDataSource;
+        clearDataCaches();
     }
 
     template<class T>
     void DataView2DCompound<T>::setData(const T* newDataSource, size_t N)
     {
         data = std::span<T>(newDataSource, newDataSource + N);
+        clearDataCaches();
     }
 
     template<class T>
@@ -77,12 +120,14 @@ namespace Plotypus
     void DataView2DCompound<T>::setSelectors(const std::array<DataSelector_t<T>, 6>& newSelectors)
     {
         selectors = newSelectors;
+        members   = {nullptr, nullptr, nullptr, nullptr, nullptr, nullptr};
         for (size_t i = 0u; const auto& selector : selectors)
         {
             // *INDENT-OFF*
             if (selector) {columnAssignments[i] = ++i;}         // columnAssignments[i] = i + 1 for i in range(size)
             // *INDENT-ON*
         }
+        clearDataCaches();
     }
 
     template<class T>
@@ -101,8 +146,17 @@ namespace Plotypus
         }
 
         selectors        [columnID - 1] = selector;
+        members          [columnID - 1] = nullptr;
         columnAssignments[columnID - 1] = columnID;
         columnHeadlines  [columnID - 1] = getColumnIDName(column);
+        clearDataCaches();
+    }
+
+    template<class T>
+    void DataView2DCompound<T>::setSelector(const ColumnType column, DataMember_t<T> member) requires std::is_class_v<T>
+    {
+        setSelector(column, DataSelector_t<T>([member] (const T& datapoint) {return datapoint.*member;}));
+        members[getColumnID(column) - 1] = member;
     }
 
     template<class T>
@@ -0,0 +1,64 @@
+#ifndef DATAVIEW2DCOMPOUNDSTATIC_H
+#define DATAVIEW2DCOMPOUNDSTATIC_H
+
+#include <array>
+#include <functional>
+
+#include "dataview2d.h"
+
+namespace Plotypus
+{
+    /**
+     * @brief DataView on a sequence of compound objects with selectors fixed at compile time
+     *
+     * Counterpart of DataView2DCompound without std::function: each selector is a template
+     * parameter (a captureless lambda, a function pointer or a pointer to member), and the
+     * number of selectors is the number of columns required by the PlotStyle2D. A single
+     * selector provides the Y column only; otherwise the selectors provide the columns 1, 2, ...
+     * in order.
+     *
+     * Since the column layout is known at compile time, each record is unpacked into a
+     * fixed size std::array with a fold expression rather than a loop over std::functions.
+     * If all selectors are pointers to double members of a trivially copyable T, the records
+     * can also be written to the data file unchanged (cf. DataView2D::setRawDataOutput).
+     */
+    template<class T, auto... Selectors>
+    class DataView2DCompoundStatic : public DataView2D
+    {
+            static_assert(sizeof...(Selectors) >= 1 && sizeof...(Selectors) <= 6,
+                          "DataView2DCompoundStatic requires between one and six selectors");
+            static_assert((StaticDataSelector<decltype(Selectors), T> && ...),
+                          "each selector must extract a value convertible to double from const T&");
+
+        public:
+            static constexpr size_t columnCount = sizeof...(Selectors);
+
+        protected:
+            std::span<T> data;
+
+            void assignColumns();
+
+            virtual void clearNonFunctionMembers();
+
+            virtual void fetchBlock(std::span<double> buffer, size_t firstRecord, size_t recordCount, const ColumnPlan& columnPlan) const;
+            virtual std::optional<RawRecordLayout> getRawRecordLayout(const ColumnPlan& columnPlan) const;
+
+        public:
+            DataView2DCompoundStatic(const PlotStyle2D  style, const std::string& label = "");
+            DataView2DCompoundStatic(const std::string& style, const std::string& label = "");
+
+            virtual void reset();
+
+            virtual size_t      getArity() const;
+
+            const std::span<T>& getData() const;
+            void                setData(const std::span<T>& newDataSource);
+            void                setData(T* newDataSource, size_t N);
+
+            virtual bool isDummy() const;
+            virtual bool isComplete() const;
+    };
+}
+
+#include "dataview2dcompoundstatic.txx"
+#endif // DATAVIEW2DCOMPOUNDSTATIC_H
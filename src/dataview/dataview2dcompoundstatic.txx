@@ -0,0 +1,203 @@
+#ifndef DATAVIEW2DCOMPOUNDSTATIC_TXX
+#define DATAVIEW2DCOMPOUNDSTATIC_TXX
+
+#include "dataview2dcompoundstatic.h"
+
+namespace Plotypus
+{
+    template<class T, auto... Selectors>
+    void DataView2DCompoundStatic<T, Selectors...>::assignColumns()
+    {
+        columnAssignments = {COLUMN_UNUSED, COLUMN_UNUSED, COLUMN_UNUSED, COLUMN_UNUSED, COLUMN_UNUSED, COLUMN_UNUSED};
+
+        // *INDENT-OFF*
+        if constexpr (columnCount == 1) {columnAssignments[1] = 2;}     // a lone selector provides the Y column
+        else {
+            for (size_t i = 0u; i < columnCount; ++i) {columnAssignments[i] = i + 1;}
+        }
+        // *INDENT-ON*
+    }
+
+    template<class T, auto... Selectors>
+    void DataView2DCompoundStatic<T, Selectors...>::clearNonFunctionMembers()
+    {
+        data = std::span<T>();
+    }
+
+    template<class T, auto... Selectors>
+    void DataView2DCompoundStatic<T, Selectors...>::fetchBlock(std::span<double> buffer, size_t firstRecord, size_t recordCount, const ColumnPlan& columnPlan) const
+    {
+        /* The selectors are fixed by the template parameters; column assignments may leave out
+         * some of them, but cannot refer to columns without a selector.
+         */
+        constexpr size_t firstSource = (columnCount == 1);      // a lone selector provides column 2
+        for (const auto source : columnPlan.sources)
+        {
+            // *INDENT-OFF*
+            if (source < firstSource || source - firstSource >= columnCount) {throw UnsupportedOperationError("Column assignments of a DataView2DCompoundStatic cannot refer to columns without selector");}
+            // *INDENT-ON*
+        }
+
+        const auto block = data.subspan(firstRecord, recordCount);
+        double*    line  = buffer.data();
+
+        for (const T& datapoint : block)
+        {
+            const std::array<double, columnCount> values = {static_cast<double>(std::invoke(Selectors, datapoint))...};
+            for (size_t i = 0u; i < columnPlan.sources.size(); ++i)
+            {
+                line[columnPlan.targets[i]] = values[columnPlan.sources[i] - firstSource];
+            }
+            line += columnPlan.lineLength;
+        }
+    }
+
+    template<class T, auto... Selectors>
+    std::optional<RawRecordLayout> DataView2DCompoundStatic<T, Selectors...>::getRawRecordLayout(const ColumnPlan& columnPlan) const
+    {
+        if constexpr (!std::is_trivially_copyable_v<T> || !(std::is_same_v<decltype(Selectors), double T::*> && ...))
+        {
+            return std::nullopt;
+        }
+        else
+        {
+            // *INDENT-OFF*
+            if (data.empty()) {return std::nullopt;}
+            // *INDENT-ON*
+
+            const T&    front = data.front();
+            const auto* base  = reinterpret_cast<const std::byte*>(&front);
+
+            const std::array<size_t, columnCount> memberOffsets = {static_cast<size_t>(reinterpret_cast<const std::byte*>(&(front.*Selectors)) - base)...};
+
+            RawRecordLayout layout;
+            layout.bytes      = std::as_bytes(data);
+            layout.recordSize = sizeof(T);
+
+            for (const auto source : columnPlan.sources)
+            {
+                layout.offsets[source] = memberOffsets[source - (columnCount == 1)];     // a lone selector provides column 2
+            }
+
+            return layout;
+        }
+    }
+
+    // ====================================================================== //
+
+    template<class T, auto... Selectors>
+    DataView2DCompoundStatic<T, Selectors...>::DataView2DCompoundStatic(const PlotStyle2D style, const std::string& label) :
+        DataView2D(style, label)
+    {
+        assignColumns();
+    }
+
+    template<class T, auto... Selectors>
+    DataView2DCompoundStatic<T, Selectors...>::DataView2DCompoundStatic(const std::string& style, const std::string& label) :
+        DataView2D(style, label)
+    {
+        assignColumns();
+    }
+
+    // ====================================================================== //
+
+    template<class T, auto... Selectors>
+    void DataView2DCompoundStatic<T, Selectors...>::reset()
+    {
+        DataView2D::reset();
+        assignColumns();
+    }
+
+    template<class T, auto... Selectors>
+    size_t DataView2DCompoundStatic<T, Selectors...>::getArity() const
+    {
+        return data.size();
+    }
+
+    template<class T, auto... Selectors>
+    const std::span<T>& DataView2DCompoundStatic<T, Selectors...>::getData() const
+    {
+        return data;
+    }
+
+    template<class T, auto... Selectors>
+    void DataView2DCompoundStatic<T, Selectors...>::setData(const std::span<T>& newDataSource)
+    {
+        data = newDataSource;
+        clearDataCaches();
+    }
+
+    template<class T, auto... Selectors>
+    void DataView2DCompoundStatic<T, Selectors...>::setData(T* newDataSource, size_t N)
+    {
+        data = std::span<T>(newDataSource, N);
+        clearDataCaches();
+    }
+
+    template<class T, auto... Selectors>
+    bool DataView2DCompoundStatic<T, Selectors...>::isDummy() const
+    {
+        return func.empty() && data.empty();
+    }
+
+    template<class T, auto... Selectors>
+    bool DataView2DCompoundStatic<T, Selectors...>::isComplete() const
+    {
+        // *INDENT-OFF*
+        if (isDummy())      {return true;}
+        if (data.empty())   {return false;}
+
+        const auto isUnusedColumn = [] (const size_t assignment) {return assignment == COLUMN_UNUSED;};
+        // *INDENT-ON*
+
+        switch (styleID)
+        {
+            case PlotStyle2D::Dots:
+                return checkColumnListOccupationIsFrom(columnAssignments, {1, 2}, isUnusedColumn);
+            case PlotStyle2D::Points:
+                return checkColumnListOccupationIsFrom(columnAssignments, {1, 2, 3, 4, 5}, isUnusedColumn);
+            case PlotStyle2D::XErrorBars:
+                return checkColumnListOccupationIsFrom(columnAssignments, {3, 4}, isUnusedColumn);
+            case PlotStyle2D::YErrorBars:
+                return checkColumnListOccupationIsFrom(columnAssignments, {3, 4}, isUnusedColumn);
+            case PlotStyle2D::XYErrorBars:
+                return checkColumnListOccupationIsFrom(columnAssignments, {4, 6}, isUnusedColumn);
+            case PlotStyle2D::Lines:
+                return checkColumnListOccupationIsFrom(columnAssignments, {1, 2}, isUnusedColumn);
+            case PlotStyle2D::LinesPoints:
+                return checkColumnListOccupationIsFrom(columnAssignments, {1, 2}, isUnusedColumn);
+            case PlotStyle2D::FilledCurves:
+                return checkColumnListOccupationIsFrom(columnAssignments, {1, 2, 3}, isUnusedColumn);
+            case PlotStyle2D::XErrorLines:
+                return checkColumnListOccupationIsFrom(columnAssignments, {3, 4}, isUnusedColumn);
+            case PlotStyle2D::YErrorLines:
+                return checkColumnListOccupationIsFrom(columnAssignments, {3, 4}, isUnusedColumn);
+            case PlotStyle2D::XYErrorLines:
+                return checkColumnListOccupationIsFrom(columnAssignments, {4, 6}, isUnusedColumn);
+            case PlotStyle2D::Steps:
+                return checkColumnListOccupationIsFrom(columnAssignments, {1, 2}, isUnusedColumn);
+            case PlotStyle2D::FSteps:
+                return checkColumnListOccupationIsFrom(columnAssignments, {1, 2}, isUnusedColumn);
+            case PlotStyle2D::FillSteps:
+                return checkColumnListOccupationIsFrom(columnAssignments, {1, 2}, isUnusedColumn);
+            case PlotStyle2D::Boxes:
+                return checkColumnListOccupationIsFrom(columnAssignments, {1, 2, 3}, isUnusedColumn);
+            case PlotStyle2D::HBoxes:
+                return checkColumnListOccupationIsFrom(columnAssignments, {1, 2, 3}, isUnusedColumn);
+            case PlotStyle2D::BoxErrorBars:
+                return checkColumnListOccupationIsFrom(columnAssignments, {3, 4, 5}, isUnusedColumn);
+            case PlotStyle2D::BoxxyError:
+                return checkColumnListOccupationIsFrom(columnAssignments, {4, 6}, isUnusedColumn);
+            case PlotStyle2D::Arrows:
+                return checkColumnListOccupationIsFrom(columnAssignments, {4}, isUnusedColumn);
+            case PlotStyle2D::Vectors:
+                return checkColumnListOccupationIsFrom(columnAssignments, {4}, isUnusedColumn);
+            case PlotStyle2D::Custom:
+                return checkColumnListOccupationIsFrom(columnAssignments, {1, 2, 3, 4, 5, 6}, isUnusedColumn);
+        }
+
+        return false;
+    }
+}
+
+#endif // DATAVIEW2DCOMPOUNDSTATIC_TXX
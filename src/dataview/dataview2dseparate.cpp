@@ -10,9 +10,21 @@ namespace Plotypus
         }
     }
 
-    void DataView2DSeparate::fetchData(std::vector<double>& buffer, size_t recordID, bool missingXColumn) const
+    void DataView2DSeparate::fetchBlock(std::span<double> buffer, size_t firstRecord, size_t recordCount, const ColumnPlan& columnPlan) const
     {
+        const auto lineLength = columnPlan.lineLength;
 
+        for (size_t i = 0u; i < columnPlan.sources.size(); ++i)
+        {
+            const auto  column = m_data[columnPlan.sources[i]].subspan(firstRecord, recordCount);
+            double*     target = buffer.data() + columnPlan.targets[i];
+
+            for (const double datapoint : column)
+            {
+                *target = datapoint;
+                target += lineLength;
+            }
+        }
     }
 
     DataView2DSeparate::DataView2DSeparate(const PlotStyle2D style, const std::string& label) :
@@ -25,14 +37,34 @@ namespace Plotypus
 
     size_t DataView2DSeparate::getArity() const
     {
-        return m_data[1].size();          // quick solution: return arity of Y column
+        // shortest occupied column, so that a block never reads past the end of any span
+        size_t result = m_data[1].size();
+        for (const auto& component : m_data)
+        {
+            // *INDENT-OFF*
+            if (!component.empty()) {result = std::min(result, component.size());}
+            // *INDENT-ON*
+        }
+        return result;
     }
 
     std::span<double>& DataView2DSeparate::data(ColumnType columnType)
     {
         const auto columnID = getColumnID(columnType);
-        throwIfInvalidIndex("column index", columnID, m_data);
-        return m_data[columnID];
+
+        if (columnID == COLUMN_UNSUPPORTED)
+        {
+            std::string errMsg = "Column type ";
+            errMsg += "\"" + getColumnIDName(columnType) + "\"";
+            errMsg += " not supported for plot type ";
+            errMsg += "\"" + getPlotStyleName(styleID) + "\"";
+
+            throw UnsupportedOperationError( errMsg );
+        }
+
+        columnAssignments[columnID - 1] = columnID;
+        columnHeadlines  [columnID - 1] = getColumnIDName(columnType);
+        return m_data[columnID - 1];
     }
 
     const columnViewList_t& DataView2DSeparate::getData() const
@@ -43,6 +75,15 @@ namespace Plotypus
     void DataView2DSeparate::setData(const columnViewList_t& newData)
     {
         m_data = newData;
+        for (size_t i = 0u; const auto& component : m_data)
+        {
+            // *INDENT-OFF*
+            if (!component.empty()) {columnAssignments[i] = i + 1;}
+            else                    {columnAssignments[i] = COLUMN_UNUSED;}
+            ++i;
+            // *INDENT-ON*
+        }
+        clearDataCaches();
     }
 
     bool DataView2DSeparate::isDummy() const
@@ -12,7 +12,7 @@ namespace Plotypus
 
             virtual void clearNonFunctionMembers();
 
-            virtual void fetchData(std::vector<double>& buffer, size_t recordID, bool missingXColumn) const;
+            virtual void fetchBlock(std::span<double> buffer, size_t firstRecord, size_t recordCount, const ColumnPlan& columnPlan) const;
 
         public:
             DataView2DSeparate(const PlotStyle2D  style, const std::string& label = "");
@@ -1,6 +1,9 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
+#include <cstddef>
+#include <cstdint>
+
 namespace Plotypus
 {
 //! @addtogroup Plotypus_Definitions
@@ -20,12 +23,47 @@ namespace Plotypus
         Png,
         PostScript,
         Screen,
+        Svg,
 
         Custom
     };
 
     // ---------------------------------------------------------------------- //
 
+    /**
+     * @brief how data files (and the script) are handed to gnuplot
+     *
+     * - `Files`: regular files in the output directory.
+     * - `MemoryFiles`: anonymous in-memory files (memfd_create) that gnuplot inherits and opens as
+     *   `/proc/self/fd/N`; nothing is written to the file system except the terminal output.
+     * - `Archive`: the binary data of all DataViews are appended to a single file in the output directory,
+     *   and each view addresses its records by byte offset (`skip=`) and count (`record=`).
+     */
+    enum class DataTransport
+    {
+        Files,
+        MemoryFiles,
+        Archive
+    };
+
+    // ---------------------------------------------------------------------- //
+
+    /**
+     * @brief how the native text renderer (TextCanvas) draws graphics into character cells
+     *
+     * - `Characters`: one dot per cell, drawn with `-`, `|`, `+` and `*` like gnuplot's dumb terminal.
+     * - `Blocks`: 2 x 2 dots per cell, drawn with the Unicode quadrant block elements.
+     * - `Braille`: 2 x 4 dots per cell, drawn with the Unicode Braille patterns.
+     */
+    enum class CellGlyphs
+    {
+        Characters,
+        Blocks,
+        Braille
+    };
+
+    // ---------------------------------------------------------------------- //
+
     enum class LengthUnit
     {
         Inch,
@@ -81,6 +119,30 @@ namespace Plotypus
         Length, Angle
     };
 
+    // ====================================================================== //
+    /**
+     * @brief element type of a column in binary data files
+     *
+     * `Auto` selects the narrowest of the other types that represents all values
+     * of the column without loss; it is resolved each time the data are written.
+     * Values are truncated towards zero when written to integer types; values that
+     * do not fit the integer type, as well as NaN and infinities, make writing the
+     * data file fail with an InvalidArgumentError.
+     */
+    enum class ColumnDataType
+    {
+        Float64,
+        Float32,
+        Int32,
+        Int16,
+        Int8,
+        UInt32,
+        UInt16,
+        UInt8,
+
+        Auto
+    };
+
     // ====================================================================== //
     /**
      * @brief foo bar
@@ -231,6 +293,40 @@ namespace Plotypus
     constexpr auto COLUMN_FORMAT_FILTER_POSITIVE = "($_ >= 0 ? $_ : 1/0)";
     constexpr auto COLUMN_FORMAT_FILTER_NEGATIVE = "($_ <= 0 ? $_ : 1/0)";
 
+    /**
+     * @brief number of records fetched from a DataView in one go while writing data files
+     */
+    constexpr size_t DATA_BLOCK_SIZE        = 4096u;
+
+    /**
+     * @brief size of the per-thread character buffer ASCII data are formatted into before being written
+     */
+    constexpr size_t ASCII_BUFFER_SIZE      = 1u << 20;
+
+    /**
+     * @brief number of records processed by one thread in one go when a single DataView is written concurrently
+     */
+    constexpr size_t EXPORT_CHUNK_SIZE      = 64u * DATA_BLOCK_SIZE;
+
+    //! @brief resolution assumed when deriving a pixel count from dimensions given as lengths
+    constexpr double PIXELS_PER_INCH        = 300.;
+
+    //! @brief size of natively rendered pages in pixels if no dimensions are set, as with gnuplot's svg terminal
+    constexpr int NATIVE_DEFAULT_WIDTH      = 640;
+    constexpr int NATIVE_DEFAULT_HEIGHT     = 480;
+
+    //! @brief size of natively rendered text pages in characters if no dimensions are set, as with gnuplot's dumb terminal
+    constexpr int NATIVE_DEFAULT_COLUMNS    = 79;
+    constexpr int NATIVE_DEFAULT_ROWS       = 24;
+
+    //! @brief initial value of fingerprints computed with hashBytes
+    constexpr uint64_t HASH_SEED            = 0xcbf29ce484222325ull;
+
+    /**
+     * @brief column precision requesting the shortest representation that reads back to the same double
+     */
+    constexpr int COLUMN_PRECISION_SHORTEST = -1;
+
     // ====================================================================== //
 
     constexpr size_t BORDERS_NONE = 0u;
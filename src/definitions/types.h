@@ -1,12 +1,17 @@
 #ifndef TYPES_H
 #define TYPES_H
 
+#include <array>
+#include <chrono>
 #include <cmath>
+#include <cstddef>
 #include <functional>
 #include <limits>
 #include <optional>
 #include <span>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "constants.h"
 
@@ -44,6 +49,32 @@ namespace Plotypus
     template <typename T>
     using DataSelector_t = std::function<double (const T&)>;
 
+    /**
+     * @brief pointer to a double member of T, if T is a class type
+     *  (std::nullptr_t otherwise, so that it can be named for any T)
+     */
+    template <typename T, bool = std::is_class_v<T>>
+    struct DataMember
+    {
+        using type = std::nullptr_t;
+    };
+
+    template <typename T>
+    struct DataMember<T, true>
+    {
+        using type = double T::*;
+    };
+
+    template <typename T>
+    using DataMember_t = typename DataMember<T>::type;
+
+    /**
+     * @brief compile time data selector: a callable object or pointer to member
+     *  that extracts a quantity convertible to double from an object of type T
+     */
+    template <typename S, typename T>
+    concept StaticDataSelector = std::is_invocable_r_v<double, S, const T&>;
+
     // ---------------------------------------------------------------------- //
 
     template <typename T>
@@ -51,6 +82,124 @@ namespace Plotypus
     using columnViewList_t          = std::array<std::span<double>, 6>;
     using columnAssignmentList_t    = std::array<size_t, 6>;
     using columnFormatList_t        = std::array<std::string, 6>;
+    using columnDataTypeList_t      = std::array<ColumnDataType, 6>;
+    using columnPrecisionList_t     = std::array<int, 6>;
+
+    //! @brief receives consecutive pieces of a data file while it is being generated
+    using dataSink_t                = std::function<void (const char* data, size_t size)>;
+    //! @brief receives consecutive records of a DataView, each holding the values of its six plot columns
+    using recordVisitor_t           = std::function<void (std::span<const std::array<double, 6>> records)>;
+
+    /**
+     * @brief resolved layout of one output line of a DataView.
+     *
+     * Derived once per write from the column assignments, so that the fetch
+     * kernels do not need to reinterpret them for every record. The column
+     * at position `sources[i]` (zero based) ends up at position `targets[i]`
+     * of a line with `lineLength` entries.
+     */
+    struct ColumnPlan
+    {
+        size_t              lineLength = 0u;
+        std::vector<size_t> sources;
+        std::vector<size_t> targets;
+    };
+
+    /**
+     * @brief byte layout of records that can be written to a data file unchanged
+     *
+     * `offsets[i]` is the position of the double backing the source column `i`
+     * (zero based) within each record of `recordSize` bytes; only the entries
+     * of columns used in the ColumnPlan are meaningful.
+     */
+    struct RawRecordLayout
+    {
+        std::span<const std::byte>  bytes;
+        size_t                      recordSize = 0u;
+        std::array<size_t, 6>       offsets    = {};
+    };
+
+    //! @brief position of the records of a DataView in the data archive of a Report, see DataTransport::Archive
+    struct ArchiveSlice
+    {
+        size_t  offset      = 0u;       //!< in bytes from the start of the archive
+        size_t  recordCount = 0u;
+    };
+
+    /**
+     * @brief summary of the values of one data column, see DataView2D::getStatistics
+     *
+     * `min` and `max` cover the finite values only and are +inf/-inf if there are none. `ascending`
+     * tells whether no value is smaller than its predecessor; pairs involving NaN are not compared.
+     */
+    struct ColumnStatistics
+    {
+        double  min         =  std::numeric_limits<double>::infinity();
+        double  max         = -std::numeric_limits<double>::infinity();
+        size_t  count       = 0u;       //!< of finite values
+        size_t  nanCount    = 0u;
+        size_t  infCount    = 0u;
+        bool    ascending   = true;
+    };
+
+    /**
+     * @brief lists the outputs that the last export of a Report wrote and skipped
+     *
+     * see Report::setSkipUnchangedOutput and Report::setDeduplicateData
+     */
+    struct ExportSummary
+    {
+        std::vector<std::string>    writtenDataFiles;           //!< only DataViews with a data file of their own are listed, i.e. neither functions nor dummies
+        std::vector<std::string>    skippedDataFiles;
+        size_t                      sharedDataViews = 0u;       //!< DataViews that use the data file of an identical view instead of writing their own
+        std::vector<size_t>         unchangedSheets;            //!< page numbers (one based) whose script fragment is unchanged; informative only, as the script is written as a whole
+        bool                        skippedScript = false;      //!< script file and gnuplot run were skipped altogether
+    };
+
+    /**
+     * @brief limits applied to a gnuplot run started by runGnuplotAsync
+     *
+     * A zero value means no limit. When the timeout or a resource limit is hit, gnuplot and any
+     * helper processes it started are killed.
+     */
+    struct GnuplotLaunchOptions
+    {
+        std::string                     executable      = "gnuplot";
+        std::chrono::duration<double>   timeout         = std::chrono::duration<double>::zero();   //!< wall time
+        size_t                          cpuTimeLimit    = 0u;           //!< in seconds (RLIMIT_CPU)
+        size_t                          memoryLimit     = 0u;           //!< in bytes, of virtual memory (RLIMIT_AS)
+        bool                            captureOutput   = false;        //!< collect stdout in GnuplotResult::output instead of sharing it
+    };
+
+    //! @brief outcome of a gnuplot run started by runGnuplotAsync
+    struct GnuplotResult
+    {
+        int                             exitCode        = 0;            //!< -1 if gnuplot was terminated by a signal
+        int                             signal          = 0;            //!< the terminating signal, if any
+        bool                            timedOut        = false;
+        std::string                     errorOutput;                    //!< everything gnuplot wrote to stderr
+        std::string                     output;                         //!< everything gnuplot wrote to stdout, if captured
+        std::chrono::duration<double>   wallTime        = std::chrono::duration<double>::zero();
+    };
+
+    //! @brief a script passed to a RecordingRenderer
+    struct RenderRecord
+    {
+        std::string                     scriptFilename;
+        size_t                          scriptSize      = 0u;           //!< in bytes; zero if the file could not be read
+        std::chrono::duration<double>   time            = std::chrono::duration<double>::zero();   //!< since the first recorded script
+    };
+
+    //! @brief progress and throughput of a RenderFarm
+    struct RenderFarmStatistics
+    {
+        size_t                                              renderedScripts = 0u;
+        std::vector<std::pair<std::string, GnuplotResult>>  failedScripts;                  //!< with the result of rendering them alone
+        size_t                                              gnuplotRuns     = 0u;           //!< including the reruns of failed batches
+        std::chrono::duration<double>                       busyTime        = std::chrono::duration<double>::zero();    //!< summed wall time of all runs
+        std::chrono::duration<double>                       elapsedTime     = std::chrono::duration<double>::zero();    //!< since the first submission
+        double                                              throughput      = 0.;           //!< finished scripts per second of elapsed time
+    };
 
     // ---------------------------------------------------------------------- //
 
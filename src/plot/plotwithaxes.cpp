@@ -1,3 +1,5 @@
+#include <charconv>
+
 #include "plotwithaxes.h"
 
 namespace Plotypus
@@ -5,11 +7,19 @@ namespace Plotypus
 
     std::string PlotWithAxes::generateRangeString(double min, double max)
     {
-        return "[" +
-               (std::isnan(min) ? "*" : std::to_string(min)) +
-               ":" +
-               (std::isnan(max) ? "*" : std::to_string(max)) +
-               "] ";
+        // shortest representation that reads back exactly, so that concrete ranges do not cut off data
+        const auto formatLimit = [] (const double limit)
+        {
+            // *INDENT-OFF*
+            if (std::isnan(limit)) {return std::string("*");}
+            // *INDENT-ON*
+
+            char buffer[32];
+            const auto result = std::to_chars(buffer, buffer + sizeof(buffer), limit);
+            return std::string(buffer, result.ptr);
+        };
+
+        return "[" + formatLimit(min) + ":" + formatLimit(max) + "] ";
     }
 
     std::string PlotWithAxes::generateTicsSequence(double min, double increment, double max, double rangeMin, double rangeMax)
@@ -105,6 +115,71 @@ namespace Plotypus
         hFile << "set " << axisCommand << " " << rangeString << axis.rangeOptions.value_or("") << std::endl;
     }
 
+    std::optional<std::pair<double, double>> PlotWithAxes::getDataRange(const ColumnType columnType) const
+    {
+        double min =  std::numeric_limits<double>::infinity();
+        double max = -std::numeric_limits<double>::infinity();
+
+        for (const auto dataView : dataViews)
+        {
+            const auto dataView2D = dynamic_cast<const DataView2D*>(dataView);
+
+            // *INDENT-OFF*
+            if (!dataView2D || dataView2D->isFunction()) {return std::nullopt;}
+            if (dataView2D->isDummy())                   {continue;}
+            // *INDENT-ON*
+
+            switch (dataView2D->getStyleID())
+            {
+                case PlotStyle2D::Dots:
+                case PlotStyle2D::Points:
+                case PlotStyle2D::Lines:
+                case PlotStyle2D::LinesPoints:
+                case PlotStyle2D::Steps:
+                case PlotStyle2D::FSteps:
+                    break;
+
+                default:
+                    return std::nullopt;
+            }
+
+            const auto statistics = dataView2D->getStatistics(columnType);
+            min = std::min(min, statistics.min);
+            max = std::max(max, statistics.max);
+        }
+
+        // *INDENT-OFF*
+        if (!(max > min)) {return std::nullopt;}
+        // *INDENT-ON*
+
+        return std::make_pair(min, max);
+    }
+
+    AxisDescriptor PlotWithAxes::resolveAutoRange(const AxisDescriptor& axis) const
+    {
+        const bool isAutoRange = std::isnan(axis.rangeMin) || std::isnan(axis.rangeMax);
+
+        // *INDENT-OFF*
+        if (polar || !isAutoRange)                                  {return axis;}
+        if (axis.type != AxisType::X && axis.type != AxisType::Y)   {return axis;}
+        // *INDENT-ON*
+
+        const auto dataRange = getDataRange(axis.type == AxisType::X ? ColumnType::X : ColumnType::Y);
+
+        // *INDENT-OFF*
+        if (!dataRange) {return axis;}
+        // *INDENT-ON*
+
+        AxisDescriptor result = axis;
+        // *INDENT-OFF*
+        if (std::isnan(result.rangeMin)) {result.rangeMin = dataRange->first;}
+        if (std::isnan(result.rangeMax)) {result.rangeMax = dataRange->second;}
+        if (!(result.rangeMax > result.rangeMin)) {return axis;}
+        // *INDENT-ON*
+
+        return result;
+    }
+
     void PlotWithAxes::writeAxisTics(std::ostream& hFile, const std::string& axisName, const AxisDescriptor& axis)
     {
         const std::string axisCommand  = axisName + "tics ";
@@ -160,6 +235,7 @@ namespace Plotypus
 
         axes.clear();
         polar = false;
+        concreteAutoRanges = false;
     }
 
     // ====================================================================== //
@@ -233,6 +309,16 @@ namespace Plotypus
         }
     }
 
+    bool PlotWithAxes::getConcreteAutoRanges() const
+    {
+        return concreteAutoRanges;
+    }
+
+    void PlotWithAxes::setConcreteAutoRanges(bool newConcreteAutoRanges)
+    {
+        concreteAutoRanges = newConcreteAutoRanges;
+    }
+
     // ====================================================================== //
     // writers
 
@@ -246,6 +332,12 @@ namespace Plotypus
                 dataView->setDataFilename(fullOutputFilename);
             }
             ++i;
+
+            // the data may have changed in client memory since the last export
+            const auto dataView2D = dynamic_cast<const DataView2D*>(dataView);
+            // *INDENT-OFF*
+            if (dataView2D) {dataView2D->invalidateStatistics();}
+            // *INDENT-ON*
         }
     }
 
@@ -259,10 +351,54 @@ namespace Plotypus
         }
     }
 
+    void PlotWithAxes::applyAutoDecimation(size_t pixels) const
+    {
+        const auto   x        = axes.find(AxisType::X);
+        const double rangeMin = (x != axes.end() ? x->second.rangeMin : AXIS_AUTO_RANGE);
+        const double rangeMax = (x != axes.end() ? x->second.rangeMax : AXIS_AUTO_RANGE);
+
+        // *INDENT-OFF*
+        if (polar) {pixels = 0u;}
+        // *INDENT-ON*
+
+        for (const auto dataView : dataViews)
+        {
+            const auto dataView2D = dynamic_cast<const DataView2D*>(dataView);
+
+            // *INDENT-OFF*
+            if (!dataView2D) {continue;}
+            // *INDENT-ON*
+
+            dataView2D->setAutoDecimation(pixels, rangeMin, rangeMax);
+        }
+    }
+
+    void PlotWithAxes::applyAutoCulling(bool enabled) const
+    {
+        const auto x = axes.find(AxisType::X);
+        const bool cull = enabled && !polar && (x != axes.end());
+
+        for (const auto dataView : dataViews)
+        {
+            const auto dataView2D = dynamic_cast<const DataView2D*>(dataView);
+
+            // *INDENT-OFF*
+            if (!dataView2D) {continue;}
+            // *INDENT-ON*
+
+            dataView2D->setAutoCullingRange(cull ? x->second.rangeMin : AXIS_AUTO_RANGE, cull ? x->second.rangeMax : AXIS_AUTO_RANGE);
+        }
+    }
+
+    std::vector<const DataView*> PlotWithAxes::getDatDataViews() const
+    {
+        return std::vector<const DataView*>(dataViews.begin(), dataViews.end());
+    }
+
     void PlotWithAxes::writeDatData() const
     {
         Plot::writeDatData();
-        for (const auto dataView : dataViews)
+        for (const auto dataView : getDatDataViews())
         {
             dataView->writeDatData();
         }
@@ -277,7 +413,7 @@ namespace Plotypus
 
         for (const auto& [axisID, axisDescriptor] : axes)
         {
-            writeAxisDescriptor(hFile, axisDescriptor);
+            writeAxisDescriptor(hFile, concreteAutoRanges ? resolveAutoRange(axisDescriptor) : axisDescriptor);
         }
 
         hFile << std::endl;
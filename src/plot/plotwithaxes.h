@@ -6,6 +6,7 @@
 #include <unordered_map>
 
 #include "../dataview/dataview2dcompound.h"
+#include "../dataview/dataview2dcompoundstatic.h"
 
 #include "plot.h"
 
@@ -21,6 +22,7 @@ namespace Plotypus
             std::unordered_map<AxisType, AxisDescriptor> axes;
 
             bool polar = false;
+            bool concreteAutoRanges = false;
 
             static std::string generateRangeString (double min,                   double max);
             static std::string generateTicsSequence(double min, double increment, double max, double rangeMin, double rangeMax);
@@ -30,6 +32,10 @@ namespace Plotypus
             static void writeAxisRange(std::ostream& hFile, const std::string& axisName, const AxisDescriptor& axis);
             static void writeAxisTics (std::ostream& hFile, const std::string& axisName, const AxisDescriptor& axis);
 
+            //! @brief returns the range of the finite values in `columnType` over all data views, or std::nullopt if it does not determine the extent of the plot.
+            std::optional<std::pair<double, double>> getDataRange(const ColumnType columnType) const;
+            AxisDescriptor                           resolveAutoRange(const AxisDescriptor& axis) const;
+
         public:
             PlotWithAxes(const std::string& title);
             ~PlotWithAxes();
@@ -49,6 +55,18 @@ namespace Plotypus
             bool                    getPolar() const;
             void                    setPolar(bool newPolar);
 
+            /**
+             * @brief requests writing the X and Y ranges left to AXIS_AUTO_RANGE as the concrete limits of the data.
+             *
+             * The limits are taken from DataView2D::getStatistics, which spares gnuplot scanning the data once
+             * more. Like gnuplot's `set autoscale fix`, the ranges end at the data rather than at the next tic.
+             * An axis stays autoscaled if any data view does not have its extent given by its X and Y columns
+             * alone, i.e. functions and styles other than Dots, Points, Lines, LinesPoints, Steps and FSteps,
+             * as well as in polar mode.
+             */
+            bool                    getConcreteAutoRanges() const;
+            void                    setConcreteAutoRanges(bool newConcreteAutoRanges);
+
             template<class T>
             DataView2DCompound<T>&  addDataViewCompound(DataView2DCompound<T>* dataView);
             template<class T>
@@ -60,6 +78,13 @@ namespace Plotypus
             template<class T>
             DataView2DCompound<T>&  addDataViewCompound(const std::string& func, const PlotStyle2D style = PlotStyle2D::Lines, const std::string& label = "");
 
+            template<class T, auto... Selectors>
+            DataView2DCompoundStatic<T, Selectors...>&            addDataViewCompound(DataView2DCompoundStatic<T, Selectors...>* dataView);
+            template<class T, auto Selector, auto... Selectors>
+            DataView2DCompoundStatic<T, Selector, Selectors...>&  addDataViewCompound(const std::span<T>& data, const PlotStyle2D style = PlotStyle2D::Lines, const std::string& label = "");
+            template<class T, auto Selector, auto... Selectors>
+            DataView2DCompoundStatic<T, Selector, Selectors...>&  addDataViewCompound(T* data, const size_t N, const PlotStyle2D style = PlotStyle2D::Lines, const std::string& label = "");
+
             // -------------------------------------------------------------- //
             // writers
 
@@ -67,6 +92,20 @@ namespace Plotypus
 
             virtual void writeTxtData       (std::ostream& hFile) const;
 
+            /**
+             * @brief decimates all line-like DataView2D instances in the next exports to a width of `pixels`
+             *  columns spread over the current range of the X axis, or not at all if `pixels` is zero (see
+             *  DataView2D::setAutoDecimation). There is no decimation in polar mode.
+             */
+            void applyAutoDecimation(size_t pixels) const;
+            /**
+             * @brief restricts the records written by all DataView2D instances in the next exports to the current
+             *  range of the X axis, or lifts that restriction if `enabled` is false (see
+             *  DataView2D::setAutoCullingRange). There is no restriction in polar mode or without an X axis.
+             */
+            void applyAutoCulling(bool enabled) const;
+
+            virtual std::vector<const DataView*> getDatDataViews() const;
             virtual void writeDatData() const;
 
             virtual void writeScriptHead    (std::ostream& hFile) const;
@@ -48,6 +48,35 @@ namespace Plotypus
 
         return addDataViewCompound(dataView);
     }
+
+    // ---------------------------------------------------------------------- //
+
+    template<class T, auto... Selectors>
+    DataView2DCompoundStatic<T, Selectors...>& PlotWithAxes::addDataViewCompound(DataView2DCompoundStatic<T, Selectors...>* dataView)
+    {
+        dataViews.push_back(dataView);
+        return *dataView;
+    }
+
+    template<class T, auto Selector, auto... Selectors>
+    DataView2DCompoundStatic<T, Selector, Selectors...>& PlotWithAxes::addDataViewCompound(const std::span<T>& data, const PlotStyle2D style, const std::string& label)
+    {
+        auto* dataView = new DataView2DCompoundStatic<T, Selector, Selectors...>(style, label);
+
+        dataView->setData(data);
+
+        return addDataViewCompound(dataView);
+    }
+
+    template<class T, auto Selector, auto... Selectors>
+    DataView2DCompoundStatic<T, Selector, Selectors...>& PlotWithAxes::addDataViewCompound(T* data, const size_t N, const PlotStyle2D style, const std::string& label)
+    {
+        auto* dataView = new DataView2DCompoundStatic<T, Selector, Selectors...>(style, label);
+
+        dataView->setData(data, N);
+
+        return addDataViewCompound(dataView);
+    }
 }
 
 #endif // PLOT_WITH_AXES_TXX
@@ -20,6 +20,10 @@
 #include "definitions/constants.h"
 
 #include "base/util.h"
+#include "base/gnuplotprocess.h"
+#include "base/renderfarm.h"
+#include "base/renderer.h"
+#include "base/pdfmerger.h"
 #include "base/report.h"
 #include "base/sheet.h"
 #include "base/stylescollection.h"
@@ -27,10 +31,20 @@
 #include "dataview/dataview.h"
 #include "dataview/dataview2d.h"
 #include "dataview/dataview2dcompound.h"
+#include "dataview/dataview2dcompoundstatic.h"
 #include "dataview/dataview2dseparate.h"
 
 #include "plot/plot.h"
 #include "plot/plotwithaxes.h"
 #include "plot/plotradial.h"
 
+#include "render/color.h"
+#include "render/canvas.h"
+#include "render/svgcanvas.h"
+#include "render/font.h"
+#include "render/rastercanvas.h"
+#include "render/pngencoder.h"
+#include "render/textcanvas.h"
+#include "render/plotpainter.h"
+
 #endif // PLOTYPUS_H
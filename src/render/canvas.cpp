@@ -0,0 +1,81 @@
+#include <array>
+#include <cmath>
+#include <numbers>
+
+#include "canvas.h"
+
+namespace Plotypus
+{
+    void Canvas::rectangle(double x, double y, double width, double height, const std::optional<Color>& fill, const std::optional<Stroke>& stroke)
+    {
+        const std::array<CanvasPoint, 4> corners = {{{x, y}, {x + width, y}, {x + width, y + height}, {x, y + height}}};
+        polygon(corners, fill, stroke);
+    }
+
+    void Canvas::marker(const CanvasPoint& center, PointForm form, double size, const Stroke& stroke)
+    {
+        const auto [x, y] = center;
+        const double s    = size;
+
+        const auto regular = [&] (size_t corners, double startAngle, bool filled)
+        {
+            std::vector<CanvasPoint> points;
+            for (size_t i = 0u; i < corners; ++i)
+            {
+                const double angle = startAngle + 2. * std::numbers::pi * i / corners;
+                points.push_back({x + s * std::cos(angle), y - s * std::sin(angle)});
+            }
+            polygon(points, (filled ? std::optional<Color>(stroke.color) : std::nullopt), stroke);
+        };
+
+        const auto segment = [&] (double x0, double y0, double x1, double y1)
+        {
+            beginPath(stroke);
+            moveTo({x0, y0});
+            lineTo({x1, y1});
+            endPath();
+        };
+
+        switch (form)
+        {
+            // *INDENT-OFF*
+            case PointForm::Point:              rectangle(x - .5, y - .5, 1., 1., stroke.color, std::nullopt); break;
+            case PointForm::Plus:               segment(x - s, y, x + s, y); segment(x, y - s, x, y + s); break;
+            case PointForm::Cross:              segment(x - s, y - s, x + s, y + s); segment(x - s, y + s, x + s, y - s); break;
+            case PointForm::Asterisk:           segment(x - s, y, x + s, y); segment(x, y - s, x, y + s);
+                                                segment(x - s, y - s, x + s, y + s); segment(x - s, y + s, x + s, y - s); break;
+            case PointForm::Box:                rectangle(x - s, y - s, 2. * s, 2. * s, std::nullopt, stroke); break;
+            case PointForm::FilledBox:          rectangle(x - s, y - s, 2. * s, 2. * s, stroke.color, stroke); break;
+            case PointForm::Circle:             regular(24u, 0., false); break;
+            case PointForm::FilledCircle:       regular(24u, 0., true); break;
+            case PointForm::TriangleUp:         regular(3u,  std::numbers::pi / 2., false); break;
+            case PointForm::FilledTriangleUp:   regular(3u,  std::numbers::pi / 2., true); break;
+            case PointForm::TriangleDown:       regular(3u, -std::numbers::pi / 2., false); break;
+            case PointForm::FilledTriangleDown: regular(3u, -std::numbers::pi / 2., true); break;
+            case PointForm::Diamond:            regular(4u,  0., false); break;
+            case PointForm::FilledDiamond:      regular(4u,  0., true); break;
+            case PointForm::Pentagon:           regular(5u,  std::numbers::pi / 2., false); break;
+            case PointForm::FilledPentagon:     regular(5u,  std::numbers::pi / 2., true); break;
+            case PointForm::None:               break;
+            case PointForm::Custom:             break;
+            // *INDENT-ON*
+        }
+    }
+
+    double Canvas::getTextWidth(const std::string& text, const TextStyle& style) const
+    {
+        // average advance of a proportional sans serif font; multibyte sequences count as one character
+        size_t characters = 0u;
+        for (const char c : text)
+        {
+            characters += ((static_cast<unsigned char>(c) & 0xc0) != 0x80);
+        }
+
+        return characters * style.size * (style.bold ? .6 : .55);
+    }
+
+    std::optional<double> Canvas::getFixedTextSize() const
+    {
+        return std::nullopt;
+    }
+}
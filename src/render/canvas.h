@@ -0,0 +1,84 @@
+#ifndef CANVAS_H
+#define CANVAS_H
+
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "../definitions/constants.h"
+
+#include "color.h"
+
+namespace Plotypus
+{
+    //! @brief a position on a Canvas, in pixels from the top left corner.
+    struct CanvasPoint
+    {
+        double x = 0.;
+        double y = 0.;
+    };
+
+    struct Stroke
+    {
+        Color               color;
+        double              width   = 1.;
+        std::vector<double> dashes;         //!< alternating lengths of dashes and gaps in pixels; empty for a solid line
+    };
+
+    enum class TextAnchor {Start, Middle, End};
+
+    struct TextStyle
+    {
+        std::string family  = "Arial";
+        double      size    = 10.;          //!< in pixels
+        bool        bold    = false;
+        Color       color;
+        TextAnchor  anchor  = TextAnchor::Start;
+        double      rotate  = 0.;           //!< counter-clockwise, in degrees
+    };
+
+    /**
+     * @brief drawing surface of the native renderers.
+     *
+     * Implementations provide the primitives: paths, polygons and single lines of text, in pixel
+     * coordinates with the y axis pointing down. Paths are streamed point by point, so that the
+     * DataViews need not be copied before drawing. Rectangles and point markers are composed of the
+     * primitives, but may be overridden where the output format has better means.
+     */
+    class Canvas
+    {
+        public:
+            virtual ~Canvas() = default;
+
+            virtual void beginPage(double width, double height, const Color& background) = 0;
+            virtual void endPage() = 0;
+
+            //! @brief restricts all drawing up to the matching endClip to the given rectangle.
+            virtual void beginClip(double x, double y, double width, double height) = 0;
+            virtual void endClip() = 0;
+
+            //! @brief starts an open polyline drawn with `stroke`; its vertices are given by moveTo and lineTo.
+            virtual void beginPath(const Stroke& stroke) = 0;
+            //! @brief starts a new piece of the current path at `point`, e.g. after undefined data.
+            virtual void moveTo(const CanvasPoint& point) = 0;
+            virtual void lineTo(const CanvasPoint& point) = 0;
+            virtual void endPath() = 0;
+
+            //! @brief draws the closed polygon through `points`, filled and outlined as far as given.
+            virtual void polygon(std::span<const CanvasPoint> points, const std::optional<Color>& fill, const std::optional<Stroke>& stroke) = 0;
+            //! @brief draws a single line of text with its baseline at `position`.
+            virtual void text(const CanvasPoint& position, const std::string& text, const TextStyle& style) = 0;
+
+            virtual void rectangle(double x, double y, double width, double height, const std::optional<Color>& fill, const std::optional<Stroke>& stroke);
+            //! @brief draws a point marker of the given form; `size` is half its width in pixels.
+            virtual void marker(const CanvasPoint& center, PointForm form, double size, const Stroke& stroke);
+
+            //! @brief returns the estimated width of `text` in pixels.
+            virtual double getTextWidth(const std::string& text, const TextStyle& style) const;
+            //! @brief returns the size of all text for canvases that cannot scale text, e.g. character cells; std::nullopt otherwise.
+            virtual std::optional<double> getFixedTextSize() const;
+    };
+}
+
+#endif // CANVAS_H
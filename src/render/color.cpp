@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <string_view>
+#include <utility>
+
+#include "color.h"
+
+namespace Plotypus
+{
+    namespace
+    {
+        // cf. gnuplot 5.4, `show colornames`
+        constexpr std::pair<std::string_view, uint32_t> COLOR_NAMES[] =
+        {
+            {"white",           0xffffff}, {"black",            0x000000}, {"dark-grey",        0xa0a0a0},
+            {"red",             0xff0000}, {"web-green",        0x00c000}, {"web-blue",         0x0080ff},
+            {"dark-magenta",    0xc000ff}, {"dark-cyan",        0x00eeee}, {"dark-orange",      0xc04000},
+            {"dark-yellow",     0xc8c800}, {"royalblue",        0x4169e1}, {"goldenrod",        0xffc020},
+            {"dark-spring-green", 0x008040}, {"purple",         0xc080ff}, {"steelblue",        0x306080},
+            {"dark-red",        0x8b0000}, {"dark-chartreuse",  0x408000}, {"orchid",           0xff80ff},
+            {"aquamarine",      0x7fffd4}, {"brown",            0xa52a2a}, {"yellow",           0xffff00},
+            {"turquoise",       0x40e0d0}, {"light-red",        0xf03232}, {"light-green",      0x90ee90},
+            {"light-blue",      0xadd8e6}, {"light-magenta",    0xf055f0}, {"light-cyan",       0xe0ffff},
+            {"light-goldenrod", 0xeedd82}, {"light-pink",       0xffb6c1}, {"light-turquoise",  0xafeeee},
+            {"gold",            0xffd700}, {"green",            0x00ff00}, {"dark-green",       0x006400},
+            {"spring-green",    0x00ff7f}, {"forest-green",     0x228b22}, {"sea-green",        0x2e8b57},
+            {"blue",            0x0000ff}, {"dark-blue",        0x00008b}, {"midnight-blue",    0x191970},
+            {"navy",            0x000080}, {"medium-blue",      0x0000cd}, {"skyblue",          0x87ceeb},
+            {"cyan",            0x00ffff}, {"magenta",          0xff00ff}, {"dark-turquoise",   0x00ced1},
+            {"dark-pink",       0xff1493}, {"coral",            0xff7f50}, {"light-coral",      0xf08080},
+            {"orange-red",      0xff4500}, {"salmon",           0xfa8072}, {"dark-salmon",      0xe9967a},
+            {"khaki",           0xf0e68c}, {"dark-khaki",       0xbdb76b}, {"dark-goldenrod",   0xb8860b},
+            {"beige",           0xf5f5dc}, {"olive",            0xa08020}, {"orange",           0xffa500},
+            {"violet",          0xee82ee}, {"dark-violet",      0x9400d3}, {"plum",             0xdda0dd},
+            {"dark-plum",       0x905040}, {"dark-olivegreen",  0x556b2f}, {"sienna1",          0xff8040},
+            {"pink",            0xffc0c0}, {"bisque",           0xcdb79e}, {"honeydew",         0xf0fff0},
+            {"slategrey",       0xa0b6cd}, {"slategray",        0xa0b6cd}, {"seagreen",         0xc1ffc1},
+            {"antiquewhite",    0xcdc0b0}, {"chartreuse",       0x7cff40}, {"greenyellow",      0xa0ff20},
+            {"gray",            0xbebebe}, {"grey",             0xbebebe}, {"light-gray",       0xd3d3d3},
+            {"light-grey",      0xd3d3d3}, {"dark-gray",        0xa0a0a0}, {"sandybrown",       0xffa060},
+            {"tan1",            0xffa040}
+        };
+
+        // cf. gnuplot 5.4, default linetypes 1 .. 8
+        constexpr std::array<uint32_t, 8> DEFAULT_LINE_COLORS =
+        {
+            0x9400d3, 0x009e73, 0x56b4e9, 0xe69f00, 0xf0e442, 0x0072b2, 0xe51e10, 0x000000
+        };
+
+        Color fromCode(uint32_t code)
+        {
+            // gnuplot codes transparency in the most significant byte
+            return
+            {
+                static_cast<uint8_t>((code >> 16) & 0xff),
+                static_cast<uint8_t>((code >>  8) & 0xff),
+                static_cast<uint8_t>( code        & 0xff),
+                static_cast<uint8_t>(255u - ((code >> 24) & 0xff))
+            };
+        }
+    }
+
+    std::optional<Color> parseColor(const std::string& specification)
+    {
+        std::string_view text = specification;
+
+        const auto trim = [&text] ()
+        {
+            // *INDENT-OFF*
+            while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {text.remove_prefix(1);}
+            while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back ()))) {text.remove_suffix(1);}
+            // *INDENT-ON*
+        };
+
+        trim();
+        // *INDENT-OFF*
+        if (text.starts_with("rgbcolor ")) {text.remove_prefix(9); trim();}
+        else if (text.starts_with("rgb ")) {text.remove_prefix(4); trim();}
+        if (text.size() >= 2u && (text.front() == '"' || text.front() == '\'') && text.back() == text.front()) {text = text.substr(1u, text.size() - 2u);}
+        // *INDENT-ON*
+
+        size_t digits = 0u;
+        // *INDENT-OFF*
+        if      (text.starts_with("#"))  {text.remove_prefix(1); digits = text.size();}
+        else if (text.starts_with("0x")) {text.remove_prefix(2); digits = text.size();}
+        // *INDENT-ON*
+
+        if (digits)
+        {
+            uint32_t   code   = 0u;
+            const auto result = std::from_chars(text.data(), text.data() + text.size(), code, 16);
+
+            // *INDENT-OFF*
+            if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {return std::nullopt;}
+            if (digits != 6u && digits != 8u)                                          {return std::nullopt;}
+            // *INDENT-ON*
+
+            return fromCode(code);
+        }
+
+        const auto entry = std::ranges::find(COLOR_NAMES, text, &std::pair<std::string_view, uint32_t>::first);
+        // *INDENT-OFF*
+        if (entry == std::ranges::end(COLOR_NAMES)) {return std::nullopt;}
+        // *INDENT-ON*
+
+        return fromCode(entry->second);
+    }
+
+    Color getDefaultLineColor(size_t i)
+    {
+        return fromCode(DEFAULT_LINE_COLORS[i % DEFAULT_LINE_COLORS.size()]);
+    }
+
+    std::string getColorHexString(const Color& color)
+    {
+        constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+        std::string result = "#";
+        for (const uint8_t channel : {color.r, color.g, color.b})
+        {
+            result += HEX_DIGITS[channel >> 4];
+            result += HEX_DIGITS[channel & 0xf];
+        }
+
+        return result;
+    }
+}
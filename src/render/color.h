@@ -0,0 +1,37 @@
+#ifndef COLOR_H
+#define COLOR_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace Plotypus
+{
+    //! @brief an sRGB colour as used by the native renderers; an alpha of 255 is opaque.
+    struct Color
+    {
+        uint8_t r = 0u;
+        uint8_t g = 0u;
+        uint8_t b = 0u;
+        uint8_t a = 255u;
+
+        bool operator== (const Color&) const = default;
+    };
+
+    /**
+     * @brief interprets a gnuplot colour specification.
+     *
+     * Understands `#rrggbb`, `#aarrggbb` and `0xaarrggbb` (where, as in gnuplot, `aa` is the transparency,
+     * i.e. 00 is opaque) as well as the names of gnuplot's predefined colours (`show colornames`), each
+     * optionally preceded by `rgb`. Returns std::nullopt for anything else.
+     */
+    std::optional<Color> parseColor(const std::string& specification);
+
+    //! @brief returns the colour of gnuplot's default linetype `i` (zero based); the eight colours repeat.
+    Color getDefaultLineColor(size_t i);
+
+    //! @brief returns the colour as `#rrggbb`, ignoring the alpha value.
+    std::string getColorHexString(const Color& color);
+}
+
+#endif // COLOR_H
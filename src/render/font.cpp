@@ -0,0 +1,216 @@
+#include "font.h"
+
+namespace Plotypus
+{
+    namespace
+    {
+        /* DejaVu Sans at 12 pixels, rendered with light hinting, for the code points 32 to 126;
+         * derived from the Bitstream Vera fonts (c) Bitstream, Inc., see https://dejavu-fonts.github.io/License.html
+         */
+        constexpr Glyph GLYPHS[] =
+        {
+            { 0,  0,  0,  0,  4,    0},   // ' '
+            { 1,  9,  2,  9,  5,    0},   // '!'
+            { 1,  9,  4,  4,  6,   18},   // '"'
+            { 0,  9, 10,  9, 10,   34},   // '#'
+            { 1, 10,  6, 12,  8,  124},   // '$'
+            { 0,  9, 11,  9, 11,  196},   // '%'
+            { 0,  9,  9,  9,  9,  295},   // '&'
+            { 1,  9,  2,  4,  3,  376},   // '\''
+            { 1, 10,  3, 11,  5,  384},   // '('
+            { 0, 10,  4, 11,  5,  417},   // ')'
+            { 0,  9,  6,  6,  6,  461},   // '*'
+            { 1,  8,  8,  8, 10,  497},   // '+'
+            { 0,  2,  3,  3,  4,  561},   // ','
+            { 0,  4,  4,  1,  4,  570},   // '-'
+            { 1,  2,  2,  2,  4,  574},   // '.'
+            { 0,  9,  5, 11,  4,  578},   // '/'
+            { 0,  9,  7,  9,  8,  633},   // '0'
+            { 1,  9,  6,  9,  8,  696},   // '1'
+            { 0,  9,  7,  9,  8,  750},   // '2'
+            { 0,  9,  7,  9,  8,  813},   // '3'
+            { 0,  9,  7,  9,  8,  876},   // '4'
+            { 0,  9,  7,  9,  8,  939},   // '5'
+            { 0,  9,  7,  9,  8, 1002},   // '6'
+            { 0,  9,  7,  9,  8, 1065},   // '7'
+            { 0,  9,  7,  9,  8, 1128},   // '8'
+            { 0,  9,  7,  9,  8, 1191},   // '9'
+            { 1,  7,  2,  7,  4, 1254},   // ':'
+            { 0,  7,  3,  8,  4, 1268},   // ';'
+            { 1,  8,  8,  8, 10, 1292},   // '<'
+            { 1,  5,  8,  4, 10, 1356},   // '='
+            { 1,  8,  8,  8, 10, 1388},   // '>'
+            { 0,  9,  6,  9,  6, 1452},   // '?'
+            { 0,  9, 12, 11, 12, 1506},   // '@'
+            { 0,  9,  9,  9,  8, 1638},   // 'A'
+            { 1,  9,  7,  9,  8, 1719},   // 'B'
+            { 0,  9,  8,  9,  8, 1782},   // 'C'
+            { 1,  9,  8,  9,  9, 1854},   // 'D'
+            { 1,  9,  6,  9,  8, 1926},   // 'E'
+            { 1,  9,  6,  9,  7, 1980},   // 'F'
+            { 0,  9,  9,  9,  9, 2034},   // 'G'
+            { 1,  9,  7,  9,  9, 2115},   // 'H'
+            { 1,  9,  2,  9,  4, 2178},   // 'I'
+            {-1,  9,  4, 12,  4, 2196},   // 'J'
+            { 1,  9,  8,  9,  8, 2244},   // 'K'
+            { 1,  9,  6,  9,  7, 2316},   // 'L'
+            { 1,  9,  9,  9, 10, 2370},   // 'M'
+            { 1,  9,  7,  9,  9, 2451},   // 'N'
+            { 0,  9,  9,  9,  9, 2514},   // 'O'
+            { 1,  9,  6,  9,  7, 2595},   // 'P'
+            { 0,  9,  9, 11,  9, 2649},   // 'Q'
+            { 1,  9,  7,  9,  8, 2748},   // 'R'
+            { 0,  9,  7,  9,  8, 2811},   // 'S'
+            {-1,  9,  9,  9,  7, 2874},   // 'T'
+            { 1,  9,  7,  9,  9, 2955},   // 'U'
+            { 0,  9,  9,  9,  8, 3018},   // 'V'
+            { 0,  9, 12,  9, 12, 3099},   // 'W'
+            { 0,  9,  8,  9,  8, 3207},   // 'X'
+            {-1,  9,  9,  9,  7, 3279},   // 'Y'
+            { 0,  9,  8,  9,  8, 3360},   // 'Z'
+            { 1, 10,  3, 11,  5, 3432},   // '['
+            { 0,  9,  5, 11,  4, 3465},   // '\\'
+            { 1, 10,  3, 11,  5, 3520},   // ']'
+            { 1, 10,  8,  4, 10, 3553},   // '^'
+            {-1, -2,  8,  1,  6, 3585},   // '_'
+            { 1, 11,  3,  3,  6, 3593},   // '`'
+            { 0,  7,  7,  7,  7, 3602},   // 'a'
+            { 1, 10,  6, 10,  8, 3651},   // 'b'
+            { 0,  7,  6,  7,  7, 3711},   // 'c'
+            { 0, 10,  7, 10,  8, 3753},   // 'd'
+            { 0,  7,  7,  7,  7, 3823},   // 'e'
+            { 0, 10,  5, 10,  4, 3872},   // 'f'
+            { 0,  7,  7, 10,  8, 3922},   // 'g'
+            { 1, 10,  6, 10,  8, 3992},   // 'h'
+            { 1, 10,  2, 10,  3, 4052},   // 'i'
+            {-1, 10,  4, 13,  3, 4072},   // 'j'
+            { 1, 10,  6, 10,  7, 4124},   // 'k'
+            { 1, 10,  2, 10,  3, 4184},   // 'l'
+            { 1,  7, 10,  7, 12, 4204},   // 'm'
+            { 1,  7,  6,  7,  8, 4274},   // 'n'
+            { 0,  7,  7,  7,  7, 4316},   // 'o'
+            { 1,  7,  6, 10,  8, 4365},   // 'p'
+            { 0,  7,  7, 10,  8, 4425},   // 'q'
+            { 1,  8,  4,  8,  5, 4495},   // 'r'
+            { 0,  7,  6,  7,  6, 4527},   // 's'
+            { 0,  9,  5,  9,  5, 4569},   // 't'
+            { 1,  7,  6,  7,  8, 4614},   // 'u'
+            { 0,  7,  7,  7,  7, 4656},   // 'v'
+            { 0,  7, 10,  7, 10, 4705},   // 'w'
+            { 0,  7,  7,  7,  7, 4775},   // 'x'
+            { 0,  7,  7, 10,  7, 4824},   // 'y'
+            { 0,  7,  6,  7,  6, 4894},   // 'z'
+            { 1, 10,  6, 12,  8, 4936},   // '{'
+            { 1, 10,  2, 13,  4, 5008},   // '|'
+            { 1, 10,  6, 12,  8, 5034},   // '}'
+            { 1,  6,  8,  4, 10, 5106},   // '~'
+        };
+
+        // one hexadecimal digit of coverage per pixel, row by row
+        constexpr char COVERAGE[] =
+            "3f3f3f3f2f2e02283fd295d295d29551420000c22c000000e059000003b0860006eefefee2000b32c0001eefeffe7000"
+            "590a400000860d100000b31d00000081000081003bedb1d58131e381007ed71002aae30081896081b79deea100810000"
+            "810008cb10059003c07801c1005904a0860002c0783b000006ca1b36ba10000682d0780001c14a03a0009502c069003b"
+            "0008cb2007eeb10002f30410002e10000000da000000a9aa00862f10b90c43e001cbc00d8005f9002adca4d8d2d2d251"
+            "0771e16a0b60d40e30d40b606a01e10770c3005a000e200b60089008a008900b600e205a00c3000550067557605cc501"
+            "9bb91425524003300000670000007800000078000aeeeeeeb1228922100078000000780000007800009a0b60d06ffb64"
+            "b8002d00069000a5000e1004b00087000d2002d00069000b40007100001aed6009b14e40e400992f1006c3f0005c2f10"
+            "06c0e4009909b13e401aee607cf90055a9000099000099000099000099000099000099008ffff809dec5019316f20000"
+            "0d500001f20000b90000aa0000aa0000ab10002fffff709dfd7004213e400001d6008efd100125800000097000009916"
+            "215e51befd600002eb0000bbb0005a7b001d27b008707b02d007b06eeeefd11118b100007b00bfffe00b600000b60000"
+            "0bddb4004327f300000b700000a815216f31beec50006dfd304e51320c600000f7de902fb12c81f5006c0e5006c08b12"
+            "c7009ee800fffff800001e400005d00000b700002f200007b00000d600004e100009900002bee800c912d60e40098079"
+            "12d403dff901e702c72f1006c0e701c903ceea102bed500d814e33f100a83f000ab0d803ec03bec9a00000b703117e10"
+            "8efb20559a000000559a09a05500000000009a0b60d000000001000016cb004aea506dc710008e940000017cd8200000"
+            "39ea00000003aeeeeeeb11111111aeeeeeeb1222222110000000bc61000005aea40000016cd7000049e9028dc7109e93"
+            "00003000000019ee902712d60000c60007c1005d1000a70000640000640000b7000003addb6000007c41029b1005b000"
+            "0007800c207db870d01b04c11c80b23a06800780c01b04c11c87900c107dc8c70005b000000000008b3004d3000004ad"
+            "db4000000be0000002fe5000007c8b00000d63f10004f10d70009b007c001eeeeef305e2111b80b800005e0cffeb30c6"
+            "019c0c5003f0c5019b0cfffe30c5005e2c5000e5c6015f3cfffd60005ceeb306e621591e6000004f1000005e0000004f"
+            "1000001e60000006e61159005ceeb3cffec600c6025da0c50003f3c50000d7c50000b8c50000d7c50003f3c6025da0cf"
+            "fec700cffffbc60000c50000c50000ceeee7c62221c50000c60000cffffccffff3c60000c50000c50000ceeeb0c62210"
+            "c50000c50000c50000005ceec6006e6214a11e60000004f10000005e000bee44f10011d51e60000d506e6213e5005cef"
+            "c60c50005dc50005dc50005dc50005dceeeeedc62226dc50005dc50005dc50005dc5c5c5c5c5c5c5c5c500c500c500c5"
+            "00c500c500c500c500c500c500d404f19d60c5004e50c504e400c55e4000cae40000cec00000c6cb0000c51ca000c501"
+            "ca00c5001d90c50000c50000c50000c50000c50000c50000c50000c60000cffff9cf2000cf3cd7002df3c7d0088f3c5c"
+            "30d2f3c5694c0f3c51e960f3c50bf10f3c502300f3c500000f3ce1005cce8005cc7e105cc59905cc52e25cc50995cc50"
+            "2e7cc5009ecc5001ec005cfe91006e512bc00e60001e64f100009a5e000008b4f100009a1e60001e606e512bc0005cfe"
+            "910cffea1c602c9c5007cc501baceefb2c61000c50000c50000c50000005cfe91006e512bc00e60001e64f100009a5e0"
+            "00008b4f100009a1e60001e606e512bd1005cffc20000005e20000000550cffea10c602c90c5007c0c502ca0cfffc10c"
+            "503d30c5007b0c5001e4c50008b03beec40e711432f000000da4100029dfb200002bb000005e28202ba19dfea10fffff"
+            "ff50000e40000000e40000000e40000000e40000000e40000000e40000000e40000000e4000e40007be40007be40007b"
+            "e40007be40007be40007bc6000997d314e408dec50b800005e05d0000a801e4001f30099006c0004e10c70000d52f100"
+            "007b7b000002fd5000000be00007b000db000d53e001de001f20e3059b305d00b709687099008a0c24a0c6004e1e01e1"
+            "f2001f7a00c7d0000ce6009ea00008f3005f6001d5001d504e109a0009a4e10001ee600000be100005da90001e41e400"
+            "a9006d05e1000b80b90004e102e401d60006d08b00000bae2000002f70000000e40000000e40000000e40000000e4000"
+            "5ffffff8000005e200002e500001c800000ab000007d100004e300002e6000007ffffffafd7f20f20f20f20f20f20f20"
+            "f20f20dd7d2000970004b0000e1000a5000690002d0000c3000870004b000070bea07a07a07a07a07a07a07a07a07aad"
+            "900066000007dd80006d22d604d2001c52dddddd26204c007708dec4005106e100000d306cddf42e300d43d005f408db"
+            "8c4e30000e30000e30000e7de90ec11c7e5005de3003ee5005dec11c7e7de9002aee90c91043e00005c00003e00000c9"
+            "10402aee900000880000088000008802ceb980d704f83e000b85c000983d000a80d502e803cca9801aed700c802d43e0"
+            "00695fdddda3e000000c8102301aeec402ce6088000a6009eed20a6000a6000a6000a6000a6000a60003ceb980d704e8"
+            "3e000a85c000983e000a80d704e803ceb9800000a604104e206eec50e30000e30000e30000e6de90eb11d5e40088e300"
+            "79e30079e30079e30079d36100d3d3d3d3d3d3d300d30061000000d300d300d300d300d300d300d300d301e13e80e300"
+            "00e30000e30000e303d4e34d30e7d300ee9000e4d700e31d70e302d7d3d3d3d3d3d3d3d3d3d3e6de82beb1eb12ec31c7"
+            "e400a80079e300a6006ae300a6006ae300a6006ae300a6006ae7cd90ea00c5e40088e30079e30079e30079e3007902be"
+            "d500d804e33e000985c0007a3e000980d703e302bed50e7cd90eb00b7e4004de3003ee5005dec11c7e7de90e30000e30"
+            "000e3000002ceb980d704f83e000a85c000983e000a80d704f803ceb980000088000008800000880000e7cdeb00e400e"
+            "300e300e300e30008eed33d10223e400006cea10001b93300a83ceea10d3000d3009fed60d3000d3000d3000d3000c50"
+            "005de6f10088f10088f10088f10088e200a8b602e83ccaa87a000992e100e30c604d006b098001f2e2000bbc00005f70"
+            "06b00da00d32e01dd02e00d359c26a00a7958697006ac24ad3002ed01ee0000e900cb002e302e406d1b8000acc00005f"
+            "60001d9d1009a09a05d101d57a000981e100e30b604d005b0a7000e3e20009cb00004f600002e10000890001ed20005e"
+            "eeec0001d6000a90007c0005e2002e40007fddda003cd200980000a60000a60001d4007fb00001e30000b60000a60000"
+            "a600009900002bd2787878787878787878787878447da00000d40000c50000b50000a800002ee200990000b50000c500"
+            "00c50001e3007d9000000000002ada40289526ded500000100";
+
+        constexpr char32_t FIRST_CODE_POINT = 32;
+        constexpr char32_t LAST_CODE_POINT  = 126;
+
+        constexpr char32_t REPLACEMENT_CHARACTER = 0xfffd;
+    }
+
+    const Glyph& getGlyph(char32_t c)
+    {
+        // *INDENT-OFF*
+        if (c < FIRST_CODE_POINT || c > LAST_CODE_POINT) {c = '?';}
+        // *INDENT-ON*
+
+        return GLYPHS[c - FIRST_CODE_POINT];
+    }
+
+    double getGlyphCoverage(const Glyph& glyph, int x, int y)
+    {
+        // *INDENT-OFF*
+        if (x < 0 || y < 0 || x >= glyph.width || y >= glyph.height) {return 0.;}
+        // *INDENT-ON*
+
+        const char digit = COVERAGE[glyph.offset + y * glyph.width + x];
+        return (digit <= '9' ? digit - '0' : digit - 'a' + 10) / 15.;
+    }
+
+    char32_t decodeUtf8(const std::string& text, size_t& position)
+    {
+        const auto lead = static_cast<unsigned char>(text[position++]);
+
+        size_t   length = 0u;
+        char32_t result = lead;
+
+        // *INDENT-OFF*
+        if      (lead < 0x80u)              {return lead;}
+        else if ((lead & 0xe0u) == 0xc0u)   {length = 1u; result = lead & 0x1fu;}
+        else if ((lead & 0xf0u) == 0xe0u)   {length = 2u; result = lead & 0x0fu;}
+        else if ((lead & 0xf8u) == 0xf0u)   {length = 3u; result = lead & 0x07u;}
+        else                                {return REPLACEMENT_CHARACTER;}
+        // *INDENT-ON*
+
+        for (size_t i = 0u; i < length; ++i)
+        {
+            // *INDENT-OFF*
+            if (position >= text.size() || (static_cast<unsigned char>(text[position]) & 0xc0u) != 0x80u) {return REPLACEMENT_CHARACTER;}
+            // *INDENT-ON*
+            result = (result << 6) | (static_cast<unsigned char>(text[position++]) & 0x3fu);
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef FONT_H
+#define FONT_H
+
+#include <cstdint>
+#include <string>
+
+namespace Plotypus
+{
+    //! @brief a glyph of the built-in font; all measures in pixels at FONT_PIXEL_SIZE
+    struct Glyph
+    {
+        int8_t      left;           //!< from the pen position to the left edge of the bitmap
+        int8_t      top;            //!< from the baseline up to the top edge of the bitmap
+        uint8_t     width;
+        uint8_t     height;
+        uint8_t     advance;
+        uint16_t    offset;         //!< of the first pixel in the coverage table
+    };
+
+    //! @brief the size in pixels (em height) at which the built-in font is stored
+    constexpr double FONT_PIXEL_SIZE = 12.;
+
+    /**
+     * @brief returns the glyph of the built-in font for the code point `c`.
+     *
+     * The font covers printable ASCII; other code points are shown as '?'.
+     */
+    const Glyph& getGlyph(char32_t c);
+
+    //! @brief returns the coverage of pixel (`x`, `y`) of the bitmap of `glyph`, between 0 and 1; zero outside the bitmap.
+    double getGlyphCoverage(const Glyph& glyph, int x, int y);
+
+    //! @brief decodes the next code point of the UTF-8 `text` at `position`, and advances `position` past it.
+    char32_t decodeUtf8(const std::string& text, size_t& position);
+}
+
+#endif // FONT_H
@@ -0,0 +1,1380 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <numbers>
+#include <typeinfo>
+
+#include "../base/sheet.h"
+#include "../base/stylescollection.h"
+#include "../base/util.h"
+#include "../dataview/dataview2d.h"
+#include "../plot/plotwithaxes.h"
+
+#include "plotpainter.h"
+
+namespace Plotypus
+{
+    namespace
+    {
+        using record_t = std::array<double, 6>;
+
+        constexpr double POINT_SIZE_PIXELS  = 4.;       // half width of a marker at pointsize 1
+        constexpr double PIXEL_LIMIT        = 1e6;      // keeps far off data finite after mapping
+        constexpr size_t MAX_TICS           = 1000u;    // more sequence tics are replaced by automatic ones
+        constexpr double TICS_TOLERANCE     = 1e-9;     // relative to the tics increment
+
+        const Color BLACK = {0u, 0u, 0u, 255u};
+
+        // ------------------------------------------------------------------ //
+        // text
+
+        std::optional<double> parseNumber(const std::string& text)
+        {
+            double     value  = 0.;
+            const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+
+            // *INDENT-OFF*
+            if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {return std::nullopt;}
+            // *INDENT-ON*
+
+            return value;
+        }
+
+        /* "family,size" as in `set font`, or "family:bold*scale" as in enhanced text mode; an empty family or
+         * size keeps the one of `base`.
+         */
+        std::optional<TextStyle> parseFont(const std::string& specification, const TextStyle& base)
+        {
+            TextStyle   result = base;
+            std::string family = specification;
+
+            const auto comma = family.find(',');
+            if (comma != std::string::npos)
+            {
+                const std::string size = family.substr(comma + 1u);
+                family.resize(comma);
+
+                if (!size.empty())
+                {
+                    const auto value = parseNumber(size);
+                    // *INDENT-OFF*
+                    if (!value || value.value() <= 0.) {return std::nullopt;}
+                    // *INDENT-ON*
+                    result.size = value.value();
+                }
+            }
+
+            const auto star = family.find('*');
+            if (star != std::string::npos)
+            {
+                const auto scale = parseNumber(family.substr(star + 1u));
+                // *INDENT-OFF*
+                if (!scale || scale.value() <= 0.) {return std::nullopt;}
+                // *INDENT-ON*
+                result.size *= scale.value();
+                family.resize(star);
+            }
+
+            const auto colon = family.find(':');
+            if (colon != std::string::npos)
+            {
+                const std::string weight = family.substr(colon + 1u);
+                // *INDENT-OFF*
+                if      (weight == "bold")  {result.bold = true;}
+                else if (!weight.empty())   {return std::nullopt;}
+                // *INDENT-ON*
+                family.resize(colon);
+            }
+
+            // *INDENT-OFF*
+            if (!family.empty()) {result.family = family;}
+            // *INDENT-ON*
+
+            return result;
+        }
+
+        //! texts with control characters of gnuplot's enhanced text mode are left to gnuplot
+        bool hasEnhancedMarkup(const std::string& text)
+        {
+            return text.find_first_of("^_@&~{}\\") != std::string::npos;
+        }
+
+        std::string unquote(const std::string& text)
+        {
+            // *INDENT-OFF*
+            if (text.size() >= 2u && (text.front() == '"' || text.front() == '\'') && text.back() == text.front()) {return text.substr(1u, text.size() - 2u);}
+            // *INDENT-ON*
+            return text;
+        }
+
+        std::optional<Color> resolveColor(const std::string& specification, const Color& fallback)
+        {
+            // *INDENT-OFF*
+            if (specification.empty()) {return fallback;}
+            // *INDENT-ON*
+            return parseColor(specification);
+        }
+
+        std::optional<TextAnchor> resolveAlignment(const std::string& alignment)
+        {
+            // *INDENT-OFF*
+            if (alignment.empty() || alignment == "left")  {return TextAnchor::Start;}
+            if (alignment == "center" || alignment == "centre") {return TextAnchor::Middle;}
+            if (alignment == "right")                       {return TextAnchor::End;}
+            // *INDENT-ON*
+            return std::nullopt;
+        }
+
+        // ------------------------------------------------------------------ //
+        // styles
+
+        //! dash patterns as in gnuplot's `dashtype "<pattern>"`: '.', '-' and '_' are dashes of growing length, spaces widen the gaps
+        std::optional<std::vector<double>> resolveDashes(const std::string& dashtype, double width)
+        {
+            std::vector<double> result;
+            const double        scale = std::max(1., width);
+
+            for (const char c : dashtype)
+            {
+                switch (c)
+                {
+                    // *INDENT-OFF*
+                    case '.': result.push_back( 2. * scale); result.push_back(4. * scale); break;
+                    case '-': result.push_back( 6. * scale); result.push_back(4. * scale); break;
+                    case '_': result.push_back(10. * scale); result.push_back(4. * scale); break;
+                    case ' ': if (result.empty()) {return std::nullopt;}
+                              result.back() += 4. * scale; break;
+                    default : return std::nullopt;
+                    // *INDENT-ON*
+                }
+            }
+
+            return result;
+        }
+
+        struct ViewStyle
+        {
+            Stroke      stroke;
+            PointForm   form        = PointForm::Plus;
+            double      pointSize   = 1.;
+        };
+
+        //! gnuplot's defaults for the `i`<sup>th</sup> (zero based) element of the plot command
+        PointForm getDefaultPointForm(size_t i)
+        {
+            return static_cast<PointForm>(1u + i % 15u);
+        }
+
+        std::optional<ViewStyle> resolveViewStyle(const DataView2D& view, size_t i, const StylesCollection& stylesCollection)
+        {
+            ViewStyle result;
+            result.stroke.color = getDefaultLineColor(i);
+            result.form         = getDefaultPointForm(i);
+
+            const size_t lineStyleID = view.getLineStyle();
+            if (lineStyleID != STYLE_ID_DEFAULT)
+            {
+                // *INDENT-OFF*
+                if (lineStyleID >= stylesCollection.getLineStyleCount()) {return std::nullopt;}
+                // *INDENT-ON*
+
+                // properties not given by the line style are those of the linetype of the same number
+                const LineStyle& lineStyle = stylesCollection.getLineStyle(lineStyleID);
+                const auto       color     = resolveColor(lineStyle.color, getDefaultLineColor(lineStyleID));
+                // *INDENT-OFF*
+                if (!color || !lineStyle.options.empty()) {return std::nullopt;}
+                // *INDENT-ON*
+
+                result.stroke.color = color.value();
+                result.stroke.width = (lineStyle.width > 0. ? lineStyle.width : 1.);
+                result.form         = getDefaultPointForm(lineStyleID);
+
+                const auto dashes = resolveDashes(lineStyle.dashtype, result.stroke.width);
+                // *INDENT-OFF*
+                if (!dashes) {return std::nullopt;}
+                // *INDENT-ON*
+                result.stroke.dashes = dashes.value();
+
+                if (lineStyle.pointStyle.form != PointForm::None)
+                {
+                    result.form      = lineStyle.pointStyle.form;
+                    result.pointSize = lineStyle.pointStyle.size;
+                }
+            }
+
+            const size_t pointStyleID = view.getPointStyle();
+            if (pointStyleID != STYLE_ID_DEFAULT)
+            {
+                // *INDENT-OFF*
+                if (pointStyleID >= stylesCollection.getPointStyleCount()) {return std::nullopt;}
+                // *INDENT-ON*
+
+                // the linecolor of a point style applies to the whole plot element
+                const PointStyle& pointStyle = stylesCollection.getPointStyle(pointStyleID);
+                const auto        color      = resolveColor(pointStyle.color, result.stroke.color);
+                // *INDENT-OFF*
+                if (!color) {return std::nullopt;}
+                // *INDENT-ON*
+
+                result.stroke.color = color.value();
+                if (pointStyle.form != PointForm::None)
+                {
+                    result.form      = pointStyle.form;
+                    result.pointSize = pointStyle.size;
+                }
+            }
+
+            // *INDENT-OFF*
+            if (result.form == PointForm::Custom) {return std::nullopt;}
+            // *INDENT-ON*
+
+            return result;
+        }
+
+        struct BoxFill
+        {
+            std::optional<double> density;      // std::nullopt for empty boxes
+        };
+
+        //! `set style fill` as far as `solid [density]` and `empty`
+        std::optional<BoxFill> resolveBoxFill(const std::string& fill)
+        {
+            // *INDENT-OFF*
+            if (fill == "empty")            {return BoxFill{std::nullopt};}
+            if (fill == "solid")            {return BoxFill{1.};}
+            if (!fill.starts_with("solid ")) {return std::nullopt;}
+            // *INDENT-ON*
+
+            const auto density = parseNumber(fill.substr(6u));
+            // *INDENT-OFF*
+            if (!density || density.value() < 0. || density.value() > 1.) {return std::nullopt;}
+            // *INDENT-ON*
+
+            return BoxFill{density.value()};
+        }
+
+        // ------------------------------------------------------------------ //
+        // data
+
+        bool isSupportedStyle(const PlotStyle2D style)
+        {
+            switch (style)
+            {
+                case PlotStyle2D::Dots:
+                case PlotStyle2D::Points:
+                case PlotStyle2D::Lines:
+                case PlotStyle2D::LinesPoints:
+                case PlotStyle2D::Steps:
+                case PlotStyle2D::FSteps:
+                case PlotStyle2D::Boxes:
+                case PlotStyle2D::XErrorBars:
+                case PlotStyle2D::YErrorBars:
+                case PlotStyle2D::XYErrorBars:
+                case PlotStyle2D::XErrorLines:
+                case PlotStyle2D::YErrorLines:
+                case PlotStyle2D::XYErrorLines:
+                    return true;
+
+                default:
+                    return false;
+            }
+        }
+
+        bool hasLines(const PlotStyle2D style)
+        {
+            switch (style)
+            {
+                case PlotStyle2D::Lines:
+                case PlotStyle2D::LinesPoints:
+                case PlotStyle2D::Steps:
+                case PlotStyle2D::FSteps:
+                case PlotStyle2D::XErrorLines:
+                case PlotStyle2D::YErrorLines:
+                case PlotStyle2D::XYErrorLines:
+                    return true;
+
+                default:
+                    return false;
+            }
+        }
+
+        bool hasPoints(const PlotStyle2D style)
+        {
+            // *INDENT-OFF*
+            return style != PlotStyle2D::Lines && style != PlotStyle2D::Steps && style != PlotStyle2D::FSteps &&
+                   style != PlotStyle2D::Boxes && style != PlotStyle2D::Dots;
+            // *INDENT-ON*
+        }
+
+        bool hasErrorBars(const PlotStyle2D style)
+        {
+            return hasPoints(style) && style != PlotStyle2D::Points && style != PlotStyle2D::LinesPoints;
+        }
+
+        //! the number of columns in the using specification, counting an unassigned X column
+        size_t getColumnCount(const DataView2D& view)
+        {
+            const auto& assignments = view.getColumnAssignments();
+            size_t      result      = 1u;
+
+            for (size_t i = 1u; i < assignments.size(); ++i)
+            {
+                // *INDENT-OFF*
+                if (assignments[i] != COLUMN_UNUSED) {result = i + 1u;}
+                // *INDENT-ON*
+            }
+
+            return result;
+        }
+
+        struct Extent
+        {
+            double x, y;
+            double xLow, xHigh;
+            double yLow, yHigh;
+        };
+
+        //! position and error bars of a record, cf. gnuplot 5.4 documentation, sections xyerrorbars et al.
+        Extent getExtent(const PlotStyle2D style, size_t columns, const record_t& r)
+        {
+            Extent result = {r[0], r[1], r[0], r[0], r[1], r[1]};
+
+            switch (style)
+            {
+                case PlotStyle2D::XErrorBars:
+                case PlotStyle2D::XErrorLines:
+                    // *INDENT-OFF*
+                    if (columns >= 4u) {result.xLow = r[2];        result.xHigh = r[3];}
+                    else               {result.xLow = r[0] - r[2]; result.xHigh = r[0] + r[2];}
+                    // *INDENT-ON*
+                    break;
+
+                case PlotStyle2D::YErrorBars:
+                case PlotStyle2D::YErrorLines:
+                    // *INDENT-OFF*
+                    if (columns >= 4u) {result.yLow = r[2];        result.yHigh = r[3];}
+                    else               {result.yLow = r[1] - r[2]; result.yHigh = r[1] + r[2];}
+                    // *INDENT-ON*
+                    break;
+
+                case PlotStyle2D::XYErrorBars:
+                case PlotStyle2D::XYErrorLines:
+                    if (columns >= 6u)
+                    {
+                        result.xLow = r[2];
+                        result.xHigh = r[3];
+                        result.yLow = r[4];
+                        result.yHigh = r[5];
+                    }
+                    else
+                    {
+                        result.xLow  = r[0] - r[2];
+                        result.xHigh = r[0] + r[2];
+                        result.yLow  = r[1] - r[3];
+                        result.yHigh = r[1] + r[3];
+                    }
+                    break;
+
+                default:
+                    break;
+            }
+
+            return result;
+        }
+
+        /* Calls `visitor(left, right, y)` for every box of a view with style Boxes. Without a width column,
+         * adjacent boxes touch, like with gnuplot's default `set boxwidth`; this needs the neighbouring
+         * records, so each box is passed on once the next record is known.
+         */
+        void visitBoxes(const DataView2D& view, size_t columns, const std::function<void (double, double, double)>& visitor)
+        {
+            if (columns >= 3u)
+            {
+                view.visitRecords([&visitor] (std::span<const record_t> records)
+                {
+                    for (const auto& r : records)
+                    {
+                        visitor(r[0] - r[2] / 2., r[0] + r[2] / 2., r[1]);
+                    }
+                });
+                return;
+            }
+
+            std::optional<record_t> previous;
+            std::optional<record_t> current;
+
+            const auto emit = [&] (const std::optional<record_t>& next)
+            {
+                // *INDENT-OFF*
+                if (!current) {return;}
+                const double x     = (*current)[0];
+                const double right = (next     ? (x + (*next)[0]) / 2.     : (previous ? x + (x - (*previous)[0]) / 2. : x + .5));
+                const double left  = (previous ? (x + (*previous)[0]) / 2. : x - (right - x));
+                // *INDENT-ON*
+                visitor(left, right, (*current)[1]);
+            };
+
+            view.visitRecords([&] (std::span<const record_t> records)
+            {
+                for (const auto& r : records)
+                {
+                    emit(r);
+                    previous = current;
+                    current  = r;
+                }
+            });
+            emit(std::nullopt);
+        }
+
+        // ------------------------------------------------------------------ //
+        // axes
+
+        struct TicsSequence
+        {
+            double start;       // NaN: multiples of increment
+            double increment;
+            double end;         // NaN: up to the end of the range
+        };
+
+        //! interprets the tics members of `axis` like PlotWithAxes::generateTicsSequence does for the script
+        std::optional<TicsSequence> resolveTicsSequence(const AxisDescriptor& axis)
+        {
+            double min       = axis.ticsStart;
+            double max       = axis.ticsEnd;
+            double increment = axis.ticsIncrement;
+
+            // *INDENT-OFF*
+            if (std::isinf(min) || std::isinf(max) || std::isinf(increment)) {return std::nullopt;}
+
+            if (std::isnan(min))       {min = axis.rangeMin;}
+            if (std::isnan(max))       {max = axis.rangeMax;}
+            if (std::isnan(increment)) {increment = 1.;}
+
+            if (increment <= 0.)                        {return std::nullopt;}
+            if (std::isnan(min) && !std::isnan(max))    {return std::nullopt;}
+            // *INDENT-ON*
+
+            return TicsSequence{min, increment, max};
+        }
+
+        //! gnuplot's automatic tics increment for a range of width `range` (quantize_normal_tics)
+        double getAutoTicsIncrement(double range)
+        {
+            // *INDENT-OFF*
+            if (!(range > 0.) || !std::isfinite(range)) {return 1.;}
+            // *INDENT-ON*
+
+            const double power      = std::pow(10., std::floor(std::log10(range)));
+            const double positions  = 20. / (range / power);
+
+            // *INDENT-OFF*
+            if (positions > 40.) {return .05 * power;}
+            if (positions > 20.) {return .1  * power;}
+            if (positions > 10.) {return .2  * power;}
+            if (positions >  4.) {return .5  * power;}
+            if (positions >  2.) {return 1.  * power;}
+            if (positions >  .5) {return 2.  * power;}
+            // *INDENT-ON*
+
+            return std::ceil(range / power) * power;
+        }
+
+        std::string formatTicsLabel(double value, double increment)
+        {
+            char buffer[32];
+
+            // *INDENT-OFF*
+            if (std::abs(value) < increment * TICS_TOLERANCE) {value = 0.;}
+            // *INDENT-ON*
+
+            std::snprintf(buffer, sizeof(buffer), "%g", value);
+            return buffer;
+        }
+
+        struct AxisRange
+        {
+            double                      min         = 0.;
+            double                      max         = 1.;
+            double                      increment   = 0.;       // zero: no tics besides the listed ones
+            double                      origin      = 0.;
+            std::optional<TicsSequence> sequence;
+        };
+
+        struct AxisLayout
+        {
+            double                                      min = 0.;
+            double                                      max = 1.;
+            std::vector<std::pair<double, std::string>> tics;
+            std::vector<double>                         minorTics;
+        };
+
+        //! the limits and tics increment of `axis` for data in [`dataMin`, `dataMax`]
+        AxisRange resolveAxisRange(const AxisDescriptor& axis, double dataMin, double dataMax)
+        {
+            AxisRange result;
+
+            const bool autoMin = std::isnan(axis.rangeMin);
+            const bool autoMax = std::isnan(axis.rangeMax);
+
+            double min = (autoMin ? dataMin : axis.rangeMin);
+            double max = (autoMax ? dataMax : axis.rangeMax);
+
+            // like gnuplot, an empty range becomes [-10:10] and a degenerate one is widened by a percent
+            // *INDENT-OFF*
+            if (!std::isfinite(min)) {min = (std::isfinite(max) ? std::min(max, 0.) - 10. : -10.);}
+            if (!std::isfinite(max)) {max = std::max(min, 0.) + 10.;}
+            if (min == max) {
+                const double margin = (min == 0. ? 1. : std::abs(min) / 100.);
+                if (autoMin || !autoMax) {min -= margin;}
+                if (autoMax || !autoMin) {max += margin;}
+            }
+            // *INDENT-ON*
+
+            auto   sequence  = (axis.tics ? resolveTicsSequence(axis) : std::nullopt);
+            double increment = (sequence ? sequence->increment : 0.);
+
+            // without sequence, a list of tics replaces the automatic ones
+            // *INDENT-OFF*
+            if (axis.tics && !sequence && axis.ticsLabels.empty()) {increment = getAutoTicsIncrement(std::abs(max - min));}
+            if (increment > 0. && std::abs(max - min) / increment > MAX_TICS) {increment = getAutoTicsIncrement(std::abs(max - min)); sequence.reset();}
+            // *INDENT-ON*
+
+            const double origin = (sequence && !std::isnan(sequence->start) ? sequence->start : 0.);
+
+            // autoscaled limits are extended to the next tic
+            if (increment > 0. && min < max)
+            {
+                // *INDENT-OFF*
+                if (autoMin) {min = origin + std::floor((min - origin) / increment + TICS_TOLERANCE) * increment;}
+                if (autoMax) {max = origin + std::ceil ((max - origin) / increment - TICS_TOLERANCE) * increment;}
+                // *INDENT-ON*
+            }
+
+            result.min       = min;
+            result.max       = max;
+            result.increment = increment;
+            result.origin    = origin;
+            result.sequence  = sequence;
+            return result;
+        }
+
+        /* tells whether the tics of `range` can be counted exactly: beyond 2^53, consecutive multiples of the
+         * increment are no longer distinct doubles, and a range of infinite width has no meaningful tics
+         */
+        bool hasCountableTics(const AxisRange& range)
+        {
+            constexpr double MAX_EXACT_INTEGER = 9007199254740992.;     // 2^53
+
+            const double low  = std::min(range.min, range.max);
+            const double high = std::max(range.min, range.max);
+
+            // *INDENT-OFF*
+            if (!std::isfinite(low) || !std::isfinite(high) || !std::isfinite(high - low)) {return false;}
+            if (!(range.increment > 0.)) {return true;}
+            // *INDENT-ON*
+
+            return std::abs((low  - range.origin) / range.increment) < MAX_EXACT_INTEGER &&
+                   std::abs((high - range.origin) / range.increment) < MAX_EXACT_INTEGER;
+        }
+
+        AxisLayout layoutAxis(const AxisDescriptor& axis, double dataMin, double dataMax)
+        {
+            AxisLayout result;
+
+            const auto range = resolveAxisRange(axis, dataMin, dataMax);
+            const auto& [min, max, increment, origin, sequence] = range;
+
+            result.min = min;
+            result.max = max;
+
+            const double low  = std::min(min, max);
+            const double high = std::max(min, max);
+
+            if (increment > 0. && hasCountableTics(range))
+            {
+                const double first = std::ceil ((low  - origin) / increment - TICS_TOLERANCE);
+                const double last  = std::floor((high - origin) / increment + TICS_TOLERANCE);
+
+                const size_t minorIntervals = (axis.minorTicsIntervals == AXIS_AUTO_MINOR_TICS ? 5u : axis.minorTicsIntervals);
+
+                // one tic below the range carries the minor tics up to the first one
+                const size_t count = (last >= first - 1. ? std::min<size_t>(last - first + 2., MAX_TICS + 2u) : 0u);
+                for (size_t i = 0u; i < count; ++i)
+                {
+                    const double position   = origin + (first - 1.) * increment + i * increment;
+                    const bool   inSequence = !sequence ||
+                                              ((std::isnan(sequence->start) || position >= sequence->start - increment * TICS_TOLERANCE) &&
+                                               (std::isnan(sequence->end)   || position <= sequence->end   + increment * TICS_TOLERANCE));
+
+                    // *INDENT-OFF*
+                    if (i > 0u && inSequence) {result.tics.push_back({position, formatTicsLabel(position, increment)});}
+                    if (!axis.minorTics || minorIntervals < 2u) {continue;}
+                    // *INDENT-ON*
+
+                    for (size_t j = 1u; j < minorIntervals; ++j)
+                    {
+                        const double minorPosition = position + j * increment / minorIntervals;
+                        // *INDENT-OFF*
+                        if (minorPosition >= low && minorPosition <= high) {result.minorTics.push_back(minorPosition);}
+                        // *INDENT-ON*
+                    }
+                }
+            }
+
+            if (axis.tics)
+            {
+                for (const auto& [text, position] : axis.ticsLabels)
+                {
+                    // *INDENT-OFF*
+                    if (position >= low && position <= high) {result.tics.push_back({position, unquote(text)});}
+                    // *INDENT-ON*
+                }
+            }
+
+            return result;
+        }
+
+        // ------------------------------------------------------------------ //
+        // page layout
+
+        struct Frame
+        {
+            double      left, top, right, bottom;
+            AxisLayout  x, y;
+
+            double mapX(double value) const
+            {
+                const double result = left + (value - x.min) / (x.max - x.min) * (right - left);
+                return std::clamp(result, -PIXEL_LIMIT, PIXEL_LIMIT);
+            }
+
+            double mapY(double value) const
+            {
+                const double result = bottom - (value - y.min) / (y.max - y.min) * (bottom - top);
+                return std::clamp(result, -PIXEL_LIMIT, PIXEL_LIMIT);
+            }
+
+            CanvasPoint map(double x, double y) const
+            {
+                return {mapX(x), mapY(y)};
+            }
+        };
+
+        std::optional<std::string> findUnsupportedText(const std::string& what, const std::string& text, const std::string& font, const std::string& color)
+        {
+            // *INDENT-OFF*
+            if (hasEnhancedMarkup(text))                    {return what + " with enhanced text markup";}
+            if (!parseFont(font, TextStyle()))              {return what + " font '" + font + "'";}
+            if (!resolveColor(color, BLACK))                {return what + " color '" + color + "'";}
+            // *INDENT-ON*
+            return std::nullopt;
+        }
+
+        std::optional<std::string> findUnsupportedAxis(const AxisDescriptor& axis)
+        {
+            const std::string name = getAxisName(axis.type) + " axis";
+
+            // *INDENT-OFF*
+            if (axis.type != AxisType::X && axis.type != AxisType::Y)                   {return name;}
+            if (axis.rangeOptions || axis.ticsOptions || axis.labelOptions)             {return name + " options";}
+            if (axis.ticsFormatstring)                                                  {return name + " tics format";}
+            if (axis.ticsLogscale)                                                      {return name + " logscale";}
+            if (axis.rangeMin == axis.rangeMax)                                         {return name + " range of zero width";}
+            if (std::isinf(axis.rangeMin) || std::isinf(axis.rangeMax))                 {return name + " infinite range";}
+            // *INDENT-ON*
+
+            for (const auto& [text, position] : axis.ticsLabels)
+            {
+                // *INDENT-OFF*
+                if (hasEnhancedMarkup(unquote(text))) {return name + " tics label with enhanced text markup";}
+                // *INDENT-ON*
+            }
+
+            if (auto problem = findUnsupportedText(name + " tics", "", axis.ticsFont.value_or(""), axis.ticsTextColor.value_or("")))
+            {
+                return problem;
+            }
+
+            return findUnsupportedText(name + " label", axis.labelText.value_or(""), axis.labelFont.value_or(""), axis.labelColor.value_or(""));
+        }
+
+        std::optional<std::string> findUnsupportedView(const DataView* view, size_t i, const StylesCollection& stylesCollection)
+        {
+            const auto view2D = dynamic_cast<const DataView2D*>(view);
+            const auto name   = "data view #" + std::to_string(i + 1u);
+
+            // *INDENT-OFF*
+            if (!view2D)                                                        {return name + " of unknown type";}
+            if (!isSupportedStyle(view->getStyleID()))                          {return name + " style '" + view->getStyle() + "'";}
+            if (view->getStyle() != getPlotStyleName(view->getStyleID()))       {return name + " style '" + view->getStyle() + "'";}
+            if (view2D->isFunction())                                           {return name + " function";}
+            if (view2D->isDummy())                                              {return name + " external data file";}
+            if (!view2D->isComplete())                                          {return name + " incomplete columns";}
+            if (!view->getOptions().empty())                                    {return name + " options";}
+            if (hasEnhancedMarkup(view->getTitle()))                            {return name + " title with enhanced text markup";}
+            if (!resolveViewStyle(*view2D, i, stylesCollection))                {return name + " line or point style";}
+            // *INDENT-ON*
+
+            for (const auto& format : view->getColumnFormats())
+            {
+                // *INDENT-OFF*
+                if (format != COLUMN_FORMAT_DEFAULT) {return name + " column format '" + format + "'";}
+                // *INDENT-ON*
+            }
+
+            const size_t columns = getColumnCount(*view2D);
+            // *INDENT-OFF*
+            if (view->getStyleID() == PlotStyle2D::Points && columns > 2u)     {return name + " variable point properties";}
+            if (view->getStyleID() == PlotStyle2D::Boxes  && columns > 3u)     {return name + " variable box properties";}
+            // *INDENT-ON*
+
+            return std::nullopt;
+        }
+
+        AxisDescriptor getAxis(const PlotWithAxes& plot, AxisType type)
+        {
+            const auto& axes = plot.getAxes();
+            return (axes.contains(type) ? axes.at(type) : AxisDescriptor(type));
+        }
+
+        struct DataExtents
+        {
+            double xMin =  std::numeric_limits<double>::infinity();
+            double xMax = -std::numeric_limits<double>::infinity();
+            double yMin =  std::numeric_limits<double>::infinity();
+            double yMax = -std::numeric_limits<double>::infinity();
+        };
+
+        //! the extents of the data of `plot`; only determined if one of the limits of `xAxis` or `yAxis` is autoscaled
+        DataExtents findDataExtents(const PlotWithAxes& plot, const AxisDescriptor& xAxis, const AxisDescriptor& yAxis)
+        {
+            DataExtents result;
+            auto& [xMin, xMax, yMin, yMax] = result;
+
+            const bool autoscale = std::isnan(xAxis.rangeMin) || std::isnan(xAxis.rangeMax) || std::isnan(yAxis.rangeMin) || std::isnan(yAxis.rangeMax);
+
+            const auto include = [&] (double x0, double x1, double y0, double y1)
+            {
+                // *INDENT-OFF*
+                if (std::isfinite(x0)) {xMin = std::min(xMin, x0); xMax = std::max(xMax, x0);}
+                if (std::isfinite(x1)) {xMin = std::min(xMin, x1); xMax = std::max(xMax, x1);}
+                if (std::isfinite(y0)) {yMin = std::min(yMin, y0); yMax = std::max(yMax, y0);}
+                if (std::isfinite(y1)) {yMin = std::min(yMin, y1); yMax = std::max(yMax, y1);}
+                // *INDENT-ON*
+            };
+
+            for (const auto view : plot.getDataViews())
+            {
+                // *INDENT-OFF*
+                if (!autoscale) {break;}
+                // *INDENT-ON*
+
+                const auto&  view2D  = dynamic_cast<const DataView2D&>(*view);
+                const auto   style   = view->getStyleID();
+                const size_t columns = getColumnCount(view2D);
+
+                if (style == PlotStyle2D::Boxes)
+                {
+                    visitBoxes(view2D, columns, [&include] (double left, double right, double y) {include(left, right, y, y);});
+                    continue;
+                }
+
+                view2D.visitRecords([&] (std::span<const record_t> records)
+                {
+                    for (const auto& r : records)
+                    {
+                        const auto e = getExtent(style, columns, r);
+                        // *INDENT-OFF*
+                        if (!std::isfinite(e.x) || !std::isfinite(e.y)) {continue;}
+                        // *INDENT-ON*
+                        include(e.xLow, e.xHigh, e.yLow, e.yHigh);
+                    }
+                });
+            }
+
+            return result;
+        }
+
+        // ------------------------------------------------------------------ //
+
+        class PagePainter
+        {
+            private:
+                const Sheet&            sheet;
+                const StylesCollection& stylesCollection;
+                Canvas&                 canvas;
+                const double            width;
+                const double            height;
+                const Color             background;
+
+                TextStyle               baseStyle;
+                Frame                   frame;
+
+                const PlotWithAxes*     plot = nullptr;
+
+                void layoutPlot();
+                void layoutSheet();
+
+                TextStyle getTextStyle(const std::string& font, const std::string& color, TextAnchor anchor) const;
+
+                void drawView (const DataView2D& view, size_t i) const;
+                void drawBoxes(const DataView2D& view, const ViewStyle& style) const;
+                void drawAxes () const;
+                void drawKey  () const;
+                void drawLabel(const Label& label) const;
+
+            public:
+                PagePainter(const Sheet& sheet, const StylesCollection& stylesCollection, Canvas& canvas, double width, double height, const Color& background);
+
+                void paint();
+        };
+
+        PagePainter::PagePainter(const Sheet& sheet, const StylesCollection& stylesCollection, Canvas& canvas, double width, double height, const Color& background) :
+            sheet(sheet), stylesCollection(stylesCollection), canvas(canvas), width(width), height(height), background(background)
+        {
+            baseStyle       = parseFont(sheet.getDefaultFont(), baseStyle).value_or(baseStyle);
+            baseStyle.color = BLACK;
+            baseStyle.size  = canvas.getFixedTextSize().value_or(baseStyle.size);
+
+            plot = dynamic_cast<const PlotWithAxes*>(&sheet);
+        }
+
+        TextStyle PagePainter::getTextStyle(const std::string& font, const std::string& color, TextAnchor anchor) const
+        {
+            TextStyle result = parseFont(font, baseStyle).value_or(baseStyle);
+            result.color     = resolveColor(color, BLACK).value_or(BLACK);
+            result.anchor    = anchor;
+            result.size      = canvas.getFixedTextSize().value_or(result.size);
+            return result;
+        }
+
+        void PagePainter::layoutSheet()
+        {
+            // cf. Report::writeCleanSheetCommands
+            const double fontSize = baseStyle.size;
+            const double top      = (sheet.getTitle().empty() ? fontSize : 3. * fontSize);
+
+            frame = {fontSize, top, width - fontSize, height - fontSize, {}, {}};
+            frame.x = {0., 1., {}, {}};
+            frame.y = {1., 0., {}, {}};
+        }
+
+        void PagePainter::layoutPlot()
+        {
+            const auto xAxis   = getAxis(*plot, AxisType::X);
+            const auto yAxis   = getAxis(*plot, AxisType::Y);
+            const auto extents = findDataExtents(*plot, xAxis, yAxis);
+
+            frame.x = layoutAxis(xAxis, extents.xMin, extents.xMax);
+            frame.y = layoutAxis(yAxis, extents.yMin, extents.yMax);
+
+            // margins, after gnuplot's default layout
+            const double fontSize    = baseStyle.size;
+            const auto   yTicsStyle  = getTextStyle(yAxis.ticsFont.value_or(""), "", TextAnchor::End);
+            const auto   xTicsStyle  = getTextStyle(xAxis.ticsFont.value_or(""), "", TextAnchor::Middle);
+
+            double yTicsWidth = 0.;
+            for (const auto& [position, text] : frame.y.tics)
+            {
+                yTicsWidth = std::max(yTicsWidth, canvas.getTextWidth(text, yTicsStyle));
+            }
+
+            const bool xLabel = xAxis.labelText.has_value();
+            const bool yLabel = yAxis.labelText.has_value();
+
+            // *INDENT-OFF*
+            frame.left   = fontSize + (yLabel ? 2. * fontSize : 0.) + (frame.y.tics.empty() ? 0. : yTicsWidth + fontSize);
+            frame.right  = width  - 2. * fontSize;
+            frame.top    = (sheet.getTitle().empty() ? fontSize : 3. * fontSize);
+            frame.bottom = height - fontSize - (xLabel ? 2. * fontSize : 0.) - (frame.x.tics.empty() ? 0. : 1.5 * xTicsStyle.size);
+            // *INDENT-ON*
+
+            frame.right  = std::max(frame.right,  frame.left + 1.);
+            frame.bottom = std::max(frame.bottom, frame.top  + 1.);
+        }
+
+        void PagePainter::drawView(const DataView2D& view, size_t i) const
+        {
+            const auto   style     = view.getStyleID();
+            const auto   viewStyle = resolveViewStyle(view, i, stylesCollection).value();
+            const size_t columns   = getColumnCount(view);
+
+            // *INDENT-OFF*
+            if (style == PlotStyle2D::Boxes) {drawBoxes(view, viewStyle); return;}
+            // *INDENT-ON*
+
+            if (hasLines(style))
+            {
+                /* one path per view, streamed block by block; undefined points interrupt the line, and the
+                 * step styles insert the corner between two points */
+                bool   penDown = false;
+                double xLast   = 0.;
+                double yLast   = 0.;
+
+                canvas.beginPath(viewStyle.stroke);
+                view.visitRecords([&] (std::span<const record_t> records)
+                {
+                    for (const auto& r : records)
+                    {
+                        const double x = r[0];
+                        const double y = r[1];
+
+                        // *INDENT-OFF*
+                        if (!std::isfinite(x) || !std::isfinite(y)) {penDown = false; continue;}
+
+                        if      (!penDown)                      {canvas.moveTo(frame.map(x, y));}
+                        else if (style == PlotStyle2D::Steps)   {canvas.lineTo(frame.map(x, yLast)); canvas.lineTo(frame.map(x, y));}
+                        else if (style == PlotStyle2D::FSteps)  {canvas.lineTo(frame.map(xLast, y)); canvas.lineTo(frame.map(x, y));}
+                        else                                    {canvas.lineTo(frame.map(x, y));}
+                        // *INDENT-ON*
+
+                        penDown = true;
+                        xLast   = x;
+                        yLast   = y;
+                    }
+                });
+                canvas.endPath();
+            }
+
+            if (hasErrorBars(style))
+            {
+                // all bars of a view form one path; the caps are as wide as a marker
+                const double cap = POINT_SIZE_PIXELS * viewStyle.pointSize;
+
+                canvas.beginPath(viewStyle.stroke);
+                view.visitRecords([&] (std::span<const record_t> records)
+                {
+                    for (const auto& r : records)
+                    {
+                        const auto e = getExtent(style, columns, r);
+                        // *INDENT-OFF*
+                        if (!std::isfinite(e.x) || !std::isfinite(e.y)) {continue;}
+                        // *INDENT-ON*
+
+                        const auto center = frame.map(e.x, e.y);
+
+                        if (e.xLow != e.x || e.xHigh != e.x)
+                        {
+                            const double left  = frame.mapX(e.xLow);
+                            const double right = frame.mapX(e.xHigh);
+                            canvas.moveTo({left,  center.y});
+                            canvas.lineTo({right, center.y});
+                            canvas.moveTo({left,  center.y - cap});
+                            canvas.lineTo({left,  center.y + cap});
+                            canvas.moveTo({right, center.y - cap});
+                            canvas.lineTo({right, center.y + cap});
+                        }
+
+                        if (e.yLow != e.y || e.yHigh != e.y)
+                        {
+                            const double low  = frame.mapY(e.yLow);
+                            const double high = frame.mapY(e.yHigh);
+                            canvas.moveTo({center.x, low});
+                            canvas.lineTo({center.x, high});
+                            canvas.moveTo({center.x - cap, low});
+                            canvas.lineTo({center.x + cap, low});
+                            canvas.moveTo({center.x - cap, high});
+                            canvas.lineTo({center.x + cap, high});
+                        }
+                    }
+                });
+                canvas.endPath();
+            }
+
+            if (hasPoints(style) || style == PlotStyle2D::Dots)
+            {
+                const PointForm form = (style == PlotStyle2D::Dots ? PointForm::Point : viewStyle.form);
+                const double    size = POINT_SIZE_PIXELS * viewStyle.pointSize;
+
+                Stroke markerStroke = viewStyle.stroke;
+                markerStroke.dashes.clear();
+
+                view.visitRecords([&] (std::span<const record_t> records)
+                {
+                    for (const auto& r : records)
+                    {
+                        // *INDENT-OFF*
+                        if (!std::isfinite(r[0]) || !std::isfinite(r[1])) {continue;}
+                        // *INDENT-ON*
+                        canvas.marker(frame.map(r[0], r[1]), form, size, markerStroke);
+                    }
+                });
+            }
+        }
+
+        void PagePainter::drawBoxes(const DataView2D& view, const ViewStyle& style) const
+        {
+            const auto fill = resolveBoxFill(plot->getFill()).value();
+
+            std::optional<Color> fillColor;
+            if (fill.density)
+            {
+                fillColor    = style.stroke.color;
+                fillColor->a = static_cast<uint8_t>(std::lround(fill.density.value() * 255.));
+            }
+
+            // boxes extend from the zero line, or from the bottom of the plot if zero is out of range
+            const double base = frame.mapY(std::clamp(0., std::min(frame.y.min, frame.y.max), std::max(frame.y.min, frame.y.max)));
+
+            visitBoxes(view, getColumnCount(view), [&] (double left, double right, double y)
+            {
+                // *INDENT-OFF*
+                if (!std::isfinite(left) || !std::isfinite(right) || !std::isfinite(y)) {return;}
+                // *INDENT-ON*
+
+                const double x0 = frame.mapX(left);
+                const double x1 = frame.mapX(right);
+                const double y0 = frame.mapY(y);
+                canvas.rectangle(std::min(x0, x1), std::min(y0, base), std::abs(x1 - x0), std::abs(base - y0), fillColor, style.stroke);
+            });
+        }
+
+        void PagePainter::drawAxes() const
+        {
+            const auto& axes      = plot->getAxes();
+            const double ticSize  = baseStyle.size / 2.;
+            const size_t border   = plot->getBorder();
+
+            Stroke borderStroke;
+            if (plot->getBorderLineStyle() != STYLE_ID_DEFAULT)
+            {
+                const auto& lineStyle = stylesCollection.getLineStyle(plot->getBorderLineStyle());
+                borderStroke.color = resolveColor(lineStyle.color, BLACK).value_or(BLACK);
+                borderStroke.width = (lineStyle.width > 0. ? lineStyle.width : 1.);
+            }
+
+            Stroke ticsStroke = borderStroke;
+            ticsStroke.dashes.clear();
+
+            // tics point inwards and are mirrored on the opposite border
+            for (const auto axisID : {AxisType::X, AxisType::Y})
+            {
+                // *INDENT-OFF*
+                if (!axes.contains(axisID)) {continue;}
+                // *INDENT-ON*
+
+                const auto& axis   = axes.at(axisID);
+                const auto& layout = (axisID == AxisType::X ? frame.x : frame.y);
+
+                canvas.beginPath(ticsStroke);
+                for (const auto& [position, text] : layout.tics)
+                {
+                    if (axisID == AxisType::X)
+                    {
+                        const double x = frame.mapX(position);
+                        canvas.moveTo({x, frame.bottom});
+                        canvas.lineTo({x, frame.bottom - ticSize});
+                        canvas.moveTo({x, frame.top});
+                        canvas.lineTo({x, frame.top + ticSize});
+                    }
+                    else
+                    {
+                        const double y = frame.mapY(position);
+                        canvas.moveTo({frame.left, y});
+                        canvas.lineTo({frame.left + ticSize, y});
+                        canvas.moveTo({frame.right, y});
+                        canvas.lineTo({frame.right - ticSize, y});
+                    }
+                }
+                for (const auto position : layout.minorTics)
+                {
+                    if (axisID == AxisType::X)
+                    {
+                        const double x = frame.mapX(position);
+                        canvas.moveTo({x, frame.bottom});
+                        canvas.lineTo({x, frame.bottom - ticSize / 2.});
+                        canvas.moveTo({x, frame.top});
+                        canvas.lineTo({x, frame.top + ticSize / 2.});
+                    }
+                    else
+                    {
+                        const double y = frame.mapY(position);
+                        canvas.moveTo({frame.left, y});
+                        canvas.lineTo({frame.left + ticSize / 2., y});
+                        canvas.moveTo({frame.right, y});
+                        canvas.lineTo({frame.right - ticSize / 2., y});
+                    }
+                }
+                canvas.endPath();
+
+                const TextAnchor anchor    = (axisID == AxisType::X ? TextAnchor::Middle : TextAnchor::End);
+                const TextStyle  ticsStyle = getTextStyle(axis.ticsFont.value_or(""), axis.ticsTextColor.value_or(""), anchor);
+
+                for (const auto& [position, text] : layout.tics)
+                {
+                    // *INDENT-OFF*
+                    if (axisID == AxisType::X) {canvas.text({frame.mapX(position), frame.bottom + 1.2 * ticsStyle.size}, text, ticsStyle);}
+                    else                       {canvas.text({frame.left - baseStyle.size / 2., frame.mapY(position) + .35 * ticsStyle.size}, text, ticsStyle);}
+                    // *INDENT-ON*
+                }
+
+                // *INDENT-OFF*
+                if (!axis.labelText) {continue;}
+                // *INDENT-ON*
+
+                TextStyle labelStyle = getTextStyle(axis.labelFont.value_or(""), axis.labelColor.value_or(""), TextAnchor::Middle);
+                if (axisID == AxisType::X)
+                {
+                    const double y = frame.bottom + (layout.tics.empty() ? 0. : 1.5 * ticsStyle.size) + 1.5 * labelStyle.size;
+                    canvas.text({(frame.left + frame.right) / 2., y}, axis.labelText.value(), labelStyle);
+                }
+                else
+                {
+                    labelStyle.rotate = 90.;
+                    canvas.text({baseStyle.size + labelStyle.size, (frame.top + frame.bottom) / 2.}, axis.labelText.value(), labelStyle);
+                }
+            }
+
+            canvas.beginPath(borderStroke);
+            // *INDENT-OFF*
+            if (border & BorderLine::Bottom) {canvas.moveTo({frame.left,  frame.bottom}); canvas.lineTo({frame.right, frame.bottom});}
+            if (border & BorderLine::Left)   {canvas.moveTo({frame.left,  frame.bottom}); canvas.lineTo({frame.left,  frame.top});}
+            if (border & BorderLine::Top)    {canvas.moveTo({frame.left,  frame.top});    canvas.lineTo({frame.right, frame.top});}
+            if (border & BorderLine::Right)  {canvas.moveTo({frame.right, frame.bottom}); canvas.lineTo({frame.right, frame.top});}
+            // *INDENT-ON*
+            canvas.endPath();
+        }
+
+        void PagePainter::drawKey() const
+        {
+            // gnuplot's default key: top right inside the plot, titles right aligned left of the samples
+            const double fontSize     = baseStyle.size;
+            const double sampleLength = 4. * fontSize;
+            const double sampleRight  = frame.right - fontSize;
+            const double sampleLeft   = sampleRight - sampleLength;
+
+            TextStyle keyStyle = baseStyle;
+            keyStyle.anchor    = TextAnchor::End;
+
+            double y = frame.top + 1.2 * fontSize;
+            for (size_t i = 0u; const auto view : plot->getDataViews())
+            {
+                const auto& view2D = dynamic_cast<const DataView2D&>(*view);
+                const auto  style  = view->getStyleID();
+                const auto  viewStyle = resolveViewStyle(view2D, i++, stylesCollection).value();
+
+                // *INDENT-OFF*
+                if (view->getTitle().empty()) {continue;}
+                // *INDENT-ON*
+
+                canvas.text({sampleLeft - fontSize / 2., y + .35 * fontSize}, view->getTitle(), keyStyle);
+
+                if (style == PlotStyle2D::Boxes)
+                {
+                    const auto fill = resolveBoxFill(plot->getFill()).value();
+
+                    std::optional<Color> fillColor;
+                    if (fill.density)
+                    {
+                        fillColor    = viewStyle.stroke.color;
+                        fillColor->a = static_cast<uint8_t>(std::lround(fill.density.value() * 255.));
+                    }
+                    canvas.rectangle(sampleLeft, y - fontSize / 3., sampleLength, 2. * fontSize / 3., fillColor, viewStyle.stroke);
+                }
+                else if (hasLines(style) || hasErrorBars(style))
+                {
+                    canvas.beginPath(viewStyle.stroke);
+                    canvas.moveTo({sampleLeft,  y});
+                    canvas.lineTo({sampleRight, y});
+                    canvas.endPath();
+                }
+
+                if (hasPoints(style) || style == PlotStyle2D::Dots)
+                {
+                    Stroke markerStroke = viewStyle.stroke;
+                    markerStroke.dashes.clear();
+
+                    const PointForm form = (style == PlotStyle2D::Dots ? PointForm::Point : viewStyle.form);
+                    canvas.marker({(sampleLeft + sampleRight) / 2., y}, form, POINT_SIZE_PIXELS * viewStyle.pointSize, markerStroke);
+                }
+
+                y += 1.2 * fontSize;
+            }
+        }
+
+        void PagePainter::drawLabel(const Label& label) const
+        {
+            TextStyle style = getTextStyle(label.font, label.textcolor, resolveAlignment(label.alignment).value());
+            style.rotate    = label.rotate;
+
+            const auto [x, y] = label.coordinates;
+            const CanvasPoint anchor = (label.screenCS ? CanvasPoint{x * width, (1. - y) * height} : frame.map(x, y));
+
+            // text is centred vertically on the coordinates
+            if (label.boxed)
+            {
+                std::optional<Color>  fill;
+                std::optional<Stroke> stroke = Stroke();
+
+                // gnuplot's default text box is transparent with a black border
+                if (label.boxStyleID < stylesCollection.getBoxStyleCount())
+                {
+                    const auto& boxStyle = stylesCollection.getBoxStyle(label.boxStyleID);
+
+                    // *INDENT-OFF*
+                    if (boxStyle.opaque) {fill = resolveColor(boxStyle.fillcolor, background).value();}
+                    if (boxStyle.border) {stroke->color = resolveColor(boxStyle.bordercolor, BLACK).value();
+                                          stroke->width = (boxStyle.linewidth > 0. ? boxStyle.linewidth : 1.);}
+                    else                 {stroke.reset();}
+                    // *INDENT-ON*
+                }
+
+                const double textWidth = canvas.getTextWidth(label.text, style);
+                const double margin    = style.size / 4.;
+                const double offset    = (style.anchor == TextAnchor::Start ? 0. : (style.anchor == TextAnchor::Middle ? textWidth / 2. : textWidth));
+
+                // box corners relative to the anchor, before rotation
+                const double left   = -offset - margin;
+                const double right  = -offset + textWidth + margin;
+                const double top    = -.6 * style.size - margin;
+                const double bottom =  .6 * style.size + margin;
+
+                const double angle = -label.rotate * std::numbers::pi / 180.;
+                const double c     = std::cos(angle);
+                const double s     = std::sin(angle);
+
+                std::vector<CanvasPoint> corners;
+                for (const auto& [dx, dy] : {std::pair{left, top}, std::pair{right, top}, std::pair{right, bottom}, std::pair{left, bottom}})
+                {
+                    corners.push_back({anchor.x + c * dx - s * dy, anchor.y + s * dx + c * dy});
+                }
+                canvas.polygon(corners, fill, stroke);
+            }
+
+            const double angle = label.rotate * std::numbers::pi / 180.;
+            const double shift = .35 * style.size;
+            canvas.text({anchor.x + shift * std::sin(angle), anchor.y + shift * std::cos(angle)}, label.text, style);
+        }
+
+        void PagePainter::paint()
+        {
+            // *INDENT-OFF*
+            if (plot) {layoutPlot();}
+            else      {layoutSheet();}
+            // *INDENT-ON*
+
+            canvas.beginPage(width, height, background);
+
+            if (!sheet.getTitle().empty())
+            {
+                TextStyle titleStyle = getTextStyle(sheet.getTitleFont(), "", TextAnchor::Middle);
+                canvas.text({width / 2., frame.top - titleStyle.size / 2.}, sheet.getTitle(), titleStyle);
+            }
+
+            if (plot)
+            {
+                canvas.beginClip(frame.left, frame.top, frame.right - frame.left, frame.bottom - frame.top);
+                for (size_t i = 0u; const auto view : plot->getDataViews())
+                {
+                    drawView(dynamic_cast<const DataView2D&>(*view), i++);
+                }
+                canvas.endClip();
+
+                drawAxes();
+
+                // *INDENT-OFF*
+                if (plot->getKey()) {drawKey();}
+                // *INDENT-ON*
+            }
+
+            for (const auto& label : sheet.getLabels())
+            {
+                drawLabel(label);
+            }
+
+            canvas.endPage();
+        }
+    }
+
+    // ====================================================================== //
+
+    PlotPainter::PlotPainter(const Sheet& sheet, const StylesCollection& stylesCollection) :
+        sheet(sheet), stylesCollection(stylesCollection)
+    {}
+
+    std::optional<std::string> PlotPainter::findUnsupportedFeature(const Sheet& sheet, const StylesCollection& stylesCollection)
+    {
+        const auto plot = dynamic_cast<const PlotWithAxes*>(&sheet);
+
+        // *INDENT-OFF*
+        if (!plot && typeid(sheet) != typeid(Sheet))                                    {return "sheet type";}
+        if (plot && plot->getType() != PlotType::Plot2D)                                {return "sheet type";}
+        if (!sheet.getCustomScriptBegin().empty() || !sheet.getCustomScriptEnd().empty()) {return "custom script";}
+        if (hasEnhancedMarkup(sheet.getTitle()))                                        {return "title with enhanced text markup";}
+        if (!parseFont(sheet.getDefaultFont(), TextStyle()))                            {return "font '" + sheet.getDefaultFont() + "'";}
+        if (!parseFont(sheet.getTitleFont(),   TextStyle()))                            {return "title font '" + sheet.getTitleFont() + "'";}
+        // *INDENT-ON*
+
+        for (const auto& label : sheet.getLabels())
+        {
+            // *INDENT-OFF*
+            if (!label.options.empty())                 {return "label options";}
+            if (!resolveAlignment(label.alignment))     {return "label alignment '" + label.alignment + "'";}
+            if (auto problem = findUnsupportedText("label", label.text, label.font, label.textcolor)) {return problem;}
+            // *INDENT-ON*
+
+            if (label.boxed && label.boxStyleID < stylesCollection.getBoxStyleCount())
+            {
+                const auto& boxStyle = stylesCollection.getBoxStyle(label.boxStyleID);
+                // *INDENT-OFF*
+                if (!boxStyle.options.empty())                                                  {return "box style options";}
+                if (!parseColor(boxStyle.fillcolor)   && !boxStyle.fillcolor.empty())           {return "box style fill color '" + boxStyle.fillcolor + "'";}
+                if (!parseColor(boxStyle.bordercolor) && !boxStyle.bordercolor.empty())         {return "box style border color '" + boxStyle.bordercolor + "'";}
+                // *INDENT-ON*
+            }
+        }
+
+        // *INDENT-OFF*
+        if (!plot) {return std::nullopt;}
+
+        if (plot->getPolar())                           {return "polar plot";}
+        if (plot->getAspect() != "noratio")             {return "aspect ratio '" + plot->getAspect() + "'";}
+        if (!resolveBoxFill(plot->getFill()))           {return "fill style '" + plot->getFill() + "'";}
+        if (plot->getBorder() & ~size_t(BORDERS_2D_DEFAULT)) {return "border lines " + std::to_string(plot->getBorder());}
+        // *INDENT-ON*
+
+        const size_t borderLineStyle = plot->getBorderLineStyle();
+        if (borderLineStyle != STYLE_ID_DEFAULT)
+        {
+            // *INDENT-OFF*
+            if (borderLineStyle >= stylesCollection.getLineStyleCount())    {return "border line style";}
+            const auto& lineStyle = stylesCollection.getLineStyle(borderLineStyle);
+            if (!resolveColor(lineStyle.color, BLACK) || !lineStyle.options.empty() || !lineStyle.dashtype.empty()) {return "border line style";}
+            // *INDENT-ON*
+        }
+
+        for (const auto& [axisID, axis] : plot->getAxes())
+        {
+            // *INDENT-OFF*
+            if (auto problem = findUnsupportedAxis(axis)) {return problem;}
+            // *INDENT-ON*
+        }
+
+        for (size_t i = 0u; const auto view : plot->getDataViews())
+        {
+            // *INDENT-OFF*
+            if (auto problem = findUnsupportedView(view, i++, stylesCollection)) {return problem;}
+            // *INDENT-ON*
+        }
+
+        const auto xAxis   = getAxis(*plot, AxisType::X);
+        const auto yAxis   = getAxis(*plot, AxisType::Y);
+        const auto extents = findDataExtents(*plot, xAxis, yAxis);
+
+        // *INDENT-OFF*
+        if (!hasCountableTics(resolveAxisRange(xAxis, extents.xMin, extents.xMax))) {return getAxisName(AxisType::X) + " axis range beyond double precision";}
+        if (!hasCountableTics(resolveAxisRange(yAxis, extents.yMin, extents.yMax))) {return getAxisName(AxisType::Y) + " axis range beyond double precision";}
+        // *INDENT-ON*
+
+        return std::nullopt;
+    }
+
+    void PlotPainter::paint(Canvas& canvas, double width, double height, const Color& background) const
+    {
+        PagePainter(sheet, stylesCollection, canvas, width, height, background).paint();
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef PLOTPAINTER_H
+#define PLOTPAINTER_H
+
+#include <optional>
+#include <string>
+
+#include "canvas.h"
+
+namespace Plotypus
+{
+    class Sheet;
+    class StylesCollection;
+
+    /**
+     * @brief draws a Sheet onto a Canvas without gnuplot.
+     *
+     * Covers plain Sheets and PlotWithAxes with the styles Dots, Points, Lines, LinesPoints, Steps, FSteps,
+     * Boxes and the X/Y/XY error bars and error lines, on linear X and Y axes. Ranges, tics (including the
+     * sequence and list tics of the AxisDescriptor), axis labels, the border, the key, labels and the line,
+     * point and box styles are laid out after gnuplot's defaults; the data are read block by block through
+     * DataView2D::visitRecords. Anything else is reported by findUnsupportedFeature, so that the caller can
+     * fall back to gnuplot.
+     *
+     * Data views without a title are left out of the key, where gnuplot would show an automatic title.
+     */
+    class PlotPainter
+    {
+        private:
+            const Sheet&            sheet;
+            const StylesCollection& stylesCollection;
+
+        public:
+            PlotPainter(const Sheet& sheet, const StylesCollection& stylesCollection);
+
+            /**
+             * @brief returns a description of the first feature of `sheet` that cannot be drawn natively, or
+             *  std::nullopt if the whole Sheet is supported.
+             */
+            static std::optional<std::string> findUnsupportedFeature(const Sheet& sheet, const StylesCollection& stylesCollection);
+
+            //! @brief draws the Sheet as one page of `width` x `height` pixels.
+            void paint(Canvas& canvas, double width, double height, const Color& background) const;
+    };
+}
+
+#endif // PLOTPAINTER_H
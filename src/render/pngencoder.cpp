@@ -0,0 +1,339 @@
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+#include "../definitions/errors.h"
+
+#include "pngencoder.h"
+
+namespace Plotypus
+{
+    namespace
+    {
+        constexpr size_t WINDOW_SIZE    = 1u << 15;
+        constexpr size_t HASH_SIZE      = 1u << 15;
+        constexpr size_t MIN_MATCH      = 3u;
+        constexpr size_t MAX_MATCH      = 258u;
+        constexpr size_t MAX_CHAIN      = 64u;          // candidates compared per position
+
+        // cf. RFC 1951, section 3.2.5
+        constexpr uint16_t LENGTH_BASE[]        = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        constexpr uint8_t  LENGTH_EXTRA[]       = {0, 0, 0, 0, 0, 0, 0,  0,  1,  1,  1,  1,  2,  2,  2,  2,  3,  3,  3,  3,  4,  4,  4,   4,   5,   5,   5,   5,   0};
+        constexpr uint16_t DISTANCE_BASE[]      = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+        constexpr uint8_t  DISTANCE_EXTRA[]     = {0, 0, 0, 0, 1, 1, 2,  2,  3,  3,  4,  4,  5,  5,   6,   6,   7,   7,   8,   8,    9,    9,   10,   10,   11,   11,   12,    12,    13,    13};
+
+        //! collects bits least significant first, as deflate streams are packed
+        class BitWriter
+        {
+            private:
+                std::string& output;
+                uint64_t     buffer = 0u;
+                size_t       count  = 0u;
+
+            public:
+                BitWriter(std::string& output) : output(output) {}
+
+                void write(uint32_t bits, size_t length)
+                {
+                    buffer |= static_cast<uint64_t>(bits) << count;
+                    count  += length;
+
+                    while (count >= 8u)
+                    {
+                        output.push_back(static_cast<char>(buffer & 0xffu));
+                        buffer >>= 8;
+                        count   -= 8u;
+                    }
+                }
+
+                //! writes a Huffman code, which is stored most significant bit first
+                void writeCode(uint32_t code, size_t length)
+                {
+                    uint32_t reversed = 0u;
+                    for (size_t i = 0u; i < length; ++i)
+                    {
+                        reversed = (reversed << 1) | ((code >> i) & 1u);
+                    }
+                    write(reversed, length);
+                }
+
+                void flush()
+                {
+                    // *INDENT-OFF*
+                    if (count) {output.push_back(static_cast<char>(buffer & 0xffu));}
+                    // *INDENT-ON*
+                    buffer = 0u;
+                    count  = 0u;
+                }
+        };
+
+        void writeLiteral(BitWriter& writer, uint32_t value)
+        {
+            // fixed literal/length code, cf. RFC 1951, section 3.2.6
+            // *INDENT-OFF*
+            if      (value < 144u)  {writer.writeCode(0x30u  + value,         8u);}
+            else if (value < 256u)  {writer.writeCode(0x190u + value - 144u,  9u);}
+            else if (value < 280u)  {writer.writeCode(value - 256u,           7u);}
+            else                    {writer.writeCode(0xc0u  + value - 280u,  8u);}
+            // *INDENT-ON*
+        }
+
+        void writeMatch(BitWriter& writer, size_t length, size_t distance)
+        {
+            size_t lengthCode = 28u;
+            while (LENGTH_BASE[lengthCode] > length)
+            {
+                --lengthCode;
+            }
+            writeLiteral(writer, 257u + lengthCode);
+            writer.write(length - LENGTH_BASE[lengthCode], LENGTH_EXTRA[lengthCode]);
+
+            size_t distanceCode = 29u;
+            while (DISTANCE_BASE[distanceCode] > distance)
+            {
+                --distanceCode;
+            }
+            writer.writeCode(distanceCode, 5u);
+            writer.write(distance - DISTANCE_BASE[distanceCode], DISTANCE_EXTRA[distanceCode]);
+        }
+
+        //! appends the zlib stream (RFC 1950) of `data` to `output`, as a single deflate block with fixed codes
+        void compress(std::span<const uint8_t> data, std::string& output)
+        {
+            output.push_back(0x78);
+            output.push_back(0x01);
+
+            BitWriter writer(output);
+            writer.write(1u, 1u);           // last block
+            writer.write(1u, 2u);           // fixed Huffman codes
+
+            std::vector<int32_t> head(HASH_SIZE, -1);
+            std::vector<int32_t> previous(WINDOW_SIZE, -1);
+
+            const auto hash = [&data] (size_t i)
+            {
+                return ((data[i] << 10) ^ (data[i + 1u] << 5) ^ data[i + 2u]) & (HASH_SIZE - 1u);
+            };
+            const auto insert = [&] (size_t i)
+            {
+                // *INDENT-OFF*
+                if (i + MIN_MATCH > data.size()) {return;}
+                // *INDENT-ON*
+                const size_t h = hash(i);
+                previous[i & (WINDOW_SIZE - 1u)] = head[h];
+                head[h] = static_cast<int32_t>(i);
+            };
+
+            for (size_t i = 0u; i < data.size();)
+            {
+                size_t bestLength   = 0u;
+                size_t bestDistance = 0u;
+
+                if (i + MIN_MATCH <= data.size())
+                {
+                    const size_t maxLength = std::min(MAX_MATCH, data.size() - i);
+
+                    int32_t candidate = head[hash(i)];
+                    for (size_t chain = 0u; candidate >= 0 && chain < MAX_CHAIN; ++chain)
+                    {
+                        const size_t distance = i - candidate;
+                        // *INDENT-OFF*
+                        if (distance > WINDOW_SIZE - 1u) {break;}
+                        // *INDENT-ON*
+
+                        // only a candidate agreeing beyond the best match so far can improve on it
+                        if (data[candidate + bestLength] == data[i + bestLength])
+                        {
+                            size_t length = 0u;
+                            while (length < maxLength && data[candidate + length] == data[i + length])
+                            {
+                                ++length;
+                            }
+
+                            if (length > bestLength)
+                            {
+                                bestLength   = length;
+                                bestDistance = distance;
+                                // *INDENT-OFF*
+                                if (length == maxLength) {break;}
+                                // *INDENT-ON*
+                            }
+                        }
+
+                        const int32_t next = previous[candidate & (WINDOW_SIZE - 1u)];
+                        // *INDENT-OFF*
+                        if (next >= candidate) {break;}             // slot already reused
+                        // *INDENT-ON*
+                        candidate = next;
+                    }
+                }
+
+                if (bestLength >= MIN_MATCH)
+                {
+                    writeMatch(writer, bestLength, bestDistance);
+                    for (size_t j = 0u; j < bestLength; ++j)
+                    {
+                        insert(i + j);
+                    }
+                    i += bestLength;
+                }
+                else
+                {
+                    writeLiteral(writer, data[i]);
+                    insert(i);
+                    ++i;
+                }
+            }
+
+            writeLiteral(writer, 256u);     // end of block
+            writer.flush();
+
+            // Adler-32 checksum
+            uint32_t a = 1u;
+            uint32_t b = 0u;
+            for (size_t i = 0u; i < data.size();)
+            {
+                // 5552 bytes cannot overflow the sums before the reduction
+                const size_t end = std::min(data.size(), i + 5552u);
+                for (; i < end; ++i)
+                {
+                    a += data[i];
+                    b += a;
+                }
+                a %= 65521u;
+                b %= 65521u;
+            }
+            const uint32_t checksum = (b << 16) | a;
+            for (const int shift : {24, 16, 8, 0})
+            {
+                output.push_back(static_cast<char>((checksum >> shift) & 0xffu));
+            }
+        }
+
+        uint32_t crc32(const char* data, size_t size)
+        {
+            static const auto table = [] ()
+            {
+                std::array<uint32_t, 256> result;
+                for (uint32_t n = 0u; n < 256u; ++n)
+                {
+                    uint32_t c = n;
+                    for (size_t k = 0u; k < 8u; ++k)
+                    {
+                        c = (c & 1u ? 0xedb88320u ^ (c >> 1) : c >> 1);
+                    }
+                    result[n] = c;
+                }
+                return result;
+            }();
+
+            uint32_t c = 0xffffffffu;
+            for (size_t i = 0u; i < size; ++i)
+            {
+                c = table[(c ^ static_cast<uint8_t>(data[i])) & 0xffu] ^ (c >> 8);
+            }
+            return c ^ 0xffffffffu;
+        }
+
+        void writeUint32(std::string& output, uint32_t value)
+        {
+            for (const int shift : {24, 16, 8, 0})
+            {
+                output.push_back(static_cast<char>((value >> shift) & 0xffu));
+            }
+        }
+
+        void writeChunk(std::string& output, const char* type, const std::string& data)
+        {
+            writeUint32(output, static_cast<uint32_t>(data.size()));
+
+            const size_t start = output.size();
+            output.append(type, 4u);
+            output.append(data);
+            writeUint32(output, crc32(output.data() + start, output.size() - start));
+        }
+
+        uint8_t paeth(int a, int b, int c)
+        {
+            const int p  = a + b - c;
+            const int pa = std::abs(p - a);
+            const int pb = std::abs(p - b);
+            const int pc = std::abs(p - c);
+
+            // *INDENT-OFF*
+            if (pa <= pb && pa <= pc)   {return a;}
+            if (pb <= pc)               {return b;}
+            // *INDENT-ON*
+            return c;
+        }
+    }
+
+    std::string encodePng(std::span<const uint8_t> rgba, size_t width, size_t height)
+    {
+        // *INDENT-OFF*
+        if (rgba.size() != 4u * width * height)     {throw InvalidArgumentError("image data do not match the dimensions " + std::to_string(width) + " x " + std::to_string(height));}
+        if (!width || !height || width > 0x7fffffffu || height > 0x7fffffffu) {throw InvalidArgumentError("invalid image dimensions");}
+        // *INDENT-ON*
+
+        // filter each row, cf. PNG specification, section 9
+        const size_t         rowSize = 4u * width;
+        std::vector<uint8_t> filtered((rowSize + 1u) * height);
+        std::vector<uint8_t> candidate(rowSize);
+        const std::vector<uint8_t> zeros(rowSize, 0u);
+
+        for (size_t y = 0u; y < height; ++y)
+        {
+            const uint8_t* const row   = rgba.data() + y * rowSize;
+            const uint8_t* const above = (y ? row - rowSize : zeros.data());
+            uint8_t* const       out   = filtered.data() + y * (rowSize + 1u);
+
+            size_t bestCost = SIZE_MAX;
+            for (uint8_t type = 0u; type < 5u; ++type)
+            {
+                size_t cost = 0u;
+                for (size_t i = 0u; i < rowSize; ++i)
+                {
+                    const int a = (i >= 4u ? row[i - 4u]   : 0);
+                    const int b = above[i];
+                    const int c = (i >= 4u ? above[i - 4u] : 0);
+
+                    uint8_t predictor = 0u;
+                    switch (type)
+                    {
+                        // *INDENT-OFF*
+                        case 1: predictor = a;                  break;
+                        case 2: predictor = b;                  break;
+                        case 3: predictor = (a + b) / 2;        break;
+                        case 4: predictor = paeth(a, b, c);     break;
+                        // *INDENT-ON*
+                    }
+
+                    candidate[i] = static_cast<uint8_t>(row[i] - predictor);
+                    cost        += std::abs(static_cast<int8_t>(candidate[i]));
+                }
+
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    out[0]   = type;
+                    std::copy(candidate.begin(), candidate.end(), out + 1);
+                }
+            }
+        }
+
+        std::string header;
+        writeUint32(header, static_cast<uint32_t>(width));
+        writeUint32(header, static_cast<uint32_t>(height));
+        header += std::string("\x08\x06\x00\x00\x00", 5u);     // 8 bit RGBA, deflate, adaptive filtering, no interlace
+
+        std::string imageData;
+        compress(filtered, imageData);
+
+        std::string result = "\x89PNG\r\n\x1a\n";
+        writeChunk(result, "IHDR", header);
+        writeChunk(result, "IDAT", imageData);
+        writeChunk(result, "IEND", "");
+
+        return result;
+    }
+}
@@ -0,0 +1,20 @@
+#ifndef PNGENCODER_H
+#define PNGENCODER_H
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace Plotypus
+{
+    /**
+     * @brief returns the PNG file holding the `width` x `height` image `rgba`.
+     *
+     * `rgba` holds four bytes per pixel, row by row from the top, not premultiplied. Each row is
+     * filtered with the PNG filter yielding the smallest sum of absolute differences, and the image
+     * data are compressed with the built-in deflate (LZ77 with fixed Huffman codes).
+     */
+    std::string encodePng(std::span<const uint8_t> rgba, size_t width, size_t height);
+}
+
+#endif // PNGENCODER_H
@@ -0,0 +1,536 @@
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include "font.h"
+#include "rastercanvas.h"
+
+namespace Plotypus
+{
+    namespace
+    {
+        //! coverage below which a pixel is left untouched
+        constexpr float MIN_COVERAGE = 1.f / 512.f;
+
+        /* Adds the signed area left of the line from `p0` to `p1` to `accumulator`, one row of `stride`
+         * cells per pixel row; the running sum over a row then is the coverage of each pixel. The line
+         * must lie within [0, stride - 2] x [0, rows]. Cf. R. Levien, "font-rs", 2016.
+         */
+        void accumulateLine(std::vector<float>& accumulator, size_t stride, size_t rows, const CanvasPoint& p0, const CanvasPoint& p1)
+        {
+            // *INDENT-OFF*
+            if (p0.y == p1.y) {return;}
+            // *INDENT-ON*
+
+            const float       direction = (p0.y < p1.y ? 1.f : -1.f);
+            const CanvasPoint top       = (p0.y < p1.y ? p0 : p1);
+            const CanvasPoint bottom    = (p0.y < p1.y ? p1 : p0);
+            const double      dxdy      = (bottom.x - top.x) / (bottom.y - top.y);
+
+            double       x     = top.x;
+            const size_t yEnd  = std::min(rows, static_cast<size_t>(std::ceil(bottom.y)));
+
+            for (size_t y = static_cast<size_t>(top.y); y < yEnd; ++y)
+            {
+                float* const row   = accumulator.data() + y * stride;
+                const double dy    = std::min(y + 1., bottom.y) - std::max(static_cast<double>(y), top.y);
+                const double xNext = x + dxdy * dy;
+                const float  d     = static_cast<float>(dy) * direction;
+
+                const double x0      = std::min(x, xNext);
+                const double x1      = std::max(x, xNext);
+                const double x0Floor = std::floor(x0);
+                const double x1Ceil  = std::ceil (x1);
+                const size_t x0i     = static_cast<size_t>(x0Floor);
+                const size_t x1i     = static_cast<size_t>(x1Ceil);
+
+                if (x1i <= x0i + 1u)
+                {
+                    // within one pixel: split by the mean x position
+                    const float xm = static_cast<float>(.5 * (x + xNext) - x0Floor);
+                    row[x0i]      += d - d * xm;
+                    row[x0i + 1u] += d * xm;
+                }
+                else
+                {
+                    const float s   = static_cast<float>(1. / (x1 - x0));
+                    const float x0f = static_cast<float>(x0 - x0Floor);
+                    const float a0  = .5f * s * (1.f - x0f) * (1.f - x0f);
+                    const float x1f = static_cast<float>(x1 - x1Ceil + 1.);
+                    const float am  = .5f * s * x1f * x1f;
+
+                    row[x0i] += d * a0;
+                    if (x1i == x0i + 2u)
+                    {
+                        row[x0i + 1u] += d * (1.f - a0 - am);
+                    }
+                    else
+                    {
+                        const float a1 = s * (1.5f - x0f);
+                        row[x0i + 1u] += d * (a1 - a0);
+                        for (size_t xi = x0i + 2u; xi < x1i - 1u; ++xi)
+                        {
+                            row[xi] += d * s;
+                        }
+                        const float a2 = a1 + (x1i - x0i - 3u) * s;
+                        row[x1i - 1u] += d * (1.f - a2 - am);
+                    }
+                    row[x1i] += d * am;
+                }
+
+                x = xNext;
+            }
+        }
+
+        //! point at parameter `t` on the line from `p0` to `p1`
+        CanvasPoint interpolate(const CanvasPoint& p0, const CanvasPoint& p1, double t)
+        {
+            return {p0.x + t * (p1.x - p0.x), p0.y + t * (p1.y - p0.y)};
+        }
+
+        /* Clips the line to the rows [0, rows], and moves parts left of 0 or right of `columns` onto these
+         * borders: left of the area, a line covers whole rows, right of it, it does not count.
+         */
+        void accumulateClippedLine(std::vector<float>& accumulator, size_t stride, size_t rows, CanvasPoint p0, CanvasPoint p1)
+        {
+            const double columns = stride - 2u;
+
+            // *INDENT-OFF*
+            if (p0.y == p1.y)                                                                   {return;}
+            if ((p0.y <= 0. && p1.y <= 0.) || (p0.y >= rows && p1.y >= rows))                   {return;}
+            if (!std::isfinite(p0.x) || !std::isfinite(p0.y) || !std::isfinite(p1.x) || !std::isfinite(p1.y)) {return;}
+            // *INDENT-ON*
+
+            const double tTop    = (0.   - p0.y) / (p1.y - p0.y);
+            const double tBottom = (rows - p0.y) / (p1.y - p0.y);
+            const double tBegin  = std::max(0., std::min(tTop, tBottom));
+            const double tEnd    = std::min(1., std::max(tTop, tBottom));
+
+            const CanvasPoint q0 = interpolate(p0, p1, tBegin);
+            const CanvasPoint q1 = interpolate(p0, p1, tEnd);
+
+            // split where the line crosses the left and right border
+            double splits[4] = {0., 0., 0., 1.};
+            size_t splitCount = 1u;
+            if (q0.x != q1.x)
+            {
+                for (const double border : {0., columns})
+                {
+                    const double t = (border - q0.x) / (q1.x - q0.x);
+                    // *INDENT-OFF*
+                    if (t > 0. && t < 1.) {splits[splitCount++] = t;}
+                    // *INDENT-ON*
+                }
+            }
+            splits[splitCount] = 1.;
+            std::sort(splits + 1, splits + splitCount);
+
+            for (size_t i = 0u; i < splitCount; ++i)
+            {
+                CanvasPoint a = interpolate(q0, q1, splits[i]);
+                CanvasPoint b = interpolate(q0, q1, splits[i + 1u]);
+
+                // *INDENT-OFF*
+                if ((a.x + b.x) / 2. >= columns) {continue;}
+                // *INDENT-ON*
+
+                a.x = std::clamp(a.x, 0., columns);
+                b.x = std::clamp(b.x, 0., columns);
+                a.y = std::clamp(a.y, 0., static_cast<double>(rows));
+                b.y = std::clamp(b.y, 0., static_cast<double>(rows));
+                accumulateLine(accumulator, stride, rows, a, b);
+            }
+        }
+
+        //! splits the polyline `piece` into the dashes of `dashes`, appending them to `result`
+        void applyDashes(const std::vector<CanvasPoint>& piece, const std::vector<double>& dashes, std::vector<std::vector<CanvasPoint>>& result)
+        {
+            size_t dashID    = 0u;
+            double remaining = dashes[0];
+            bool   drawing   = true;
+
+            result.push_back({piece.front()});
+            for (size_t i = 1u; i < piece.size(); ++i)
+            {
+                CanvasPoint  from   = piece[i - 1u];
+                const auto&  to     = piece[i];
+                double       length = std::hypot(to.x - from.x, to.y - from.y);
+
+                while (length > remaining)
+                {
+                    from    = interpolate(from, to, remaining / length);
+                    length -= remaining;
+
+                    // *INDENT-OFF*
+                    if (drawing)    {result.back().push_back(from);}
+                    else            {result.push_back({from});}
+                    // *INDENT-ON*
+
+                    drawing   = !drawing;
+                    dashID    = (dashID + 1u) % dashes.size();
+                    remaining = std::max(dashes[dashID], .1);
+                }
+
+                remaining -= length;
+                // *INDENT-OFF*
+                if (drawing) {result.back().push_back(to);}
+                // *INDENT-ON*
+            }
+        }
+    }
+
+    // ====================================================================== //
+
+    RasterCanvas::ClipBox RasterCanvas::getClipBox() const
+    {
+        // *INDENT-OFF*
+        if (clipStack.empty()) {return {0, 0, static_cast<int>(width), static_cast<int>(height)};}
+        // *INDENT-ON*
+
+        return clipStack.back();
+    }
+
+    void RasterCanvas::blend(size_t x, size_t y, const Color& color, double alpha)
+    {
+        uint8_t* const pixel = pixels.data() + 4u * (y * width + x);
+        const double   a     = std::min(1., alpha * color.a / 255.);
+
+        if (pixel[3] == 255u)
+        {
+            pixel[0] = static_cast<uint8_t>(pixel[0] + (color.r - pixel[0]) * a + .5);
+            pixel[1] = static_cast<uint8_t>(pixel[1] + (color.g - pixel[1]) * a + .5);
+            pixel[2] = static_cast<uint8_t>(pixel[2] + (color.b - pixel[2]) * a + .5);
+            return;
+        }
+
+        // source over a translucent background
+        const double background = pixel[3] / 255. * (1. - a);
+        const double result     = a + background;
+
+        pixel[0] = static_cast<uint8_t>((color.r * a + pixel[0] * background) / result + .5);
+        pixel[1] = static_cast<uint8_t>((color.g * a + pixel[1] * background) / result + .5);
+        pixel[2] = static_cast<uint8_t>((color.b * a + pixel[2] * background) / result + .5);
+        pixel[3] = static_cast<uint8_t>(result * 255. + .5);
+    }
+
+    void RasterCanvas::fill(std::span<const Edge> edges, const Color& color)
+    {
+        // *INDENT-OFF*
+        if (edges.empty() || !color.a) {return;}
+        // *INDENT-ON*
+
+        double xMin =  INFINITY, yMin =  INFINITY;
+        double xMax = -INFINITY, yMax = -INFINITY;
+        for (const auto& [p0, p1] : edges)
+        {
+            xMin = std::min({xMin, p0.x, p1.x});
+            xMax = std::max({xMax, p0.x, p1.x});
+            yMin = std::min({yMin, p0.y, p1.y});
+            yMax = std::max({yMax, p0.y, p1.y});
+        }
+
+        const ClipBox clip   = getClipBox();
+        const int     left   = std::max(clip.left,   static_cast<int>(std::max(-1e6, std::floor(xMin))));
+        const int     top    = std::max(clip.top,    static_cast<int>(std::max(-1e6, std::floor(yMin))));
+        const int     right  = std::min(clip.right,  static_cast<int>(std::min( 1e6, std::ceil (xMax))));
+        const int     bottom = std::min(clip.bottom, static_cast<int>(std::min( 1e6, std::ceil (yMax))));
+
+        // *INDENT-OFF*
+        if (left >= right || top >= bottom) {return;}
+        // *INDENT-ON*
+
+        const size_t columns = right - left;
+        const size_t rows    = bottom - top;
+        const size_t stride  = columns + 2u;
+
+        coverage.assign(stride * rows, 0.f);
+        for (const auto& [p0, p1] : edges)
+        {
+            accumulateClippedLine(coverage, stride, rows, {p0.x - left, p0.y - top}, {p1.x - left, p1.y - top});
+        }
+
+        for (size_t y = 0u; y < rows; ++y)
+        {
+            const float* const row = coverage.data() + y * stride;
+            float              sum = 0.f;
+
+            for (size_t x = 0u; x < columns; ++x)
+            {
+                sum += row[x];
+
+                // overlapping shapes of the same orientation add up; their union is fully covered
+                const float alpha = std::min(std::abs(sum), 1.f);
+                // *INDENT-OFF*
+                if (alpha >= MIN_COVERAGE) {blend(left + x, top + y, color, alpha);}
+                // *INDENT-ON*
+            }
+        }
+    }
+
+    void RasterCanvas::stroke(std::span<const std::vector<CanvasPoint>> pieces, const Stroke& stroke)
+    {
+        std::vector<std::vector<CanvasPoint>> dashed;
+        if (!stroke.dashes.empty())
+        {
+            for (const auto& piece : pieces)
+            {
+                // *INDENT-OFF*
+                if (!piece.empty()) {applyDashes(piece, stroke.dashes, dashed);}
+                // *INDENT-ON*
+            }
+            pieces = dashed;
+        }
+
+        // each segment becomes a rectangle, extended by half the width at both ends to close the joints
+        const double halfWidth = std::max(stroke.width, 1.) / 2.;
+
+        std::vector<Edge> edges;
+        for (const auto& piece : pieces)
+        {
+            for (size_t i = 1u; i < piece.size(); ++i)
+            {
+                const auto&  a      = piece[i - 1u];
+                const auto&  b      = piece[i];
+                const double length = std::hypot(b.x - a.x, b.y - a.y);
+
+                // *INDENT-OFF*
+                if (length == 0. || !std::isfinite(length)) {continue;}
+                // *INDENT-ON*
+
+                const double dx = (b.x - a.x) / length * halfWidth;
+                const double dy = (b.y - a.y) / length * halfWidth;
+
+                const CanvasPoint c0 = {a.x - dx - dy, a.y - dy + dx};
+                const CanvasPoint c1 = {b.x + dx - dy, b.y + dy + dx};
+                const CanvasPoint c2 = {b.x + dx + dy, b.y + dy - dx};
+                const CanvasPoint c3 = {a.x - dx + dy, a.y - dy - dx};
+
+                edges.push_back({c0, c1});
+                edges.push_back({c1, c2});
+                edges.push_back({c2, c3});
+                edges.push_back({c3, c0});
+            }
+        }
+
+        fill(edges, stroke.color);
+    }
+
+    // ====================================================================== //
+
+    size_t RasterCanvas::getWidth() const
+    {
+        return width;
+    }
+
+    size_t RasterCanvas::getHeight() const
+    {
+        return height;
+    }
+
+    const std::vector<uint8_t>& RasterCanvas::getPixels() const
+    {
+        return pixels;
+    }
+
+    void RasterCanvas::beginPage(double width, double height, const Color& background)
+    {
+        this->width  = static_cast<size_t>(std::max(1., std::round(width)));
+        this->height = static_cast<size_t>(std::max(1., std::round(height)));
+
+        pixels.resize(4u * this->width * this->height);
+        for (size_t i = 0u; i < pixels.size(); i += 4u)
+        {
+            pixels[i]      = background.r;
+            pixels[i + 1u] = background.g;
+            pixels[i + 2u] = background.b;
+            pixels[i + 3u] = background.a;
+        }
+
+        clipStack.clear();
+        pathPieces.clear();
+    }
+
+    void RasterCanvas::endPage()
+    {}
+
+    void RasterCanvas::beginClip(double x, double y, double width, double height)
+    {
+        const ClipBox outer = getClipBox();
+        const ClipBox inner =
+        {
+            std::max(outer.left,   static_cast<int>(std::floor(x))),
+            std::max(outer.top,    static_cast<int>(std::floor(y))),
+            std::min(outer.right,  static_cast<int>(std::ceil (x + width))),
+            std::min(outer.bottom, static_cast<int>(std::ceil (y + height)))
+        };
+
+        clipStack.push_back(inner);
+    }
+
+    void RasterCanvas::endClip()
+    {
+        // *INDENT-OFF*
+        if (!clipStack.empty()) {clipStack.pop_back();}
+        // *INDENT-ON*
+    }
+
+    void RasterCanvas::beginPath(const Stroke& stroke)
+    {
+        pathStroke = stroke;
+        pathPieces.clear();
+    }
+
+    void RasterCanvas::moveTo(const CanvasPoint& point)
+    {
+        pathPieces.push_back({point});
+    }
+
+    void RasterCanvas::lineTo(const CanvasPoint& point)
+    {
+        // *INDENT-OFF*
+        if (pathPieces.empty()) {moveTo(point); return;}
+        // *INDENT-ON*
+
+        pathPieces.back().push_back(point);
+    }
+
+    void RasterCanvas::endPath()
+    {
+        stroke(pathPieces, pathStroke);
+        pathPieces.clear();
+    }
+
+    void RasterCanvas::polygon(std::span<const CanvasPoint> points, const std::optional<Color>& fill, const std::optional<Stroke>& stroke)
+    {
+        // *INDENT-OFF*
+        if (points.empty()) {return;}
+        // *INDENT-ON*
+
+        if (fill)
+        {
+            std::vector<Edge> edges;
+            for (size_t i = 0u; i < points.size(); ++i)
+            {
+                edges.push_back({points[i], points[(i + 1u) % points.size()]});
+            }
+            this->fill(edges, fill.value());
+        }
+
+        if (stroke)
+        {
+            std::vector<std::vector<CanvasPoint>> outline(1u, std::vector<CanvasPoint>(points.begin(), points.end()));
+            outline.back().push_back(points.front());
+            this->stroke(outline, stroke.value());
+        }
+    }
+
+    void RasterCanvas::text(const CanvasPoint& position, const std::string& text, const TextStyle& style)
+    {
+        const double scale  = style.size / FONT_PIXEL_SIZE;
+        const double bold   = (style.bold ? 1. : 0.);              // overprint offset in font pixels
+        const double angle  = style.rotate * std::numbers::pi / 180.;
+
+        // unit vectors along the baseline and towards the top of the glyphs
+        const double alongX = std::cos(angle);
+        const double alongY = -std::sin(angle);
+        const double upX    = -std::sin(angle);
+        const double upY    = -std::cos(angle);
+
+        const double textWidth = getTextWidth(text, style);
+        double       pen       = (style.anchor == TextAnchor::Start ? 0. : (style.anchor == TextAnchor::Middle ? -textWidth / 2. : -textWidth));
+
+        const ClipBox clip = getClipBox();
+
+        const auto sample = [] (const Glyph& glyph, double gx, double gy)
+        {
+            // bilinear, with the pixel centers at half-integer positions
+            const double fx = gx - .5;
+            const double fy = gy - .5;
+            const int    ix = static_cast<int>(std::floor(fx));
+            const int    iy = static_cast<int>(std::floor(fy));
+            const double tx = fx - ix;
+            const double ty = fy - iy;
+
+            return (1. - ty) * ((1. - tx) * getGlyphCoverage(glyph, ix, iy)      + tx * getGlyphCoverage(glyph, ix + 1, iy)) +
+                   ty        * ((1. - tx) * getGlyphCoverage(glyph, ix, iy + 1)  + tx * getGlyphCoverage(glyph, ix + 1, iy + 1));
+        };
+
+        for (size_t i = 0u; i < text.size();)
+        {
+            const Glyph& glyph = getGlyph(decodeUtf8(text, i));
+
+            if (glyph.width && glyph.height)
+            {
+                // screen bounding box of the glyph bitmap, widened by the bold offset
+                double xMin =  INFINITY, yMin =  INFINITY;
+                double xMax = -INFINITY, yMax = -INFINITY;
+                for (const double gx : {0., glyph.width + bold})
+                {
+                    for (const double gy : {0., static_cast<double>(glyph.height)})
+                    {
+                        const double along = pen + (glyph.left + gx) * scale;
+                        const double up    = (glyph.top - gy) * scale;
+                        const double x     = position.x + along * alongX + up * upX;
+                        const double y     = position.y + along * alongY + up * upY;
+
+                        xMin = std::min(xMin, x);
+                        xMax = std::max(xMax, x);
+                        yMin = std::min(yMin, y);
+                        yMax = std::max(yMax, y);
+                    }
+                }
+
+                const int left   = std::max(clip.left,   static_cast<int>(std::max(-1e6, std::floor(xMin) - 1.)));
+                const int top    = std::max(clip.top,    static_cast<int>(std::max(-1e6, std::floor(yMin) - 1.)));
+                const int right  = std::min(clip.right,  static_cast<int>(std::min( 1e6, std::ceil (xMax) + 1.)));
+                const int bottom = std::min(clip.bottom, static_cast<int>(std::min( 1e6, std::ceil (yMax) + 1.)));
+
+                for (int y = top; y < bottom; ++y)
+                {
+                    for (int x = left; x < right; ++x)
+                    {
+                        // 2 x 2 samples per pixel, mapped back into the glyph bitmap
+                        double sum = 0.;
+                        for (const double sy : {.25, .75})
+                        {
+                            for (const double sx : {.25, .75})
+                            {
+                                const double rx    = x + sx - position.x;
+                                const double ry    = y + sy - position.y;
+                                const double along = rx * alongX + ry * alongY;
+                                const double up    = rx * upX    + ry * upY;
+                                const double gx    = (along - pen) / scale - glyph.left;
+                                const double gy    = glyph.top - up / scale;
+
+                                double value = sample(glyph, gx, gy);
+                                // *INDENT-OFF*
+                                if (bold) {value = std::max(value, sample(glyph, gx - bold, gy));}
+                                // *INDENT-ON*
+                                sum += value;
+                            }
+                        }
+
+                        // *INDENT-OFF*
+                        if (sum / 4. >= MIN_COVERAGE) {blend(x, y, style.color, sum / 4.);}
+                        // *INDENT-ON*
+                    }
+                }
+            }
+
+            pen += (glyph.advance + bold) * scale;
+        }
+    }
+
+    double RasterCanvas::getTextWidth(const std::string& text, const TextStyle& style) const
+    {
+        const double bold = (style.bold ? 1. : 0.);
+
+        double result = 0.;
+        for (size_t i = 0u; i < text.size();)
+        {
+            result += getGlyph(decodeUtf8(text, i)).advance + bold;
+        }
+
+        return result * style.size / FONT_PIXEL_SIZE;
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef RASTERCANVAS_H
+#define RASTERCANVAS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "canvas.h"
+
+namespace Plotypus
+{
+    /**
+     * @brief Canvas drawing into an RGBA buffer in memory.
+     *
+     * All shapes are filled with exact, anti-aliased coverage (accumulated signed area per pixel); strokes
+     * are filled as the union of one rectangle per segment. Text uses the built-in font (see getGlyph),
+     * scaled and rotated as requested; bold text is emboldened by overprinting. The pixels are stored row
+     * by row, four bytes per pixel, not premultiplied. A page is kept until the next beginPage.
+     */
+    class RasterCanvas : public Canvas
+    {
+        private:
+            struct ClipBox
+            {
+                int left, top, right, bottom;
+            };
+
+            struct Edge
+            {
+                CanvasPoint p0, p1;
+            };
+
+            size_t                              width  = 0u;
+            size_t                              height = 0u;
+            std::vector<uint8_t>                pixels;
+
+            std::vector<ClipBox>                clipStack;
+
+            Stroke                              pathStroke;
+            std::vector<std::vector<CanvasPoint>> pathPieces;
+
+            std::vector<float>                  coverage;
+
+            ClipBox getClipBox() const;
+
+            //! @brief fills the area enclosed by `edges` (non-zero winding) with `color`.
+            void fill  (std::span<const Edge> edges, const Color& color);
+            //! @brief draws the polylines `pieces` with `stroke`.
+            void stroke(std::span<const std::vector<CanvasPoint>> pieces, const Stroke& stroke);
+
+            void blend(size_t x, size_t y, const Color& color, double alpha);
+
+        public:
+            RasterCanvas() = default;
+
+            size_t                      getWidth () const;
+            size_t                      getHeight() const;
+            //! @brief returns the RGBA values of the current page, row by row from the top.
+            const std::vector<uint8_t>& getPixels() const;
+
+            virtual void beginPage(double width, double height, const Color& background);
+            virtual void endPage();
+
+            virtual void beginClip(double x, double y, double width, double height);
+            virtual void endClip();
+
+            virtual void beginPath(const Stroke& stroke);
+            virtual void moveTo(const CanvasPoint& point);
+            virtual void lineTo(const CanvasPoint& point);
+            virtual void endPath();
+
+            virtual void polygon(std::span<const CanvasPoint> points, const std::optional<Color>& fill, const std::optional<Stroke>& stroke);
+            virtual void text(const CanvasPoint& position, const std::string& text, const TextStyle& style);
+
+            virtual double getTextWidth(const std::string& text, const TextStyle& style) const;
+    };
+}
+
+#endif // RASTERCANVAS_H
@@ -0,0 +1,245 @@
+#include <charconv>
+#include <cmath>
+
+#include "svgcanvas.h"
+
+namespace Plotypus
+{
+    void SvgCanvas::writeNumber(double value)
+    {
+        char buffer[32];
+
+        // *INDENT-OFF*
+        if (!std::isfinite(value))  {value = 0.;}
+        if (std::abs(value) < .005) {value = 0.;}             // no "-0.00"
+        // *INDENT-ON*
+
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 2);
+        hFile.write(buffer, result.ptr - buffer);
+    }
+
+    void SvgCanvas::writePoint(const CanvasPoint& point)
+    {
+        writeNumber(point.x);
+        hFile << ',';
+        writeNumber(point.y);
+    }
+
+    void SvgCanvas::writeStroke(const Stroke& stroke)
+    {
+        hFile << " stroke=\"" << getColorHexString(stroke.color) << "\" stroke-width=\"";
+        writeNumber(stroke.width);
+        hFile << "\"";
+
+        // *INDENT-OFF*
+        if (stroke.color.a != 255u) {hFile << " stroke-opacity=\""; writeNumber(stroke.color.a / 255.); hFile << "\"";}
+        // *INDENT-ON*
+
+        if (!stroke.dashes.empty())
+        {
+            hFile << " stroke-dasharray=\"";
+            for (size_t i = 0u; const double length : stroke.dashes)
+            {
+                // *INDENT-OFF*
+                if (i++) {hFile << ' ';}
+                // *INDENT-ON*
+                writeNumber(length);
+            }
+            hFile << "\"";
+        }
+    }
+
+    void SvgCanvas::writeFill(const std::optional<Color>& fill)
+    {
+        // *INDENT-OFF*
+        if (!fill) {hFile << " fill=\"none\""; return;}
+        // *INDENT-ON*
+
+        hFile << " fill=\"" << getColorHexString(fill.value()) << "\"";
+
+        // *INDENT-OFF*
+        if (fill->a != 255u) {hFile << " fill-opacity=\""; writeNumber(fill->a / 255.); hFile << "\"";}
+        // *INDENT-ON*
+    }
+
+    void SvgCanvas::writeEscaped(const std::string& text)
+    {
+        for (const char c : text)
+        {
+            switch (c)
+            {
+                // *INDENT-OFF*
+                case '&':   hFile << "&amp;";   break;
+                case '<':   hFile << "&lt;";    break;
+                case '>':   hFile << "&gt;";    break;
+                case '"':   hFile << "&quot;";  break;
+                default:    hFile << c;         break;
+                // *INDENT-ON*
+            }
+        }
+    }
+
+    // ====================================================================== //
+
+    SvgCanvas::SvgCanvas(std::ostream& hFile) :
+        hFile(hFile)
+    {}
+
+    void SvgCanvas::beginPage(double width, double height, const Color& background)
+    {
+        clipCount = 0u;
+
+        hFile << "<?xml version=\"1.0\" encoding=\"utf-8\" standalone=\"no\"?>\n";
+        hFile << "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" width=\"";
+        writeNumber(width);
+        hFile << "\" height=\"";
+        writeNumber(height);
+        hFile << "\" viewBox=\"0 0 ";
+        writeNumber(width);
+        hFile << ' ';
+        writeNumber(height);
+        hFile << "\" stroke-linejoin=\"round\" stroke-linecap=\"butt\">\n";
+        hFile << "<desc>Produced by Plotypus</desc>\n";
+
+        // *INDENT-OFF*
+        if (background.a) {rectangle(0., 0., width, height, background, std::nullopt);}
+        // *INDENT-ON*
+    }
+
+    void SvgCanvas::endPage()
+    {
+        hFile << "</svg>\n";
+    }
+
+    void SvgCanvas::beginClip(double x, double y, double width, double height)
+    {
+        const size_t id = ++clipCount;
+
+        hFile << "<clipPath id=\"clip" << id << "\">";
+        rectangle(x, y, width, height, Color(), std::nullopt);
+        hFile << "</clipPath>\n";
+        hFile << "<g clip-path=\"url(#clip" << id << ")\">\n";
+    }
+
+    void SvgCanvas::endClip()
+    {
+        hFile << "</g>\n";
+    }
+
+    void SvgCanvas::beginPath(const Stroke& stroke)
+    {
+        hFile << "<path fill=\"none\"";
+        writeStroke(stroke);
+        hFile << " d=\"";
+        pathStarted = false;
+    }
+
+    void SvgCanvas::moveTo(const CanvasPoint& point)
+    {
+        hFile << (pathStarted ? " M" : "M");
+        writePoint(point);
+        pathStarted = true;
+    }
+
+    void SvgCanvas::lineTo(const CanvasPoint& point)
+    {
+        // *INDENT-OFF*
+        if (!pathStarted) {moveTo(point); return;}
+        // *INDENT-ON*
+
+        hFile << " L";
+        writePoint(point);
+    }
+
+    void SvgCanvas::endPath()
+    {
+        // an empty path data attribute is an error in SVG
+        // *INDENT-OFF*
+        if (!pathStarted) {hFile << "M0,0";}
+        // *INDENT-ON*
+
+        hFile << "\"/>\n";
+    }
+
+    void SvgCanvas::polygon(std::span<const CanvasPoint> points, const std::optional<Color>& fill, const std::optional<Stroke>& stroke)
+    {
+        // *INDENT-OFF*
+        if (points.empty() || (!fill && !stroke)) {return;}
+        // *INDENT-ON*
+
+        hFile << "<polygon";
+        writeFill(fill);
+        // *INDENT-OFF*
+        if (stroke) {writeStroke(stroke.value());}
+        // *INDENT-ON*
+
+        hFile << " points=\"";
+        for (size_t i = 0u; const auto& point : points)
+        {
+            // *INDENT-OFF*
+            if (i++) {hFile << ' ';}
+            // *INDENT-ON*
+            writePoint(point);
+        }
+        hFile << "\"/>\n";
+    }
+
+    void SvgCanvas::rectangle(double x, double y, double width, double height, const std::optional<Color>& fill, const std::optional<Stroke>& stroke)
+    {
+        // *INDENT-OFF*
+        if (!fill && !stroke) {return;}
+        if (width  < 0.) {x += width;  width  = -width;}
+        if (height < 0.) {y += height; height = -height;}
+        // *INDENT-ON*
+
+        hFile << "<rect x=\"";
+        writeNumber(x);
+        hFile << "\" y=\"";
+        writeNumber(y);
+        hFile << "\" width=\"";
+        writeNumber(width);
+        hFile << "\" height=\"";
+        writeNumber(height);
+        hFile << "\"";
+        writeFill(fill);
+        // *INDENT-OFF*
+        if (stroke) {writeStroke(stroke.value());}
+        // *INDENT-ON*
+        hFile << "/>\n";
+    }
+
+    void SvgCanvas::text(const CanvasPoint& position, const std::string& text, const TextStyle& style)
+    {
+        static constexpr const char* ANCHOR_NAMES[] = {"start", "middle", "end"};
+
+        hFile << "<text x=\"";
+        writeNumber(position.x);
+        hFile << "\" y=\"";
+        writeNumber(position.y);
+        hFile << "\" font-family=\"";
+        writeEscaped(style.family);
+        hFile << "\" font-size=\"";
+        writeNumber(style.size);
+        hFile << "\"";
+
+        // *INDENT-OFF*
+        if (style.bold) {hFile << " font-weight=\"bold\"";}
+        // *INDENT-ON*
+
+        hFile << " text-anchor=\"" << ANCHOR_NAMES[static_cast<int>(style.anchor)] << "\"";
+        writeFill(style.color);
+
+        if (style.rotate != 0.)
+        {
+            hFile << " transform=\"rotate(";
+            writeNumber(-style.rotate);
+            hFile << ' ';
+            writePoint(position);
+            hFile << ")\"";
+        }
+
+        hFile << ">";
+        writeEscaped(text);
+        hFile << "</text>\n";
+    }
+}
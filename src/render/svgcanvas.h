@@ -0,0 +1,51 @@
+#ifndef SVGCANVAS_H
+#define SVGCANVAS_H
+
+#include <ostream>
+
+#include "canvas.h"
+
+namespace Plotypus
+{
+    /**
+     * @brief Canvas writing an SVG 1.1 document to a stream.
+     *
+     * Each page becomes one `<svg>` document; coordinates are written with two decimals. Paths are
+     * written as they are streamed, so that their size does not depend on the number of vertices.
+     */
+    class SvgCanvas : public Canvas
+    {
+        private:
+            std::ostream& hFile;
+
+            size_t clipCount   = 0u;
+            bool   pathStarted = false;
+
+            void writeNumber(double value);
+            void writePoint (const CanvasPoint& point);
+            void writeStroke(const Stroke& stroke);
+            void writeFill  (const std::optional<Color>& fill);
+            void writeEscaped(const std::string& text);
+
+        public:
+            SvgCanvas(std::ostream& hFile);
+
+            virtual void beginPage(double width, double height, const Color& background);
+            virtual void endPage();
+
+            virtual void beginClip(double x, double y, double width, double height);
+            virtual void endClip();
+
+            virtual void beginPath(const Stroke& stroke);
+            virtual void moveTo(const CanvasPoint& point);
+            virtual void lineTo(const CanvasPoint& point);
+            virtual void endPath();
+
+            virtual void polygon(std::span<const CanvasPoint> points, const std::optional<Color>& fill, const std::optional<Stroke>& stroke);
+            virtual void text(const CanvasPoint& position, const std::string& text, const TextStyle& style);
+
+            virtual void rectangle(double x, double y, double width, double height, const std::optional<Color>& fill, const std::optional<Stroke>& stroke);
+    };
+}
+
+#endif // SVGCANVAS_H
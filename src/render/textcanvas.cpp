@@ -0,0 +1,413 @@
+#include <algorithm>
+#include <cmath>
+
+#include "font.h"
+#include "textcanvas.h"
+
+namespace Plotypus
+{
+    namespace
+    {
+        // indexed by the set dots: top left 1, top right 2, bottom left 4, bottom right 8
+        constexpr const char* QUADRANT_BLOCKS[] =
+        {
+            " ", "▘", "▝", "▀", "▖", "▌", "▞", "▛",
+            "▗", "▚", "▐", "▜", "▄", "▙", "▟", "█"
+        };
+
+        // bit of the Braille pattern for the dot in column x, row y of a cell
+        constexpr uint8_t BRAILLE_BITS[4][2] =
+        {
+            {0x01, 0x08},
+            {0x02, 0x10},
+            {0x04, 0x20},
+            {0x40, 0x80}
+        };
+
+        std::string encodeUtf8(char32_t c)
+        {
+            std::string result;
+
+            // *INDENT-OFF*
+            if (c < 0x80u)          {result += static_cast<char>(c);}
+            else if (c < 0x800u)    {result += static_cast<char>(0xc0u | (c >> 6));
+                                     result += static_cast<char>(0x80u | (c & 0x3fu));}
+            else                    {result += static_cast<char>(0xe0u | (c >> 12));
+                                     result += static_cast<char>(0x80u | ((c >> 6) & 0x3fu));
+                                     result += static_cast<char>(0x80u | (c & 0x3fu));}
+            // *INDENT-ON*
+
+            return result;
+        }
+
+        //! splits UTF-8 text into its characters
+        std::vector<std::string> splitCharacters(const std::string& text)
+        {
+            std::vector<std::string> result;
+            for (size_t i = 0u; i < text.size();)
+            {
+                const size_t start = i;
+                decodeUtf8(text, i);
+                result.push_back(text.substr(start, i - start));
+            }
+            return result;
+        }
+    }
+
+    // ====================================================================== //
+
+    TextCanvas::ClipBox TextCanvas::getClipBox() const
+    {
+        // *INDENT-OFF*
+        if (clipStack.empty()) {return {0, 0, width, height};}
+        // *INDENT-ON*
+
+        return clipStack.back();
+    }
+
+    void TextCanvas::setDot(int x, int y)
+    {
+        const ClipBox clip = getClipBox();
+
+        // *INDENT-OFF*
+        if (x < clip.left || x >= clip.right || y < clip.top || y >= clip.bottom) {return;}
+        // *INDENT-ON*
+
+        dots[y * width + x] = true;
+    }
+
+    bool TextCanvas::getDot(int x, int y) const
+    {
+        // *INDENT-OFF*
+        if (x < 0 || x >= width || y < 0 || y >= height) {return false;}
+        // *INDENT-ON*
+
+        return dots[y * width + x];
+    }
+
+    void TextCanvas::line(CanvasPoint p0, CanvasPoint p1)
+    {
+        // clip to the page first, so that far off points do not cost a dot each
+        const ClipBox clip = getClipBox();
+
+        double tBegin = 0.;
+        double tEnd   = 1.;
+        const double dx = p1.x - p0.x;
+        const double dy = p1.y - p0.y;
+
+        for (const auto& [p, q] : {std::pair{-dx, p0.x - clip.left}, std::pair{dx, clip.right  - p0.x},
+                                   std::pair{-dy, p0.y - clip.top},  std::pair{dy, clip.bottom - p0.y}})
+        {
+            if (p == 0.)
+            {
+                // *INDENT-OFF*
+                if (q < 0.) {return;}
+                // *INDENT-ON*
+                continue;
+            }
+
+            const double t = q / p;
+            // *INDENT-OFF*
+            if (p < 0.) {tBegin = std::max(tBegin, t);}
+            else        {tEnd   = std::min(tEnd,   t);}
+            // *INDENT-ON*
+        }
+
+        // *INDENT-OFF*
+        if (tBegin > tEnd || !std::isfinite(tBegin) || !std::isfinite(tEnd)) {return;}
+        // *INDENT-ON*
+
+        const double x0 = p0.x + tBegin * dx;
+        const double y0 = p0.y + tBegin * dy;
+        const double x1 = p0.x + tEnd * dx;
+        const double y1 = p0.y + tEnd * dy;
+
+        const size_t steps = static_cast<size_t>(std::ceil(std::max(std::abs(x1 - x0), std::abs(y1 - y0))));
+        for (size_t i = 0u; i <= steps; ++i)
+        {
+            const double t = (steps ? static_cast<double>(i) / steps : 0.);
+            setDot(static_cast<int>(std::floor(x0 + t * (x1 - x0))), static_cast<int>(std::floor(y0 + t * (y1 - y0))));
+        }
+    }
+
+    void TextCanvas::putText(size_t column, size_t row, const std::string& character)
+    {
+        // *INDENT-OFF*
+        if (column >= columns || row >= rows) {return;}
+        // *INDENT-ON*
+
+        texts[row * columns + column] = character;
+    }
+
+    std::string TextCanvas::getCellGlyph(size_t column, size_t row) const
+    {
+        const auto [dx, dy] = getDotsPerCell(glyphs);
+        const int  x        = column * dx;
+        const int  y        = row    * dy;
+
+        switch (glyphs)
+        {
+            case CellGlyphs::Characters:
+            {
+                // *INDENT-OFF*
+                if (!getDot(x, y)) {return " ";}
+                // *INDENT-ON*
+
+                // lines are shown by their direction, where it is horizontal or vertical
+                const bool horizontal = getDot(x - 1, y) || getDot(x + 1, y);
+                const bool vertical   = getDot(x, y - 1) || getDot(x, y + 1);
+
+                // *INDENT-OFF*
+                if (horizontal && vertical) {return "+";}
+                if (horizontal)             {return "-";}
+                if (vertical)               {return "|";}
+                // *INDENT-ON*
+                return "*";
+            }
+
+            case CellGlyphs::Blocks:
+            {
+                const size_t index = getDot(x, y) | getDot(x + 1, y) << 1 | getDot(x, y + 1) << 2 | getDot(x + 1, y + 1) << 3;
+                return QUADRANT_BLOCKS[index];
+            }
+
+            case CellGlyphs::Braille:
+            {
+                uint8_t bits = 0u;
+                for (int i = 0; i < 4; ++i)
+                {
+                    for (int j = 0; j < 2; ++j)
+                    {
+                        // *INDENT-OFF*
+                        if (getDot(x + j, y + i)) {bits |= BRAILLE_BITS[i][j];}
+                        // *INDENT-ON*
+                    }
+                }
+
+                // a blank Braille pattern is wider than a space in some terminals
+                // *INDENT-OFF*
+                if (!bits) {return " ";}
+                // *INDENT-ON*
+                return encodeUtf8(0x2800u + bits);
+            }
+        }
+
+        return " ";
+    }
+
+    // ====================================================================== //
+
+    TextCanvas::TextCanvas(std::ostream& hFile, CellGlyphs glyphs) :
+        hFile(hFile), glyphs(glyphs)
+    {}
+
+    std::pair<int, int> TextCanvas::getDotsPerCell(CellGlyphs glyphs)
+    {
+        switch (glyphs)
+        {
+            // *INDENT-OFF*
+            case CellGlyphs::Characters:    return {1, 1};
+            case CellGlyphs::Blocks:        return {2, 2};
+            case CellGlyphs::Braille:       return {2, 4};
+            // *INDENT-ON*
+        }
+
+        return {1, 1};
+    }
+
+    void TextCanvas::beginPage(double width, double height, const Color&)
+    {
+        const auto [dx, dy] = getDotsPerCell(glyphs);
+
+        columns = static_cast<size_t>(std::max(1., std::ceil(width  / dx)));
+        rows    = static_cast<size_t>(std::max(1., std::ceil(height / dy)));
+
+        this->width  = columns * dx;
+        this->height = rows    * dy;
+
+        dots .assign(this->width * this->height, false);
+        texts.assign(columns * rows, std::string());
+        clipStack.clear();
+    }
+
+    void TextCanvas::endPage()
+    {
+        for (size_t row = 0u; row < rows; ++row)
+        {
+            std::string line;
+            for (size_t column = 0u; column < columns; ++column)
+            {
+                const std::string& text = texts[row * columns + column];
+                line += (text.empty() ? getCellGlyph(column, row) : text);
+            }
+
+            line.erase(line.find_last_not_of(' ') + 1u);
+            hFile << line << '\n';
+        }
+    }
+
+    void TextCanvas::beginClip(double x, double y, double width, double height)
+    {
+        const ClipBox outer = getClipBox();
+        const ClipBox inner =
+        {
+            std::max(outer.left,   static_cast<int>(std::floor(x))),
+            std::max(outer.top,    static_cast<int>(std::floor(y))),
+            std::min(outer.right,  static_cast<int>(std::ceil (x + width))),
+            std::min(outer.bottom, static_cast<int>(std::ceil (y + height)))
+        };
+
+        clipStack.push_back(inner);
+    }
+
+    void TextCanvas::endClip()
+    {
+        // *INDENT-OFF*
+        if (!clipStack.empty()) {clipStack.pop_back();}
+        // *INDENT-ON*
+    }
+
+    void TextCanvas::beginPath(const Stroke&)
+    {
+        penDown = false;
+    }
+
+    void TextCanvas::moveTo(const CanvasPoint& point)
+    {
+        pen     = point;
+        penDown = true;
+    }
+
+    void TextCanvas::lineTo(const CanvasPoint& point)
+    {
+        // *INDENT-OFF*
+        if (penDown) {line(pen, point);}
+        // *INDENT-ON*
+
+        pen     = point;
+        penDown = true;
+    }
+
+    void TextCanvas::endPath()
+    {
+        penDown = false;
+    }
+
+    void TextCanvas::polygon(std::span<const CanvasPoint> points, const std::optional<Color>& fill, const std::optional<Stroke>& stroke)
+    {
+        // *INDENT-OFF*
+        if (points.empty()) {return;}
+        // *INDENT-ON*
+
+        if (fill && fill->a >= 128u)
+        {
+            // even-odd scanline fill, sampling each dot at its center
+            const ClipBox clip = getClipBox();
+            std::vector<double> crossings;
+
+            for (int y = clip.top; y < clip.bottom; ++y)
+            {
+                const double center = y + .5;
+
+                crossings.clear();
+                for (size_t i = 0u; i < points.size(); ++i)
+                {
+                    const auto& a = points[i];
+                    const auto& b = points[(i + 1u) % points.size()];
+
+                    // *INDENT-OFF*
+                    if ((a.y <= center) == (b.y <= center)) {continue;}
+                    // *INDENT-ON*
+                    crossings.push_back(a.x + (center - a.y) / (b.y - a.y) * (b.x - a.x));
+                }
+                std::sort(crossings.begin(), crossings.end());
+
+                for (size_t i = 0u; i + 1u < crossings.size(); i += 2u)
+                {
+                    const int first = std::max(clip.left,  static_cast<int>(std::max(-1e6, std::ceil (crossings[i]      - .5))));
+                    const int last  = std::min(clip.right, static_cast<int>(std::min( 1e6, std::floor(crossings[i + 1u] - .5)) + 1));
+                    for (int x = first; x < last; ++x)
+                    {
+                        setDot(x, y);
+                    }
+                }
+            }
+        }
+
+        if (stroke)
+        {
+            for (size_t i = 0u; i < points.size(); ++i)
+            {
+                line(points[i], points[(i + 1u) % points.size()]);
+            }
+        }
+    }
+
+    void TextCanvas::text(const CanvasPoint& position, const std::string& text, const TextStyle& style)
+    {
+        const auto [dx, dy]   = getDotsPerCell(glyphs);
+        const auto characters = splitCharacters(text);
+        const auto length     = static_cast<double>(characters.size());
+
+        // the cell whose bottom edge is closest below the baseline
+        const double column = position.x / dx;
+        const double row    = std::ceil(position.y / dy) - 1.;
+
+        // *INDENT-OFF*
+        const double offset = (style.anchor == TextAnchor::Start ? 0. : (style.anchor == TextAnchor::Middle ? length / 2. : length));
+        // *INDENT-ON*
+
+        if (std::abs(std::remainder(style.rotate, 360.)) >= 45.)
+        {
+            // vertical text reads upwards, centred on the row like a rotated label
+            const double bottom = std::round(position.y / dy - .5 + offset);
+            for (size_t i = 0u; i < characters.size(); ++i)
+            {
+                const double r = bottom - i;
+                // *INDENT-OFF*
+                if (r >= 0. && column >= 0.) {putText(static_cast<size_t>(column), static_cast<size_t>(r), characters[i]);}
+                // *INDENT-ON*
+            }
+            return;
+        }
+
+        const double first = std::round(column - offset);
+        for (size_t i = 0u; i < characters.size(); ++i)
+        {
+            // *INDENT-OFF*
+            if (first + i >= 0. && row >= 0.) {putText(static_cast<size_t>(first + i), static_cast<size_t>(row), characters[i]);}
+            // *INDENT-ON*
+        }
+    }
+
+    void TextCanvas::marker(const CanvasPoint& center, PointForm form, double, const Stroke&)
+    {
+        const int x = static_cast<int>(std::floor(center.x));
+        const int y = static_cast<int>(std::floor(center.y));
+
+        // *INDENT-OFF*
+        if (form == PointForm::None || form == PointForm::Custom) {return;}
+        // *INDENT-ON*
+
+        setDot(x, y);
+
+        // markers are a few dots at most; with one dot per cell, they cannot be told from the lines
+        if (glyphs != CellGlyphs::Characters && form != PointForm::Point)
+        {
+            setDot(x - 1, y);
+            setDot(x + 1, y);
+            setDot(x, y - 1);
+            setDot(x, y + 1);
+        }
+    }
+
+    double TextCanvas::getTextWidth(const std::string& text, const TextStyle&) const
+    {
+        return splitCharacters(text).size() * getDotsPerCell(glyphs).first;
+    }
+
+    std::optional<double> TextCanvas::getFixedTextSize() const
+    {
+        return getDotsPerCell(glyphs).second;
+    }
+}
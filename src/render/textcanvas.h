@@ -0,0 +1,79 @@
+#ifndef TEXTCANVAS_H
+#define TEXTCANVAS_H
+
+#include <ostream>
+#include <vector>
+
+#include "canvas.h"
+
+namespace Plotypus
+{
+    /**
+     * @brief Canvas writing a page of character cells to a stream.
+     *
+     * Graphics are drawn as dots, several per cell depending on the CellGlyphs (see getDotsPerCell);
+     * coordinates are given in dots. Lines are one dot wide, translucent fills are left empty, colours
+     * and dash patterns are ignored. Text occupies one cell per character, replacing the dots there;
+     * rotated text is written from bottom to top. The page is written to the stream by endPage, as
+     * lines without trailing blanks.
+     */
+    class TextCanvas : public Canvas
+    {
+        private:
+            struct ClipBox
+            {
+                int left, top, right, bottom;
+            };
+
+            std::ostream&               hFile;
+            const CellGlyphs            glyphs;
+
+            int                         width   = 0;        // in dots
+            int                         height  = 0;
+            size_t                      columns = 0u;
+            size_t                      rows    = 0u;
+
+            std::vector<bool>           dots;
+            std::vector<std::string>    texts;              // per cell; empty where dots are shown
+            std::vector<ClipBox>        clipStack;
+
+            bool                        penDown = false;
+            CanvasPoint                 pen;
+
+            ClipBox getClipBox() const;
+
+            void setDot(int x, int y);
+            bool getDot(int x, int y) const;
+            void line(CanvasPoint p0, CanvasPoint p1);
+            void putText(size_t column, size_t row, const std::string& character);
+
+            std::string getCellGlyph(size_t column, size_t row) const;
+
+        public:
+            TextCanvas(std::ostream& hFile, CellGlyphs glyphs = CellGlyphs::Characters);
+
+            //! @brief returns the number of dots per cell horizontally and vertically.
+            static std::pair<int, int> getDotsPerCell(CellGlyphs glyphs);
+
+            virtual void beginPage(double width, double height, const Color& background);
+            virtual void endPage();
+
+            virtual void beginClip(double x, double y, double width, double height);
+            virtual void endClip();
+
+            virtual void beginPath(const Stroke& stroke);
+            virtual void moveTo(const CanvasPoint& point);
+            virtual void lineTo(const CanvasPoint& point);
+            virtual void endPath();
+
+            virtual void polygon(std::span<const CanvasPoint> points, const std::optional<Color>& fill, const std::optional<Stroke>& stroke);
+            virtual void text(const CanvasPoint& position, const std::string& text, const TextStyle& style);
+
+            virtual void marker(const CanvasPoint& center, PointForm form, double size, const Stroke& stroke);
+
+            virtual double getTextWidth(const std::string& text, const TextStyle& style) const;
+            virtual std::optional<double> getFixedTextSize() const;
+    };
+}
+
+#endif // TEXTCANVAS_H
@@ -140,7 +140,33 @@ int main()
     ADD_UNITTEST(unittest_report_basicSheetManagement);
     ADD_UNITTEST(unittest_report_emptyScriptOutput);
     ADD_UNITTEST(unittest_report_sheets_scriptOutput);
+    ADD_UNITTEST(unittest_report_parallelDatExport);
+    ADD_UNITTEST(unittest_report_skipUnchangedOutput);
+    ADD_UNITTEST(unittest_report_memoryFileTransport);
+    ADD_UNITTEST(unittest_report_inlineData);
+    ADD_UNITTEST(unittest_report_persistentGnuplot);
+    ADD_UNITTEST(unittest_report_asyncGnuplot);
+    ADD_UNITTEST(unittest_report_renderFarm);
+    ADD_UNITTEST(unittest_report_parallelPages);
+    ADD_UNITTEST(unittest_report_pdfMerging);
+    ADD_UNITTEST(unittest_report_renderToMemory);
+    ADD_UNITTEST(unittest_report_nativeSvg);
+    ADD_UNITTEST(unittest_report_nativePng);
+    ADD_UNITTEST(unittest_report_nativeAscii);
+    ADD_UNITTEST(unittest_report_renderer);
+    ADD_UNITTEST(unittest_report_dataArchive);
     ADD_UNITTEST(unittest_sheets_labels);
+    ADD_UNITTEST(unittest_dataview_blockExport);
+    ADD_UNITTEST(unittest_dataview_staticCompound);
+    ADD_UNITTEST(unittest_dataview_rawExport);
+    ADD_UNITTEST(unittest_dataview_columnDataTypes);
+    ADD_UNITTEST(unittest_dataview_asciiExport);
+    ADD_UNITTEST(unittest_dataview_chunkedExport);
+    ADD_UNITTEST(unittest_dataview_mappedExport);
+    ADD_UNITTEST(unittest_dataview_decimation);
+    ADD_UNITTEST(unittest_dataview_deduplicateData);
+    ADD_UNITTEST(unittest_dataview_statistics);
+    ADD_UNITTEST(unittest_dataview_culling);
 
     std::cout << "DONE" << std::endl << std::endl;
 
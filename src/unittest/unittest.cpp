@@ -2,6 +2,7 @@
 // Depenencies
 
 #include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <stdexcept>
 #include <string>
@@ -110,3 +111,24 @@ bool unittest_string_compare_by_lines(const std::string& lhs, const std::string&
     // *INDENT-OFF*
     return false;
 }
+
+fs::path unittest_makeTempDirectory(const std::string& name)
+{
+    const fs::path directory = fs::temp_directory_path() / ("plotypus_unittest_" + name);
+    fs::remove_all(directory);
+    fs::create_directories(directory);
+
+    return directory;
+}
+
+fs::path unittest_makeFakeGnuplot(const fs::path& directory, const std::string& body)
+{
+    const fs::path executable = directory / "fakeplot";
+    {
+        std::ofstream hFile(executable);
+        hFile << "#!/bin/sh\n" << body;
+    }
+    fs::permissions(executable, fs::perms::owner_all);
+
+    return executable;
+}
@@ -30,6 +30,7 @@ bool unittest_foobar()
 // ========================================================================== //
 // dependencies
 
+#include <filesystem>
 #include <stdexcept>
 
 #include <string>
@@ -170,4 +171,9 @@ void unittest_show_summary(const unittest_list_t& unittest_list, const std::vect
 
 bool unittest_string_compare_by_lines(const std::string& lhs, const std::string& rhs);
 
+//! @brief creates the empty directory `plotypus_unittest_<name>` in the system temporary directory, replacing a leftover one, and returns its path
+std::filesystem::path unittest_makeTempDirectory(const std::string& name);
+//! @brief writes the shell script `body` to the executable `directory/fakeplot`, a stand-in for gnuplot, and returns its path
+std::filesystem::path unittest_makeFakeGnuplot(const std::filesystem::path& directory, const std::string& body);
+
 #endif // UNITTESTMACROS_H
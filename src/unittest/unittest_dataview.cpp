@@ -0,0 +1,883 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "unittest.h"
+#include "../plotypus.h"
+
+namespace fs = std::filesystem;
+
+// ========================================================================== //
+// helpers
+
+namespace
+{
+    struct unittest_record_t
+    {
+        double x, y, dy;
+    };
+
+    std::vector<unittest_record_t> unittest_generateRecords(const size_t N)
+    {
+        std::vector<unittest_record_t> result(N);
+        for (size_t i = 0u; auto& record : result)
+        {
+            record.x  = i;
+            record.y  = i * 0.5;
+            record.dy = 0.25;
+            ++i;
+        }
+        return result;
+    }
+
+    //! @brief view whose content fingerprint collides with that of every other one
+    class unittest_collidingDataView : public Plotypus::DataView2DCompound<double>
+    {
+        public:
+            using Plotypus::DataView2DCompound<double>::DataView2DCompound;
+
+            std::optional<uint64_t> getContentFingerprint() const
+            {
+                return 0u;
+            }
+    };
+
+    std::string unittest_tempFilename(const std::string& name)
+    {
+        return (fs::temp_directory_path() / ("plotypus_unittest_" + name)).string();
+    }
+
+    std::string unittest_readFile(const std::string& filename)
+    {
+        std::ifstream hFile(filename, std::ios::binary);
+        std::stringstream buffer;
+        buffer << hFile.rdbuf();
+        return buffer.str();
+    }
+
+    template<class T>
+    std::vector<T> unittest_readBinaryFile(const std::string& filename)
+    {
+        const std::string content = unittest_readFile(filename);
+        std::vector<T> result(content.size() / sizeof(T));
+        std::memcpy(result.data(), content.data(), result.size() * sizeof(T));
+        return result;
+    }
+}
+
+// ========================================================================== //
+// procs
+
+bool unittest_dataview_blockExport()
+{
+    std::cout << "TESTING DATAVIEW BLOCK-WISE DATA EXPORT" << std::endl;
+
+    UNITTEST_VARS;
+
+    const size_t N = 2 * Plotypus::DATA_BLOCK_SIZE + 17;        // partial last block
+    auto records = unittest_generateRecords(N);
+    const std::string filename = unittest_tempFilename("block.dat");
+
+    // ...................................................................... //
+
+    Plotypus::DataView2DCompound<unittest_record_t> compound(Plotypus::PlotStyle2D::YErrorBars);
+    compound.setData(records);
+    compound.setSelector(Plotypus::ColumnType::X,      [] (const unittest_record_t& r) {return r.x;});
+    compound.setSelector(Plotypus::ColumnType::Y,      [] (const unittest_record_t& r) {return r.y;});
+    compound.setSelector(Plotypus::ColumnType::DeltaY, [] (const unittest_record_t& r) {return r.dy;});
+    compound.setDataFilename(filename);
+
+    UNITTEST_DOESNT_THROW(compound.writeDatData(), std::exception, "write binary data of compound view");
+
+    auto values = unittest_readBinaryFile<double>(filename);
+    UNITTEST_ASSERT(values.size() == 3 * N, "write all records of compound view");
+    UNITTEST_ASSERT(values[3 * (N - 1)] == N - 1 && values[3 * (N - 1) + 1] == (N - 1) * 0.5 && values[3 * (N - 1) + 2] == 0.25,
+                    "write records in line-wise order");
+
+    compound.setBinaryDataOutput(false);
+    compound.writeDatData();
+    const std::string text = unittest_readFile(filename);
+    UNITTEST_ASSERT(std::count(text.begin(), text.end(), '\n') == N, "write one line per record in ASCII mode");
+    UNITTEST_ASSERT(text.starts_with("0\t0\t0.25\t\n1\t0.5\t0.25\t\n"), "write ASCII records in order");
+
+    // ...................................................................... //
+
+    std::vector<double> ys(N);
+    for (size_t i = 0u; auto& y : ys) {y = 2. * i++;}
+
+    Plotypus::DataView2DSeparate separate(Plotypus::PlotStyle2D::Lines);
+    separate.data(Plotypus::ColumnType::Y) = ys;
+    separate.setDataFilename(filename);
+
+    UNITTEST_DOESNT_THROW(separate.writeDatData(), std::exception, "write binary data of separate view");
+
+    values = unittest_readBinaryFile<double>(filename);
+    UNITTEST_ASSERT(values.size() == N, "write single column without X column");
+    UNITTEST_ASSERT(values == ys, "write values of separate view unchanged");
+
+    // ...................................................................... //
+
+    fs::remove(filename);
+
+    UNITTEST_FINALIZE;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool unittest_dataview_staticCompound()
+{
+    std::cout << "TESTING STATICALLY TYPED COMPOUND DATAVIEW" << std::endl;
+
+    UNITTEST_VARS;
+
+    const size_t N = Plotypus::DATA_BLOCK_SIZE + 5;
+    auto records = unittest_generateRecords(N);
+    const std::string filenameDynamic = unittest_tempFilename("dynamic.dat");
+    const std::string filenameStatic  = unittest_tempFilename("static.dat");
+
+    Plotypus::PlotWithAxes plot("static views");
+
+    // ...................................................................... //
+
+    auto& dynamicView = plot.addDataViewCompound<unittest_record_t>(records, [] (const unittest_record_t& r) {return r.y;}, Plotypus::PlotStyle2D::YErrorBars);
+    dynamicView.setSelector(Plotypus::ColumnType::X,      [] (const unittest_record_t& r) {return r.x;});
+    dynamicView.setSelector(Plotypus::ColumnType::DeltaY, [] (const unittest_record_t& r) {return r.dy;});
+    dynamicView.setDataFilename(filenameDynamic);
+
+    auto& staticView = plot.addDataViewCompound<unittest_record_t,
+                                                &unittest_record_t::x,
+                                                &unittest_record_t::y,
+                                                [] (const unittest_record_t& r) {return r.dy;}>
+                       (records, Plotypus::PlotStyle2D::YErrorBars);
+    staticView.setDataFilename(filenameStatic);
+
+    UNITTEST_ASSERT(plot.getDataViews().size() == 2, "add static view alongside dynamic view");
+    UNITTEST_ASSERT(staticView.isComplete(), "recognize three static selectors as complete for y error bars");
+
+    UNITTEST_DOESNT_THROW(plot.writeDatData(), std::exception, "write data of static and dynamic view");
+    UNITTEST_ASSERT(unittest_readFile(filenameDynamic) == unittest_readFile(filenameStatic), "produce identical data files");
+
+    // ...................................................................... //
+
+    Plotypus::DataView2DCompoundStatic<unittest_record_t, &unittest_record_t::y> yOnly(Plotypus::PlotStyle2D::Lines);
+    yOnly.setData(records);
+    yOnly.setDataFilename(filenameStatic);
+    yOnly.writeDatData();
+
+    const auto values = unittest_readBinaryFile<double>(filenameStatic);
+    UNITTEST_ASSERT(values.size() == N && values[N - 1] == (N - 1) * 0.5, "write lone selector as Y column");
+
+    yOnly.columnAssignment(2) = 3;
+    UNITTEST_THROWS(yOnly.writeDatData(), Plotypus::PlotypusError, "reject columns without selector");
+
+    Plotypus::DataView2DCompoundStatic<unittest_record_t, &unittest_record_t::x, &unittest_record_t::y> xy(Plotypus::PlotStyle2D::Points);
+    xy.setData(records);
+    xy.setDataFilename(filenameStatic);
+    xy.columnAssignment(Plotypus::ColumnType::X) = Plotypus::COLUMN_UNUSED;
+    xy.writeDatData();
+
+    const auto withoutX = unittest_readBinaryFile<double>(filenameStatic);
+    UNITTEST_ASSERT(withoutX.size() == N && withoutX[N - 1] == (N - 1) * 0.5, "leave out unused columns according to column plan");
+
+    // ...................................................................... //
+
+    fs::remove(filenameDynamic);
+    fs::remove(filenameStatic);
+
+    UNITTEST_FINALIZE;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool unittest_dataview_rawExport()
+{
+    std::cout << "TESTING DATAVIEW RAW RECORD EXPORT" << std::endl;
+
+    UNITTEST_VARS;
+
+    struct telemetry_t
+    {
+        double  time;
+        int     channel;
+        double  value;
+        double  error;
+        char    flags[5];
+    };
+
+    std::vector<telemetry_t> records(100);
+    for (size_t i = 0u; auto& record : records)
+    {
+        record = {1. * i, 3, 2. * i, 0.5, "abc"};
+        ++i;
+    }
+
+    const std::string filename = unittest_tempFilename("raw.dat");
+    Plotypus::StylesCollection stylesCollection;
+    std::stringstream script;
+
+    // ...................................................................... //
+
+    Plotypus::DataView2DCompound<telemetry_t> view(Plotypus::PlotStyle2D::YErrorBars);
+    view.setData(records);
+    view.setSelector(Plotypus::ColumnType::X,      &telemetry_t::time);
+    view.setSelector(Plotypus::ColumnType::Y,      &telemetry_t::error);
+    view.setSelector(Plotypus::ColumnType::DeltaY, &telemetry_t::value);
+    view.setDataFilename(filename);
+    view.setRawDataOutput(true);
+
+    view.writeDatData();
+    const std::string content = unittest_readFile(filename);
+    UNITTEST_ASSERT(content.size() == records.size() * sizeof(telemetry_t) &&
+                    std::memcmp(content.data(), records.data(), content.size()) == 0,
+                    "write records unchanged");
+
+    view.writeScriptData(script, stylesCollection);
+    const std::string expectedSpec =
+        "binary record=100 format=\"%float64%*8uint8%float64%float64%*" + std::to_string(sizeof(telemetry_t) - 32) + "uint8\" "
+        "using 1:3:2 ";
+    UNITTEST_ASSERT(script.str().find(expectedSpec) != std::string::npos, "describe record layout and column order in script");
+
+    // ...................................................................... //
+
+    view.setSelector(Plotypus::ColumnType::DeltaY, [] (const telemetry_t& r) {return r.value * 2;});
+    view.writeDatData();
+    UNITTEST_ASSERT(unittest_readFile(filename).size() == records.size() * 3 * sizeof(double), "fall back to packed output for general selectors");
+
+    script.str("");
+    view.writeScriptData(script, stylesCollection);
+    UNITTEST_ASSERT(script.str().find("binary format=\"%float64\" using 1:2:3 ") != std::string::npos, "fall back to packed format in script");
+
+    // ...................................................................... //
+
+    fs::remove(filename);
+
+    UNITTEST_FINALIZE;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool unittest_dataview_columnDataTypes()
+{
+    std::cout << "TESTING DATAVIEW COLUMN DATA TYPES" << std::endl;
+
+    UNITTEST_VARS;
+
+    const size_t N = Plotypus::DATA_BLOCK_SIZE + 3;
+    std::vector<double> xs(N), ys(N), dys(N);
+    for (size_t i = 0u; i < N; ++i)
+    {
+        xs [i] = i;                 // fits uint16
+        ys [i] = -0.5 * (i % 100);  // exact in float32
+        dys[i] = 0.1;               // needs float64
+    }
+
+    const std::string filename = unittest_tempFilename("types.dat");
+    Plotypus::StylesCollection stylesCollection;
+    std::stringstream script;
+
+    // ...................................................................... //
+
+    Plotypus::DataView2DSeparate view(Plotypus::PlotStyle2D::YErrorBars);
+    view.setData({xs, ys, dys});
+    view.setDataFilename(filename);
+    view.columnDataType(Plotypus::ColumnType::X)      = Plotypus::ColumnDataType::Auto;
+    view.columnDataType(Plotypus::ColumnType::Y)      = Plotypus::ColumnDataType::Auto;
+    view.columnDataType(Plotypus::ColumnType::DeltaY) = Plotypus::ColumnDataType::Auto;
+
+    UNITTEST_DOESNT_THROW(view.writeDatData(), std::exception, "write narrowed binary data");
+
+    const std::string content = unittest_readFile(filename);
+    const size_t recordSize = sizeof(uint16_t) + sizeof(float) + sizeof(double);
+    UNITTEST_ASSERT(content.size() == N * recordSize, "write narrowed records");
+
+    uint16_t x;
+    float    y;
+    double   dy;
+    const char* last = content.data() + (N - 1) * recordSize;
+    std::memcpy(&x,  last, sizeof(x));
+    std::memcpy(&y,  last + sizeof(x), sizeof(y));
+    std::memcpy(&dy, last + sizeof(x) + sizeof(y), sizeof(dy));
+    UNITTEST_ASSERT(x == N - 1 && y == ys[N - 1] && dy == 0.1, "preserve values in narrowed records");
+
+    view.writeScriptData(script, stylesCollection);
+    UNITTEST_ASSERT(script.str().find("binary format=\"%uint16%float32%float64\" ") != std::string::npos, "describe narrowed types in script");
+
+    // ...................................................................... //
+
+    view.columnDataType(Plotypus::ColumnType::X)      = Plotypus::ColumnDataType::Int32;
+    view.columnDataType(Plotypus::ColumnType::DeltaY) = Plotypus::ColumnDataType::Float64;
+    ys[0] = 1e300;
+    view.writeDatData();
+    UNITTEST_ASSERT(unittest_readFile(filename).size() == N * (sizeof(int32_t) + 2 * sizeof(double)), "keep explicit types and widen inexact columns");
+
+    script.str("");
+    view.writeScriptData(script, stylesCollection);
+    UNITTEST_ASSERT(script.str().find("binary format=\"%int32%float64%float64\" ") != std::string::npos, "describe explicit types in script");
+
+    view.columnDataType(Plotypus::ColumnType::X) = Plotypus::ColumnDataType::Float32;
+    script.str("");
+    view.writeScriptData(script, stylesCollection);
+    UNITTEST_ASSERT(script.str().find("binary format=\"%float32%float64%float64\" ") != std::string::npos, "describe changed types in script");
+
+    // ...................................................................... //
+
+    std::vector<double> bytes = {0., 255.5, 17.};
+    Plotypus::DataView2DSeparate byteView(Plotypus::PlotStyle2D::Points);
+    byteView.setData({std::span<double>(bytes), std::span<double>(bytes)});
+    byteView.setDataFilename(filename);
+    byteView.columnDataType(Plotypus::ColumnType::X) = Plotypus::ColumnDataType::UInt8;
+
+    UNITTEST_DOESNT_THROW(byteView.writeDatData(), std::exception, "truncate values to integer column types");
+    UNITTEST_ASSERT(static_cast<uint8_t>(unittest_readFile(filename)[sizeof(uint8_t) + sizeof(double)]) == 255u, "write truncated value");
+
+    for (const double value : {300., -5., std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::infinity()})
+    {
+        bytes[2] = value;
+        UNITTEST_THROWS(byteView.writeDatData(), Plotypus::InvalidArgumentError, "reject values beyond the integer column type");
+    }
+
+    // ...................................................................... //
+
+    fs::remove(filename);
+
+    UNITTEST_FINALIZE;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool unittest_dataview_asciiExport()
+{
+    std::cout << "TESTING DATAVIEW ASCII EXPORT" << std::endl;
+
+    UNITTEST_VARS;
+
+    const size_t N = Plotypus::ASCII_BUFFER_SIZE / 8;           // several buffer flushes
+    std::vector<double> xs(N), ys(N);
+    for (size_t i = 0u; i < N; ++i)
+    {
+        xs[i] = 0.1 * i;
+        ys[i] = 1. / 3.;
+    }
+
+    const std::string filename = unittest_tempFilename("ascii.dat");
+
+    // ...................................................................... //
+
+    Plotypus::DataView2DSeparate view(Plotypus::PlotStyle2D::Lines);
+    view.setData({xs, ys});
+    view.setDataFilename(filename);
+    view.setBinaryDataOutput(false);
+    view.columnPrecision(Plotypus::ColumnType::Y) = 3;
+
+    UNITTEST_DOESNT_THROW(view.writeDatData(), std::exception, "write ASCII data with mixed precisions");
+
+    std::ifstream hFile(filename);
+    std::string line;
+    size_t lineCount = 0u;
+    bool roundTrip = true;
+    while (std::getline(hFile, line))
+    {
+        std::stringstream fields(line);
+        double x;
+        std::string y;
+        fields >> x >> y;
+        roundTrip &= (x == xs[lineCount]) && (y == "0.333");
+        ++lineCount;
+    }
+    UNITTEST_ASSERT(lineCount == N, "write one line per record across buffer flushes");
+    UNITTEST_ASSERT(roundTrip, "write shortest round-trip values and fixed precision values");
+
+    // ...................................................................... //
+
+    std::stringstream text;
+    view.columnHeadline(0) = "x";
+    view.columnHeadline(1) = "y";
+    view.writeTxtData(text);
+    UNITTEST_ASSERT(text.str().starts_with("x\ty\t\t\t\t\t\n0\t0.333\t\n0.1\t0.333\t\n"), "write headlines and records in text mode");
+
+    // ...................................................................... //
+
+    fs::remove(filename);
+
+    UNITTEST_FINALIZE;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool unittest_dataview_chunkedExport()
+{
+    std::cout << "TESTING DATAVIEW CHUNK-PARALLEL DATA EXPORT" << std::endl;
+
+    UNITTEST_VARS;
+
+    const size_t N = 5 * Plotypus::EXPORT_CHUNK_SIZE / 2 + 3;   // partial last chunk
+    auto records = unittest_generateRecords(N);
+    const std::string filenameSequential = unittest_tempFilename("sequential.dat");
+    const std::string filenameChunked    = unittest_tempFilename("chunked.dat");
+
+    Plotypus::DataView2DCompound<unittest_record_t> view(Plotypus::PlotStyle2D::YErrorBars);
+    view.setData(records);
+    view.setSelector(Plotypus::ColumnType::X,      [] (const unittest_record_t& r) {return r.x;});
+    view.setSelector(Plotypus::ColumnType::Y,      [] (const unittest_record_t& r) {return r.y;});
+    view.setSelector(Plotypus::ColumnType::DeltaY, [] (const unittest_record_t& r) {return r.dy;});
+
+    const auto compareOutputs = [&] ()
+    {
+        view.setExportThreadCount(1);
+        view.setDataFilename(filenameSequential);
+        view.writeDatData();
+
+        view.setExportThreadCount(4);
+        view.setDataFilename(filenameChunked);
+        view.writeDatData();
+
+        return unittest_readFile(filenameSequential) == unittest_readFile(filenameChunked);
+    };
+
+    // ...................................................................... //
+
+    view.setExportThreadCount(4);
+    view.setDataFilename(filenameChunked);
+    fs::remove(filenameChunked);
+    view.writeDatData();
+    UNITTEST_ASSERT(unittest_readFile(filenameChunked).size() == 3 * N * sizeof(double), "write sequentially unless selectors are declared thread-safe");
+
+    view.setSelectorsThreadSafe(true);
+    UNITTEST_ASSERT(compareOutputs(), "write binary chunks at their final offsets");
+
+    view.columnDataType(Plotypus::ColumnType::X) = Plotypus::ColumnDataType::Auto;
+    UNITTEST_ASSERT(compareOutputs(), "write narrowed binary chunks at their final offsets");
+
+    view.setBinaryDataOutput(false);
+    UNITTEST_ASSERT(compareOutputs(), "concatenate ASCII chunks in order");
+
+    // ...................................................................... //
+
+    fs::remove(filenameSequential);
+    fs::remove(filenameChunked);
+
+    UNITTEST_FINALIZE;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool unittest_dataview_mappedExport()
+{
+    std::cout << "TESTING DATAVIEW MEMORY-MAPPED DATA EXPORT" << std::endl;
+
+    UNITTEST_VARS;
+
+    const size_t N = Plotypus::EXPORT_CHUNK_SIZE + 7;
+    auto records = unittest_generateRecords(N);
+    const std::string filenameStream = unittest_tempFilename("stream.dat");
+    const std::string filenameMapped = unittest_tempFilename("mapped.dat");
+
+    Plotypus::DataView2DCompound<unittest_record_t> view(Plotypus::PlotStyle2D::YErrorBars);
+    view.setData(records);
+    view.setSelector(Plotypus::ColumnType::X,      [] (const unittest_record_t& r) {return r.x;});
+    view.setSelector(Plotypus::ColumnType::Y,      [] (const unittest_record_t& r) {return r.y;});
+    view.setSelector(Plotypus::ColumnType::DeltaY, [] (const unittest_record_t& r) {return r.dy;});
+
+    const auto compareOutputs = [&] ()
+    {
+        view.setMappedDataOutput(false);
+        view.setDataFilename(filenameStream);
+        view.writeDatData();
+
+        view.setMappedDataOutput(true);
+        view.setDataFilename(filenameMapped);
+        view.writeDatData();
+
+        return unittest_readFile(filenameStream) == unittest_readFile(filenameMapped);
+    };
+
+    // ...................................................................... //
+
+    UNITTEST_ASSERT(compareOutputs(), "write float64 records into mapping");
+
+    view.columnDataType(Plotypus::ColumnType::Y) = Plotypus::ColumnDataType::Auto;
+    UNITTEST_ASSERT(compareOutputs(), "write narrowed records into mapping");
+
+    view.setSelectorsThreadSafe(true);
+    view.setExportThreadCount(3);
+    UNITTEST_ASSERT(compareOutputs(), "write chunks into mapping concurrently");
+
+    UNITTEST_ASSERT(fs::file_size(filenameMapped) == N * (2 * sizeof(double) + sizeof(float)), "preallocate exact file size");
+
+    // ...................................................................... //
+
+    fs::remove(filenameStream);
+    fs::remove(filenameMapped);
+
+    UNITTEST_FINALIZE;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool unittest_dataview_decimation()
+{
+    std::cout << "TESTING DATAVIEW M4 DECIMATION" << std::endl;
+
+    UNITTEST_VARS;
+
+    const size_t N = 100000;
+    std::vector<double> xs(N), ys(N);
+    for (size_t i = 0u; i < N; ++i)
+    {
+        xs[i] = i;
+        ys[i] = (i % 7) * 0.1;
+    }
+    ys[54321] = 100.;
+    ys[12345] = -100.;
+
+    const std::string filename = unittest_tempFilename("decimated.dat");
+
+    Plotypus::PlotWithAxes plot("decimation");
+    auto& view = plot.addDataViewCompound<double>(std::span<double>(ys), [] (const double& y) {return y;});
+    view.setSelector(Plotypus::ColumnType::X, [&ys, &xs] (const double& y) {return xs[&y - ys.data()];});
+    view.setDataFilename(filename);
+
+    // ...................................................................... //
+
+    view.setDecimationPixels(100);
+    view.writeDatData();
+
+    auto values = unittest_readBinaryFile<double>(filename);
+    const size_t recordCount = values.size() / 2;
+    UNITTEST_ASSERT(recordCount <= 4 * 102 && recordCount >= 2 * 100, "keep up to four records per pixel column");
+    UNITTEST_ASSERT(values[0] == 0. && values[2 * recordCount - 2] == N - 1, "keep first and last record");
+
+    bool ascending = true, hasMaximum = false, hasMinimum = false;
+    for (size_t r = 0u; r < recordCount; ++r)
+    {
+        ascending  &= (r == 0u || values[2 * r] > values[2 * r - 2]);
+        hasMaximum |= (values[2 * r] == 54321. && values[2 * r + 1] ==  100.);
+        hasMinimum |= (values[2 * r] == 12345. && values[2 * r + 1] == -100.);
+    }
+    UNITTEST_ASSERT(ascending, "keep records in original order");
+    UNITTEST_ASSERT(hasMaximum && hasMinimum, "keep extrema of each pixel column");
+
+    // ...................................................................... //
+
+    view.setDecimationRange(40000., 60000.);
+    view.writeDatData();
+    values = unittest_readBinaryFile<double>(filename);
+    UNITTEST_ASSERT(values.size() / 2 <= 4 * 102 && values[0] == 0. && values[values.size() - 2] == N - 1, "bucket records outside the range");
+
+    view.setStyleID(Plotypus::PlotStyle2D::Points);
+    view.writeDatData();
+    UNITTEST_ASSERT(unittest_readBinaryFile<double>(filename).size() == 2 * N, "leave point styles undecimated");
+
+    view.setStyleID(Plotypus::PlotStyle2D::Lines);
+    view.setDecimationPixels(0);
+    view.writeDatData();
+    UNITTEST_ASSERT(unittest_readBinaryFile<double>(filename).size() == 2 * N, "write all records without pixel budget");
+
+    plot.xAxis().rangeMin = 0.;
+    plot.xAxis().rangeMax = N;
+    plot.applyAutoDecimation(50);
+    view.writeDatData();
+    UNITTEST_ASSERT(unittest_readBinaryFile<double>(filename).size() <= 2 * 4 * 52, "apply pixel budget of plot to its views");
+    UNITTEST_ASSERT(view.getDecimationPixels() == 0u, "leave decimation settings of view untouched");
+
+    view.setDecimationPixels(100);
+    view.writeDatData();
+    UNITTEST_ASSERT(unittest_readBinaryFile<double>(filename).size() > 2 * 4 * 52, "prefer pixel budget of view");
+    view.setDecimationPixels(0);
+
+    plot.applyAutoDecimation(0);
+    view.writeDatData();
+    UNITTEST_ASSERT(unittest_readBinaryFile<double>(filename).size() == 2 * N, "stop decimation when disabled");
+
+    Plotypus::Report r(Plotypus::FileType::Png);
+    r.setVerbose(false);
+    r.setAutoRunScript(false);
+    r.setOutputDirectory(fs::path(filename).parent_path().string());
+    r.setAutoDecimation(true);
+    r.terminalInfoProvider().setDimensions(50, 50);
+
+    auto& autoPlot = r.addPlotWithAxes();
+    auto& autoView = autoPlot.addDataViewCompound<double>(std::span<double>(ys), [] (const double& y) {return y;});
+    r.writeDat();
+    UNITTEST_ASSERT(fs::file_size(autoView.getDataFilename()) <= 2 * 4 * 52 * sizeof(double), "decimate to the output width");
+
+    autoPlot.setPolar(true);
+    const auto axes = autoPlot.getAxes();
+    r.writeDat();
+    UNITTEST_ASSERT(autoPlot.getAxes().size() == axes.size(), "add no axis to the plot");
+    UNITTEST_ASSERT(fs::file_size(autoView.getDataFilename()) == N * sizeof(double), "leave polar plots undecimated");
+    fs::remove(autoView.getDataFilename());
+
+    // ...................................................................... //
+
+    fs::remove(filename);
+
+    UNITTEST_FINALIZE;
+}
+
+bool unittest_dataview_deduplicateData()
+{
+    std::cout << "TESTING DATAVIEW DEDUPLICATION" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("dedup");
+
+    // ...................................................................... //
+
+    std::vector<double> ys     = {1., 4., 2., 3.};
+    std::vector<double> copy   = ys;
+    std::vector<double> others = {5., 6.};
+    const auto          selectY = [] (const double& y) {return y;};
+
+    Plotypus::Report r;
+    r.setVerbose(false);
+    r.setAutoRunScript(false);
+    r.setOutputDirectory(directory.string());
+    r.setDeduplicateData(true);
+
+    auto& overview = r.addPlotWithAxes();
+    auto& original = overview.addDataViewCompound<double>(std::span<double>(ys), selectY);
+    overview.addDataViewCompound<double>(std::span<double>(others), selectY);
+
+    auto& zoomed = r.addPlotWithAxes();
+    auto& same   = zoomed.addDataViewCompound<double>(std::span<double>(copy), selectY, Plotypus::PlotStyle2D::Points);
+    auto& ascii  = zoomed.addDataViewCompound<double>(std::span<double>(ys), selectY);
+    ascii.setBinaryDataOutput(false);
+
+    r.writeDat();
+    r.writeScript();
+
+    UNITTEST_ASSERT(same.getDataFilename() == original.getDataFilename(), "share data file of identical data");
+    UNITTEST_ASSERT(ascii.getDataFilename() != original.getDataFilename(), "tell data layouts apart");
+    UNITTEST_ASSERT(r.getExportSummary().sharedDataViews == 1u && r.getExportSummary().writtenDataFiles.size() == 3u, "write shared data once");
+
+    std::ifstream hScript(directory / "report.gnuplot");
+    const std::string script((std::istreambuf_iterator<char>(hScript)), std::istreambuf_iterator<char>());
+    const std::string reference = "\"" + original.getDataFilename() + "\" binary";
+    UNITTEST_ASSERT(script.find(reference) != script.rfind(reference), "refer to shared data file in script");
+
+    copy[0] = 0.;
+    r.writeDat();
+    UNITTEST_ASSERT(same.getDataFilename() != original.getDataFilename() && fs::exists(same.getDataFilename()), "stop sharing after change");
+
+    r.setDeduplicateData(false);
+    copy[0] = ys[0];
+    r.writeDat();
+    UNITTEST_ASSERT(same.getDataFilename() != original.getDataFilename(), "share nothing when disabled");
+
+    // ...................................................................... //
+
+    Plotypus::Report collisions;
+    collisions.setVerbose(false);
+    collisions.setAutoRunScript(false);
+    collisions.setOutputDirectory(directory.string());
+    collisions.setFilenameBase("collisions");
+    collisions.setDeduplicateData(true);
+
+    std::vector<unittest_collidingDataView*> colliding;
+    for (auto data : {&ys, &others, &copy})
+    {
+        colliding.push_back(new unittest_collidingDataView(Plotypus::PlotStyle2D::Lines));
+        colliding.back()->setData(std::span<double>(*data));
+        colliding.back()->setSelector(Plotypus::ColumnType::Y, selectY);
+        collisions.addPlotWithAxes().addDataViewCompound<double>(colliding.back());
+    }
+
+    collisions.writeDat();
+    UNITTEST_ASSERT(colliding[1]->getDataFilename() != colliding[0]->getDataFilename(), "keep data files apart despite colliding fingerprints");
+    UNITTEST_ASSERT(colliding[2]->getDataFilename() == colliding[0]->getDataFilename(), "share data file after comparing the data");
+    UNITTEST_ASSERT(unittest_readBinaryFile<double>(colliding[1]->getDataFilename()) == others, "write data of colliding view");
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
+
+bool unittest_dataview_statistics()
+{
+    std::cout << "TESTING DATAVIEW STATISTICS" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("statistics");
+
+    // ...................................................................... //
+
+    const double        nan = std::numeric_limits<double>::quiet_NaN();
+    const double        inf = std::numeric_limits<double>::infinity();
+    std::vector<double> xs  = {1., 2., nan, 4., 8.};
+    std::vector<double> ys  = {3., -inf, 0.5, -2., inf};
+
+    Plotypus::DataView2DSeparate view(Plotypus::PlotStyle2D::Lines);
+    view.setData({std::span<double>(xs), std::span<double>(ys)});
+
+    const auto x = view.getStatistics(Plotypus::ColumnType::X);
+    const auto y = view.getStatistics(Plotypus::ColumnType::Y);
+    UNITTEST_ASSERT(x.min == 1. && x.max == 8. && x.count == 4u && x.nanCount == 1u && x.ascending, "summarize X column");
+    UNITTEST_ASSERT(y.min == -2. && y.max == 3. && y.count == 3u && y.infCount == 2u && !y.ascending, "summarize Y column");
+
+    xs[0] = 16.;
+    UNITTEST_ASSERT(view.getStatistics(Plotypus::ColumnType::X).max == 8., "keep statistics until invalidated");
+    view.invalidateStatistics();
+    UNITTEST_ASSERT(view.getStatistics(Plotypus::ColumnType::X).max == 16., "recompute statistics when invalidated");
+
+    std::vector<double> large(3 * Plotypus::DATA_BLOCK_SIZE + 7u);
+    std::iota(large.begin(), large.end(), -3.);
+    Plotypus::DataView2DCompound<double> compound(Plotypus::PlotStyle2D::Lines);
+    compound.setData(std::span<double>(large));
+    compound.setSelector(Plotypus::ColumnType::Y, [] (const double& v) {return v;});
+    const auto index = compound.getStatistics(Plotypus::ColumnType::X);
+    const auto value = compound.getStatistics(Plotypus::ColumnType::Y);
+    UNITTEST_ASSERT(index.min == 0. && index.max == large.size() - 1. && index.count == large.size(), "count records of missing X column");
+    UNITTEST_ASSERT(value.min == -3. && value.max == large.back() && value.ascending, "summarize across blocks");
+
+    large[Plotypus::DATA_BLOCK_SIZE] = -10.;
+    compound.setData(std::span<double>(large));
+    UNITTEST_ASSERT(!compound.getStatistics(Plotypus::ColumnType::Y).ascending, "detect descent at block border after setData");
+
+    // ...................................................................... //
+
+    std::vector<double> curve = {2., 5., 3.};
+
+    Plotypus::Report r;
+    r.setVerbose(false);
+    r.setAutoRunScript(false);
+    r.setOutputDirectory(directory.string());
+
+    auto& plot = r.addPlotWithAxes();
+    plot.addDataViewCompound<double>(std::span<double>(curve), [] (const double& v) {return v;});
+    plot.xAxis();
+    plot.yAxis().rangeMax = 10.;
+    plot.setConcreteAutoRanges(true);
+    r.writeScript();
+
+    std::ifstream hScript(directory / "report.gnuplot");
+    std::string script((std::istreambuf_iterator<char>(hScript)), std::istreambuf_iterator<char>());
+    UNITTEST_ASSERT(script.find("set xrange  [0:2]") != std::string::npos, "write concrete X range");
+    UNITTEST_ASSERT(script.find("set yrange  [2:10]") != std::string::npos, "write concrete lower Y limit");
+
+    curve[0] = -4.;
+    r.writeScript();
+    hScript = std::ifstream(directory / "report.gnuplot");
+    script  = std::string((std::istreambuf_iterator<char>(hScript)), std::istreambuf_iterator<char>());
+    UNITTEST_ASSERT(script.find("set yrange  [-4:10]") != std::string::npos, "refresh concrete ranges after changes in client memory");
+
+    plot.addDataViewCompound<double>("sin(x)");
+    r.writeScript();
+    hScript = std::ifstream(directory / "report.gnuplot");
+    script  = std::string((std::istreambuf_iterator<char>(hScript)), std::istreambuf_iterator<char>());
+    UNITTEST_ASSERT(script.find("set xrange  [*:*]") != std::string::npos, "keep autoscaling with functions");
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
+
+bool unittest_dataview_culling()
+{
+    std::cout << "TESTING DATAVIEW CULLING" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("culling");
+
+    // ...................................................................... //
+
+    const auto visitedXs = [] (const Plotypus::DataView2D& view)
+    {
+        std::vector<double> result;
+        view.visitRecords([&result] (std::span<const std::array<double, 6>> records)
+        {
+            for (const auto& record : records) {result.push_back(record[0]);}
+        });
+        return result;
+    };
+
+    std::vector<double> xs(1000u);
+    std::iota(xs.begin(), xs.end(), 0.);
+    std::vector<double> ys = xs;
+
+    Plotypus::DataView2DSeparate lines(Plotypus::PlotStyle2D::Lines);
+    lines.setData({std::span<double>(xs), std::span<double>(ys)});
+    lines.setCullingRange(100.5, 200.5);
+    auto visited = visitedXs(lines);
+    UNITTEST_ASSERT(visited.size() == 102u && visited.front() == 100. && visited.back() == 201., "keep neighbours of sorted lines");
+
+    Plotypus::DataView2DSeparate points(Plotypus::PlotStyle2D::Points);
+    points.setData({std::span<double>(xs), std::span<double>(ys)});
+    points.setCullingRange(100.5, 200.5);
+    visited = visitedXs(points);
+    UNITTEST_ASSERT(visited.size() == 100u && visited.front() == 101. && visited.back() == 200., "keep points in range only");
+
+    points.setCullingRange(2000., 3000.);
+    UNITTEST_ASSERT(visitedXs(points).size() == 1u, "keep one record if none is in range");
+
+    std::vector<double> unsortedXs = {0., 10., 5., -3., 20., 30., 31., 32., 6.};
+    std::vector<double> unsortedYs(unsortedXs.size());
+    lines.setData({std::span<double>(unsortedXs), std::span<double>(unsortedYs)});
+    lines.setCullingRange(4., 8.);
+    UNITTEST_ASSERT(visitedXs(lines) == std::vector<double>({0., 10., 5., -3., 20., 32., 6.}), "keep segments crossing the range of unsorted lines");
+
+    lines.setCullingRange(Plotypus::AXIS_AUTO_RANGE, Plotypus::AXIS_AUTO_RANGE);
+    UNITTEST_ASSERT(visitedXs(lines).size() == unsortedXs.size(), "keep all records without culling range");
+
+    std::vector<double> tenXs(10u);
+    std::iota(tenXs.begin(), tenXs.end(), 0.);
+    lines.setData({std::span<double>(tenXs), std::span<double>(ys.data(), tenXs.size())});
+    lines.setCullingRange(2., 4.);
+    UNITTEST_ASSERT(visitedXs(lines).size() == 5u, "cull ascending lines");
+
+    std::ranges::reverse(tenXs);
+    UNITTEST_ASSERT(visitedXs(lines) == std::vector<double>({5., 4., 3., 2., 1.}), "notice reordering in client memory");
+
+    lines.setCullingRange(6., 2.);
+    UNITTEST_ASSERT(visitedXs(lines).size() == 7u, "accept limits in reverse order");
+
+    // ...................................................................... //
+
+    Plotypus::Report r;
+    r.setVerbose(false);
+    r.setAutoRunScript(false);
+    r.setOutputDirectory(directory.string());
+    r.setAutoCulling(true);
+
+    auto& plot = r.addPlotWithAxes();
+    auto& view = plot.addDataViewCompound<double>(std::span<double>(xs), [] (const double& v) {return v;});
+    view.setSelector(Plotypus::ColumnType::X, [] (const double& v) {return v;});
+    plot.xAxis().rangeMin = 10.;
+    plot.xAxis().rangeMax = 20.;
+
+    r.writeDat();
+    UNITTEST_ASSERT(fs::file_size(view.getDataFilename()) == 13u * 2u * sizeof(double), "write detail page records only");
+    UNITTEST_ASSERT(std::isnan(view.getCullingRange().first) && std::isnan(view.getCullingRange().second), "leave culling range of view untouched");
+
+    view.setCullingRange(0., 100.);
+    r.writeDat();
+    UNITTEST_ASSERT(fs::file_size(view.getDataFilename()) == 102u * 2u * sizeof(double), "prefer culling range of view");
+    view.setCullingRange(Plotypus::AXIS_AUTO_RANGE, Plotypus::AXIS_AUTO_RANGE);
+
+    r.setAutoCulling(false);
+    r.writeDat();
+    UNITTEST_ASSERT(fs::file_size(view.getDataFilename()) == xs.size() * 2u * sizeof(double), "stop culling when disabled");
+    r.setAutoCulling(true);
+
+    plot.xAxis().rangeMin = Plotypus::AXIS_AUTO_RANGE;
+    plot.xAxis().rangeMax = Plotypus::AXIS_AUTO_RANGE;
+    r.writeDat();
+    UNITTEST_ASSERT(fs::file_size(view.getDataFilename()) == xs.size() * 2u * sizeof(double), "write all records for auto range");
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
@@ -7,8 +7,38 @@
 bool unittest_report_basicSheetManagement();
 bool unittest_report_emptyScriptOutput();
 bool unittest_report_sheets_scriptOutput();
+bool unittest_report_parallelDatExport();
+bool unittest_report_skipUnchangedOutput();
+bool unittest_report_memoryFileTransport();
+bool unittest_report_inlineData();
+bool unittest_report_persistentGnuplot();
+bool unittest_report_asyncGnuplot();
+bool unittest_report_renderFarm();
+bool unittest_report_parallelPages();
+bool unittest_report_pdfMerging();
+bool unittest_report_renderToMemory();
+bool unittest_report_nativeSvg();
+bool unittest_report_nativePng();
+bool unittest_report_nativeAscii();
+bool unittest_report_renderer();
+bool unittest_report_dataArchive();
 bool unittest_sheets_labels();
 
+// ========================================================================== //
+// data views
+
+bool unittest_dataview_blockExport();
+bool unittest_dataview_staticCompound();
+bool unittest_dataview_rawExport();
+bool unittest_dataview_columnDataTypes();
+bool unittest_dataview_asciiExport();
+bool unittest_dataview_chunkedExport();
+bool unittest_dataview_mappedExport();
+bool unittest_dataview_decimation();
+bool unittest_dataview_deduplicateData();
+bool unittest_dataview_statistics();
+bool unittest_dataview_culling();
+
 // ========================================================================== //
 // plots
 
@@ -1,5 +1,11 @@
+#include <algorithm>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
 //#include <functional>
 #include <iostream>
+#include <sstream>
+#include <thread>
 //#include <numbers>
 //#include <string>
 //#include <vector>
@@ -7,6 +13,8 @@
 #include "unittest.h"
 #include "../plotypus.h"
 
+namespace fs = std::filesystem;
+
 // ========================================================================== //
 // procs
 
@@ -368,3 +376,1155 @@ bool unittest_sheets_labels()
 
     UNITTEST_FINALIZE;
 }
+
+// -------------------------------------------------------------------------- //
+
+bool unittest_report_parallelDatExport()
+{
+    std::cout << "TESTING REPORT CLASS PARALLEL DATA EXPORT" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("parallel");
+
+    const size_t sheetCount = 24u;
+    std::vector<double> ys(10000);
+    for (size_t i = 0u; auto& y : ys) {y = 0.5 * i++;}
+
+    Plotypus::Report r;
+    r.setVerbose(false);
+    r.setOutputDirectory(directory.string());
+
+    for (size_t i = 0u; i < sheetCount; ++i)
+    {
+        auto& plot = r.addPlotWithAxes("sheet " + std::to_string(i));
+        const auto selector = [] (const double& y) {return y;};
+        plot.addDataViewCompound<double>(std::span<double>(ys), selector);
+        plot.addDataViewCompound<double>(std::span<double>(ys), selector).columnPrecision(Plotypus::ColumnType::Y) = 3;
+        plot.dataView(1).setBinaryDataOutput(false);
+    }
+
+    const auto readAllDataFiles = [&r] ()
+    {
+        std::vector<std::string> contents;
+        for (size_t i = 0u; i < r.getReportSize(); ++i)
+        {
+            for (auto dataView : r.sheetAs<Plotypus::PlotWithAxes>(i).getDataViews())
+            {
+                std::ifstream hFile(dataView->getDataFilename(), std::ios::binary);
+                contents.emplace_back(std::istreambuf_iterator<char>(hFile), std::istreambuf_iterator<char>());
+            }
+        }
+        return contents;
+    };
+
+    // ...................................................................... //
+
+    r.writeDat();
+    const auto sequentialContents = readAllDataFiles();
+
+    r.setExportThreadCount(4);
+    r.setMaxOpenFiles(3);
+    UNITTEST_DOESNT_THROW(r.writeDat(), std::exception, "write data files concurrently");
+    UNITTEST_ASSERT(readAllDataFiles() == sequentialContents, "produce the same data files as sequential export");
+
+    // ...................................................................... //
+
+    for (const size_t i : {17u, 5u, 11u})
+    {
+        auto& view = r.sheetAs<Plotypus::PlotWithAxes>(i).addDataViewCompound<double>(std::span<double>(ys), [i] (const double&) -> double
+        {
+            throw Plotypus::InvalidArgumentError("failure in sheet " + std::to_string(i));
+        });
+        view.setSelector(Plotypus::ColumnType::X, [] (const double& y) {return y;});
+    }
+
+    std::string firstError;
+    try
+    {
+        r.writeDat();
+    }
+    catch (const Plotypus::InvalidArgumentError& e)
+    {
+        firstError = e.what();
+    }
+    UNITTEST_ASSERT(firstError == "failure in sheet 5", "report the first failure in sheet order");
+
+    std::vector<bool> jobsRun(4u, false);
+    firstError.clear();
+    try
+    {
+        Plotypus::runParallel(jobsRun.size(), 1u, [&jobsRun] (const size_t i)
+        {
+            jobsRun[i] = true;
+            // *INDENT-OFF*
+            if (i % 2u) {throw Plotypus::InvalidArgumentError("failure in job " + std::to_string(i));}
+            // *INDENT-ON*
+        });
+    }
+    catch (const Plotypus::InvalidArgumentError& e)
+    {
+        firstError = e.what();
+    }
+    UNITTEST_ASSERT(std::ranges::all_of(jobsRun, std::identity()) && firstError == "failure in job 1", "run all sequential jobs despite failures");
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool unittest_report_skipUnchangedOutput()
+{
+    std::cout << "TESTING REPORT CLASS SKIPPING UNCHANGED OUTPUT" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("skipUnchanged");
+
+    std::vector<std::vector<double>> ys(3, std::vector<double>(1000, 1.));
+
+    Plotypus::Report r;
+    r.setVerbose(false);
+    r.setAutoRunScript(false);
+    r.setOutputDirectory(directory.string());
+    r.terminalInfoProvider().setOutputToFile(false);
+    r.setSkipUnchangedOutput(true);
+
+    for (auto& data : ys)
+    {
+        r.addPlotWithAxes().addDataViewCompound<double>(std::span<double>(data), [] (const double& y) {return y;});
+    }
+    r.sheetAs<Plotypus::PlotWithAxes>(0).addDataViewCompound<double>("sin(x)");
+
+    const auto& summary = r.getExportSummary();
+
+    // ...................................................................... //
+
+    r.setSkipUnchangedOutput(false);
+    r.writeDat();
+    UNITTEST_ASSERT(summary.writtenDataFiles.size() == 3, "list only views with a data file");
+    r.setSkipUnchangedOutput(true);
+
+    r.writeDat();
+    UNITTEST_ASSERT(summary.writtenDataFiles.size() == 3 && summary.skippedDataFiles.empty(), "write all data files initially");
+
+    r.writeDat();
+    UNITTEST_ASSERT(summary.writtenDataFiles.empty() && summary.skippedDataFiles.size() == 3, "skip unchanged data files");
+
+    ys[1][500] = 2.;
+    r.writeDat();
+    UNITTEST_ASSERT(summary.writtenDataFiles.size() == 1 && summary.skippedDataFiles.size() == 2, "detect changes in referenced data");
+
+    fs::remove(summary.skippedDataFiles[0]);
+    r.writeDat();
+    UNITTEST_ASSERT(summary.writtenDataFiles.size() == 1, "rewrite deleted data files");
+
+    // ...................................................................... //
+
+    r.writeScript();
+    UNITTEST_ASSERT(!summary.skippedScript && summary.unchangedSheets.empty(), "write script initially");
+
+    r.writeDat();
+    r.writeScript();
+    UNITTEST_ASSERT(summary.skippedScript && summary.unchangedSheets.size() == 3, "skip unchanged script");
+
+    r.sheetAs<Plotypus::PlotWithAxes>(2).setTitle("changed");
+    r.writeScript();
+    UNITTEST_ASSERT(!summary.skippedScript && summary.unchangedSheets == std::vector<size_t>({1, 2}), "report unchanged sheets of changed script");
+
+    ys[0][0] = 3.;
+    r.writeDat();
+    r.writeScript();
+    UNITTEST_ASSERT(!summary.skippedScript, "rerun script after data changed");
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool unittest_report_memoryFileTransport()
+{
+    std::cout << "TESTING REPORT CLASS MEMORY FILE TRANSPORT" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("memfd");
+
+    std::vector<double> ys(1000);
+    for (size_t i = 0u; auto& y : ys) {y = i++;}
+
+    Plotypus::Report r;
+    r.setVerbose(false);
+    r.setAutoRunScript(false);
+    r.setOutputDirectory(directory.string());
+    r.setDataTransport(Plotypus::DataTransport::MemoryFiles);
+
+    auto& view = r.addPlotWithAxes().addDataViewCompound<double>(std::span<double>(ys), [] (const double& y) {return y;});
+
+    // ...................................................................... //
+
+    UNITTEST_DOESNT_THROW(r.writeDat(), std::exception, "write data to memory files");
+
+    const std::string memoryFilename = view.getDataFilename();
+    UNITTEST_ASSERT(memoryFilename.starts_with("/proc/self/fd/"), "refer to data by descriptor path");
+
+    std::ifstream hData(memoryFilename, std::ios::binary);
+    std::vector<double> values(ys.size() + 1);
+    hData.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(double));
+    values.resize(hData.gcount() / sizeof(double));
+    UNITTEST_ASSERT(values == ys, "store data in memory file");
+
+    std::stringstream script;
+    r.writeScript(script);
+    UNITTEST_ASSERT(script.str().find(memoryFilename) != std::string::npos, "reference memory file in script");
+
+    r.writeDat();
+    UNITTEST_ASSERT(view.getDataFilename() == memoryFilename, "reuse memory files in later exports");
+
+    r.writeScript();
+    UNITTEST_ASSERT(fs::is_empty(directory), "leave output directory untouched");
+
+    // ...................................................................... //
+
+    r.setDataTransport(Plotypus::DataTransport::Files);
+    r.writeDat();
+    UNITTEST_ASSERT(!view.getDataFilename().starts_with("/proc/") && fs::exists(view.getDataFilename()), "return to data files on disk");
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
+
+// -------------------------------------------------------------------------- //
+
+bool unittest_report_inlineData()
+{
+    std::cout << "TESTING REPORT CLASS INLINE DATABLOCKS" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("inline");
+
+    std::vector<double> ys = {1., 2.5, 4.};
+
+    Plotypus::Report r;
+    r.setVerbose(false);
+    r.setOutputDirectory(directory.string());
+    r.setInlineData(true);
+
+    r.addSheet("no data");
+    auto& plot = r.addPlotWithAxes();
+    plot.addDataViewCompound<double>("sin(x)");
+    plot.addDataViewCompound<double>(std::span<double>(ys), [] (const double& y) {return y;});
+
+    // ...................................................................... //
+
+    std::stringstream script;
+    r.writeScript(script);
+
+    UNITTEST_ASSERT(script.str().find("$data_2_2 << EOD\n1\t\n2.5\t\n4\t\nEOD\n") != std::string::npos, "embed data as datablock");
+    UNITTEST_ASSERT(script.str().find("$data_2_1") == std::string::npos, "embed no datablock for functions");
+    UNITTEST_ASSERT(script.str().find("$data_2_2 using") != std::string::npos, "reference datablock in plot command");
+
+    r.writeDat();
+    UNITTEST_ASSERT(fs::is_empty(directory), "write no data files");
+
+    // ...................................................................... //
+
+    r.setInlineData(false);
+    script.str("");
+    r.writeScript(script);
+    UNITTEST_ASSERT(script.str().find("$data_") == std::string::npos, "return to data files");
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
+
+bool unittest_report_persistentGnuplot()
+{
+    std::cout << "TESTING REPORT CLASS PERSISTENT GNUPLOT PROCESS" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("persistent");
+
+    // stand-in for gnuplot: answers print commands with the error state on stderr, logs loaded scripts,
+    // and fails, dies or hangs on request
+    const fs::path log        = directory / "loaded.log";
+    const fs::path executable = unittest_makeFakeGnuplot(directory, "err=0\n"
+                                                         "while IFS= read -r line; do\n"
+                                                         "    case \"$line\" in\n"
+                                                         "        'reset errors') err=0;;\n"
+                                                         "        'print \"'*) l=${line#print \\\"}; echo \"${l%%\\\"*} $err\" >&2;;\n"
+                                                         "        'load '*) echo \"$line\" >> '" + log.string() + "';;\n"
+                                                         "        'fail') echo 'line 1: invalid command' >&2; err=1;;\n"
+                                                         "        'crash') exit 1;;\n"
+                                                         "        'hang') exec sleep 30;;\n"
+                                                         "    esac\n"
+                                                         "done\n");
+
+    Plotypus::Report r;
+    r.setVerbose(false);
+    r.setOutputDirectory(directory.string());
+    r.gnuplotProcess().setExecutable(executable.string());
+
+    auto& process = r.gnuplotProcess();
+
+    // ...................................................................... //
+
+    r.setPersistentGnuplot(true);
+    const auto pid = process.getPid();
+    UNITTEST_ASSERT(pid > 0 && process.isRunning(), "start process when enabled");
+
+    r.addPlotWithAxes();
+    r.writeScript();
+    r.writeScript();
+
+    std::ifstream hLog(log);
+    std::string   loaded((std::istreambuf_iterator<char>(hLog)), std::istreambuf_iterator<char>());
+    const std::string expected = "load '" + (directory / "report.gnuplot").string() + "'\n";
+    UNITTEST_ASSERT(loaded == expected + expected, "load each script once");
+    UNITTEST_ASSERT(process.getPid() == pid && process.getSpawnCount() == 1u, "reuse process across scripts");
+
+    // ...................................................................... //
+
+    UNITTEST_ASSERT(!process.execute("fail") && process.hasScriptError() && process.isRunning(), "report error in script");
+    UNITTEST_ASSERT(process.getErrorOutput() == "line 1: invalid command\n", "capture error output of script");
+    UNITTEST_ASSERT(process.execute("print 1") && !process.hasScriptError() && process.getErrorOutput().empty(), "reset error state with next script");
+
+    UNITTEST_ASSERT(!process.execute("crash") && !process.hasScriptError(), "report death of process");
+    UNITTEST_ASSERT(!process.isRunning(), "reap dead process");
+    UNITTEST_ASSERT(process.execute("print 1"), "restart process with next script");
+    UNITTEST_ASSERT(process.getSpawnCount() == 2u, "count restarts");
+
+    const auto hangStart = std::chrono::steady_clock::now();
+    UNITTEST_ASSERT(!process.execute("hang", std::chrono::milliseconds(200)) && process.hasTimedOut(), "give up on hung script after timeout");
+    UNITTEST_ASSERT(std::chrono::steady_clock::now() - hangStart < std::chrono::seconds(5) && !process.isRunning(), "kill hung process");
+    UNITTEST_ASSERT(process.execute("print 1") && !process.hasTimedOut(), "restart process after timeout");
+
+    r.setPersistentGnuplot(false);
+    UNITTEST_ASSERT(!process.isRunning(), "stop process when disabled");
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
+
+bool unittest_report_asyncGnuplot()
+{
+    std::cout << "TESTING REPORT CLASS ASYNCHRONOUS GNUPLOT LAUNCH" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("async");
+
+    // stand-in for gnuplot: reports its argument on stderr, then fails, hangs or prints its limits as requested
+    const fs::path executable = unittest_makeFakeGnuplot(directory, "echo \"loading $1\" >&2\n"
+                                                         "case \"$1\" in\n"
+                                                         "    *fail*) exit 3;;\n"
+                                                         "    *hang*) sleep 10;;\n"
+                                                         "    *limits*) echo \"$(ulimit -t) $(ulimit -v)\";;\n"
+                                                         "esac\n");
+
+    Plotypus::Report r;
+    r.setVerbose(false);
+    r.setOutputDirectory(directory.string());
+    r.addPlotWithAxes();
+    r.gnuplotLaunchOptions().executable = executable.string();
+
+    // ...................................................................... //
+
+    const auto filenameGnu = (directory / "report.gnuplot").string();
+    auto result = r.writeScriptAsync().get();
+    UNITTEST_ASSERT(result.exitCode == 0 && !result.timedOut, "run script in background");
+    UNITTEST_ASSERT(result.errorOutput == "loading " + filenameGnu + "\n", "capture stderr");
+    UNITTEST_ASSERT(fs::exists(filenameGnu), "write script before running it");
+
+    result = Plotypus::runGnuplotAsync("fail", r.gnuplotLaunchOptions()).get();
+    UNITTEST_ASSERT(result.exitCode == 3 && result.signal == 0, "report exit code");
+
+    Plotypus::GnuplotLaunchOptions limited = r.gnuplotLaunchOptions();
+    limited.cpuTimeLimit  = 7u;
+    limited.memoryLimit   = size_t(1) << 32;
+    limited.captureOutput = true;
+    result = Plotypus::runGnuplotAsync("limits", limited).get();
+    UNITTEST_ASSERT(result.output == "7 4194304\n", "apply resource limits before gnuplot starts");
+
+    // ...................................................................... //
+
+    r.gnuplotLaunchOptions().timeout = std::chrono::milliseconds(200);
+    result = Plotypus::runGnuplotAsync("hang", r.gnuplotLaunchOptions()).get();
+    UNITTEST_ASSERT(result.timedOut && result.exitCode == -1 && result.signal == SIGKILL, "kill process on timeout");
+    UNITTEST_ASSERT(result.wallTime < std::chrono::seconds(5), "return on timeout");
+    UNITTEST_ASSERT(result.errorOutput == "loading hang\n", "keep stderr of killed process");
+
+    r.gnuplotLaunchOptions().executable = (directory / "missing").string();
+    UNITTEST_THROWS(Plotypus::runGnuplotAsync("x", r.gnuplotLaunchOptions()), Plotypus::FileIOError, "throw if gnuplot cannot be started");
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
+
+bool unittest_report_renderFarm()
+{
+    std::cout << "TESTING RENDER FARM" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("renderfarm");
+
+    // stand-in for gnuplot: logs its scripts one line per process, prints the separating commands' marker,
+    // and stops at a failing one like gnuplot
+    const fs::path log        = directory / "rendered.log";
+    const fs::path executable = unittest_makeFakeGnuplot(directory, "line=''\n"
+                                                         "for argument; do\n"
+                                                         "    case \"$argument\" in\n"
+                                                         "        -e) ;;\n"
+                                                         "        *'reset session') echo 'plotypus: script done' >&2;;\n"
+                                                         "        *slow*) sleep 1; line=\"$line ${argument##*/}\";;\n"
+                                                         "        *) line=\"$line ${argument##*/}\";;\n"
+                                                         "    esac\n"
+                                                         "    case \"$argument\" in *fail*) echo \"$line\" >> '" + log.string() + "'; exit 1;; esac\n"
+                                                         "done\n"
+                                                         "echo \"$line\" >> '" + log.string() + "'\n");
+
+    Plotypus::GnuplotLaunchOptions options;
+    options.executable = executable.string();
+
+    // ...................................................................... //
+
+    {
+        Plotypus::RenderFarm farm(1u, 3u);
+        farm.setLaunchOptions(options);
+        farm.setPaused(true);
+
+        farm.submit(std::vector<std::string>({"a", "fail", "b"}));
+        farm.submit("c", 1);
+        farm.submit(std::vector<std::string>({"fail", "d", "e"}));
+
+        Plotypus::Report r;
+        r.setVerbose(false);
+        r.setOutputDirectory(directory.string());
+        r.addPlotWithAxes();
+        farm.submit(r, -1);
+
+        farm.setPaused(false);
+        farm.wait();
+
+        std::ifstream hLog(log);
+        std::string   rendered((std::istreambuf_iterator<char>(hLog)), std::istreambuf_iterator<char>());
+        UNITTEST_ASSERT(rendered == " c\n a fail\n fail\n b\n fail\n d e\n report.gnuplot\n", "render by priority and order of submission in batches, resuming after failures");
+
+        const auto statistics = farm.getStatistics();
+        UNITTEST_ASSERT(statistics.renderedScripts == 6u && statistics.gnuplotRuns == 7u, "count scripts and runs");
+        UNITTEST_ASSERT(statistics.failedScripts.size() == 2u && statistics.failedScripts[0].first == "fail" && statistics.failedScripts[1].first == "fail", "tell failed scripts from their batches");
+        UNITTEST_ASSERT(statistics.throughput > 0., "report throughput");
+
+        r.setDataTransport(Plotypus::DataTransport::MemoryFiles);
+        r.setOutputDirectory((directory / "memory").string());
+        UNITTEST_THROWS(farm.submit(r), Plotypus::UnsupportedOperationError, "reject in-memory scripts");
+        UNITTEST_ASSERT(!fs::exists(directory / "memory"), "reject in-memory scripts before writing anything");
+    }
+
+    // ...................................................................... //
+
+    {
+        fs::remove(log);
+
+        Plotypus::RenderFarm farm(1u);
+        farm.setLaunchOptions(options);
+        farm.submit(std::vector<std::string>({"slow", "g", "h"}));
+
+        std::thread waiter([&farm] {farm.wait();});
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        farm.setPaused(true);
+        waiter.join();
+
+        const auto statistics = farm.getStatistics();
+        UNITTEST_ASSERT(statistics.renderedScripts == 1u, "wake waiting threads when paused, after the running batch");
+
+        farm.wait();
+        UNITTEST_ASSERT(farm.getStatistics().renderedScripts == 1u, "return from wait while paused");
+
+        farm.setPaused(false);
+        farm.wait();
+        UNITTEST_ASSERT(farm.getStatistics().renderedScripts == 3u, "render the rest when resumed");
+    }
+
+    // ...................................................................... //
+
+    {
+        fs::remove(log);
+
+        Plotypus::RenderFarm farm(4u);
+        farm.setLaunchOptions(options);
+        for (size_t i = 0u; i < 16u; ++i)
+        {
+            farm.submit("script" + std::to_string(i));
+        }
+    }
+
+    std::ifstream hLog(log);
+    UNITTEST_ASSERT(std::count(std::istreambuf_iterator<char>(hLog), std::istreambuf_iterator<char>(), '\n') == 16, "render queue before destruction");
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
+
+bool unittest_report_parallelPages()
+{
+    std::cout << "TESTING REPORT CLASS PARALLEL PAGES AND PDF MERGING" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("pages");
+
+    // stand-in for gnuplot: writes a one-page PDF with the page script name as content to the output file
+    const fs::path executable = unittest_makeFakeGnuplot(directory, "out=$(sed -n \"s/^set output '\\(.*\\)'$/\\1/p\" \"$1\")\n"
+                                                         "cp \"$1\" '" + (directory / "scripts").string() + "'\n"
+                                                         "content=\"(${1##*/})\"\n"
+                                                         "printf '%%PDF-1.4\\n1 0 obj\\n<< /Type /Catalog /Pages 2 0 R >>\\nendobj\\n' > \"$out\"\n"
+                                                         "printf '2 0 obj\\n<< /Type /Pages /Kids [3 0 R] /Count 1 /MediaBox [0 0 10 10] >>\\nendobj\\n' >> \"$out\"\n"
+                                                         "printf '3 0 obj\\n<< /Type /Page /Parent 2 0 R /Contents 4 0 R >>\\nendobj\\n' >> \"$out\"\n"
+                                                         "printf '4 0 obj\\n<< /Length %d >>\\nstream\\n%s\\nendstream\\nendobj\\n' ${#content} \"$content\" >> \"$out\"\n"
+                                                         "printf 'trailer\\n<< /Root 1 0 R >>\\n%%%%EOF\\n' >> \"$out\"\n");
+
+    std::vector<double> ys = {1., 2., 3.};
+
+    Plotypus::Report r;
+    r.setVerbose(false);
+    r.setOutputDirectory(directory.string());
+    r.setParallelPages(true);
+    r.setInlineData(true);
+    r.gnuplotLaunchOptions().executable = executable.string();
+
+    r.addSheet("title page");
+    r.addPlotWithAxes().addDataViewCompound<double>(std::span<double>(ys), [] (const double& y) {return y;});
+    r.addPlotWithAxes().addDataViewCompound<double>("sin(x)");
+
+    // ...................................................................... //
+
+    fs::create_directories(directory / "scripts");
+    {
+        std::ofstream hUserFile(directory / "report_2.gnuplot");
+        hUserFile << "user file";
+    }
+
+    r.writeScript();
+
+    std::ifstream hScript(directory / "scripts" / "report_2.gnuplot");
+    const std::string script((std::istreambuf_iterator<char>(hScript)), std::istreambuf_iterator<char>());
+    UNITTEST_ASSERT(script.find("set term pdfcairo") != std::string::npos, "write terminal setup into page script");
+    UNITTEST_ASSERT(script.find("set output '") != std::string::npos && script.find("report_2.pdf'") != std::string::npos, "render page into its own file");
+    UNITTEST_ASSERT(script.find("set output '" + directory.string()) == std::string::npos, "render merged pages outside of the output directory");
+    UNITTEST_ASSERT(script.find("$data_2_1 << EOD") != std::string::npos, "embed data of page");
+
+    std::ifstream hPdf(directory / "report.pdf", std::ios_base::binary);
+    const std::string pdf((std::istreambuf_iterator<char>(hPdf)), std::istreambuf_iterator<char>());
+    UNITTEST_ASSERT(pdf.find("/Count 3") != std::string::npos, "merge pages");
+    UNITTEST_ASSERT(pdf.find("(report_1.gnuplot)") < pdf.find("(report_2.gnuplot)") &&
+                    pdf.find("(report_2.gnuplot)") < pdf.find("(report_3.gnuplot)") &&
+                    pdf.find("(report_3.gnuplot)") != std::string::npos, "keep order of pages");
+    UNITTEST_ASSERT(!fs::exists(directory / "report_1.pdf"), "remove single pages");
+
+    std::ifstream hUserFile(directory / "report_2.gnuplot");
+    const std::string userFile((std::istreambuf_iterator<char>(hUserFile)), std::istreambuf_iterator<char>());
+    UNITTEST_ASSERT(userFile == "user file" && !fs::exists(directory / "report_1.gnuplot"), "write page scripts outside of the output directory");
+
+    // the merged file is valid input, too
+    Plotypus::mergePdfFiles({(directory / "report.pdf").string(), (directory / "report.pdf").string()}, (directory / "twice.pdf").string());
+    std::ifstream hTwice(directory / "twice.pdf", std::ios_base::binary);
+    const std::string twice((std::istreambuf_iterator<char>(hTwice)), std::istreambuf_iterator<char>());
+    UNITTEST_ASSERT(twice.find("/Count 6") != std::string::npos, "merge merged file");
+
+    UNITTEST_THROWS(Plotypus::mergePdfFiles({executable.string()}, (directory / "x.pdf").string()), Plotypus::FileIOError, "reject non-PDF input");
+
+    // ...................................................................... //
+
+    r.setFileType(Plotypus::FileType::Png);
+    r.writeScript();
+    UNITTEST_ASSERT(fs::exists(directory / "report_1.png") && fs::exists(directory / "report_3.png"), "keep numbered pages of raster output");
+
+    r.setAutoRunScript(false);
+    r.writeScript();
+    UNITTEST_ASSERT(fs::exists(directory / "report.gnuplot") && !fs::exists(directory / "report_1.gnuplot"), "write single script without autoRunScript");
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
+
+bool unittest_report_pdfMerging()
+{
+    std::cout << "TESTING PDF MERGING OF COMPRESSED FILES" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("pdf");
+
+    /* zlib output (Python zlib.compress) of an object stream with the page tree of a one-page document,
+     * once for each kind of deflate block: stored, fixed and dynamic Huffman codes.
+     */
+    const std::vector<std::string> objectStreams =
+    {
+        std::string("\x78\x01\x01\xa0\x00\x5f\xff\x32\x20\x30\x20\x33\x20\x36\x34\x0a\x3c\x3c\x20\x2f\x54\x79\x70\x65"
+                    "\x20\x2f\x50\x61\x67\x65\x73\x20\x2f\x4b\x69\x64\x73\x20\x5b\x33\x20\x30\x20\x52\x5d\x20\x2f\x43"
+                    "\x6f\x75\x6e\x74\x20\x31\x20\x2f\x4d\x65\x64\x69\x61\x42\x6f\x78\x20\x5b\x30\x20\x30\x20\x31\x30"
+                    "\x20\x31\x30\x5d\x20\x3e\x3e\x0a\x3c\x3c\x20\x2f\x54\x79\x70\x65\x20\x2f\x50\x61\x67\x65\x20\x2f"
+                    "\x50\x61\x72\x65\x6e\x74\x20\x32\x20\x30\x20\x52\x20\x2f\x43\x6f\x6e\x74\x65\x6e\x74\x73\x20\x34"
+                    "\x20\x30\x20\x52\x20\x2f\x52\x65\x73\x6f\x75\x72\x63\x65\x73\x20\x3c\x3c\x20\x2f\x50\x72\x6f\x63"
+                    "\x53\x65\x74\x20\x5b\x2f\x50\x44\x46\x20\x2f\x54\x65\x78\x74\x5d\x20\x3e\x3e\x20\x3e\x3e\x0a\x80"
+                    "\x1c\x2c\x37", 171),
+        std::string("\x78\x01\x33\x52\x30\x50\x30\x56\x30\x33\xe1\xb2\xb1\x51\xd0\x0f\xa9\x2c\x48\x55\xd0\x0f\x48\x4c"
+                    "\x4f\x2d\x56\xd0\xf7\xce\x4c\x29\x56\x88\x36\x06\xca\x07\xc5\x2a\xe8\x3b\xe7\x97\xe6\x95\x28\x18"
+                    "\x2a\xe8\xfb\xa6\xa6\x64\x26\x3a\xe5\x57\x28\x44\x1b\x00\xa5\x0c\x41\x28\x56\xc1\xce\x0e\x4d\x3f"
+                    "\x88\x2c\x4a\x05\xea\x30\x02\xe9\x07\x69\xcf\x2b\x01\x72\x8b\x15\x4c\x20\xfc\xa0\xd4\xe2\xfc\xd2"
+                    "\xa2\x64\xa0\x3d\x20\x7d\x01\x45\xf9\xc9\xc1\xa9\x25\x0a\xd1\xfa\x01\x2e\x6e\x40\x63\x52\x2b\x4a"
+                    "\x40\x66\x82\x8c\x05\x00\x80\x1c\x2c\x37", 130),
+        std::string("\x78\xda\x5d\x90\x3d\x4f\x1c\x61\x0c\x84\x7b\x7e\xc5\xdb\xa4\x5e\xbe\x94\x0a\x51\x24\x11\x4d\x84"
+                    "\x74\x22\xe9\x4e\x14\x1e\x7b\x6c\xd3\x70\xd1\xdd\x21\xc1\xbf\xcf\x98\x74\x59\xed\xae\xd6\xfb\xfa"
+                    "\x99\x19\xfb\x7a\x5d\xae\x9b\xf5\xf5\xf6\xe2\xee\x6e\x6d\xbf\x3f\xfe\x70\x6d\x3b\x2b\x9e\xd6\xf6"
+                    "\xf3\x25\x4e\x6b\x7f\xa3\xf3\xa7\xe7\xb5\x7d\x3f\xbc\xbd\x9e\xd7\xd5\xda\x1e\x19\x2f\xf6\xed\xf0"
+                    "\xbe\xf6\x97\x3a\xba\x9a\xfb\x79\xdd\xdf\xff\xc7\xcf\xfb\x48\x11\xd7\xc3\x0f\xfe\x7a\x56\x79\x5a"
+                    "\xb7\xff\xea\x27\x9e\x0e\x6f\x47\x97\xcf\x70\xbb\xe3\xc1\x7f\xf1\xbc\xf6\xdb\xee\xc7\x83\x64\xf8"
+                    "\x7e\x1e\xcd\x91\xfd\xb2\x1c\x44\x77\x57\xa0\xad\xca\x9a\x81\x34\x5d\x15\x65\xd1\x1d\x19\xd1\xb4"
+                    "\x82\x13\x59\x41\xb6\x7a\xa2\xca\x33\xd1\xf0\xca\xb6\x36\x96\x7b\x58\x44\x65\x4e\xaf\x0b\xed\x8c"
+                    "\xea\xac\x34\x35\x84\xcb\xc4\x80\xe9\x0c\xc2\x53\x8f\xd3\xa5\x95\xdd\x10\x3d\xc2\xe0\x18\x0a\x36"
+                    "\x57\x98\xd6\x57\x96\x51\xb2\x04\x48\x2f\xba\x29\x8f\x2b\x57\x22\xd4\x80\x62\x5b\x16\xcd\x23\xfd"
+                    "\x53\x40\x59\x02\x26\x69\x0f\x26\x53\x01\x29\x40\xd3\x14\x94\x2f\x51\x08\xe8\x00\x4d\x79\x9a\xa9"
+                    "\x9e\xc8\x8e\xf6\x70\x54\x4d\x1c\xc4\xcc\xce\x6c\x99\x03\xd9\xa3\x90\x0a\xc1\x90\xab\x48\x68\x2a"
+                    "\x9a\xfc\xa8\x1a\xa1\x99\x4b\xbf\xf1\x89\x8c\xd5\x98\xcf\x78\x42\xdc\x32\x5c\x8b\x31\x25\x6b\x65"
+                    "\xd5\x76\xd3\x15\xb9\x4c\xbc\xc6\xa7\x76\x88\x68\x73\xa5\x0e\xd1\x5a\x1e\xc3\x90\x17\x7f\x01\x25"
+                    "\xc2\xc9\x71", 339)
+    };
+    // zlib output of the page content, which is copied without being inflated
+    const std::string content("\x78\xda\x73\x0a\x51\xd0\x77\x33\x54\x30\x34\x52\x08\x49\x53\x30\x34\x00\xa1\x90\x14\x05\x8d\xe4"
+                                "\xfc\xdc\x82\xa2\xd4\xe2\xe2\xd4\x14\x85\x82\xc4\xf4\x54\x4d\x85\x90\x2c\x05\xd7\x10\x2e\xa7\x41"
+                                "\xa3\x1a\x00\xe1\xe7\x32\x5d", 55);
+
+    const auto writePdf = [&] (const fs::path& filename, const std::string& objectStream, const std::string& filter = "/FlateDecode")
+    {
+        std::ofstream hFile(filename, std::ios_base::binary);
+        hFile << "%PDF-1.5\n"
+              << "1 0 obj\n<< /Type /Catalog /Pages 2 0 R >>\nendobj\n"
+              << "4 0 obj\n<< /Length " << content.size() << " /Filter /FlateDecode >>\nstream\n" << content << "\nendstream\nendobj\n"
+              << "5 0 obj\n<< /Type /ObjStm /N 2 /First 9 /Length " << objectStream.size() << " /Filter " << filter << " >>\nstream\n" << objectStream << "\nendstream\nendobj\n"
+              << "trailer\n<< /Root 1 0 R >>\n%%EOF\n";
+        return filename.string();
+    };
+
+    // ...................................................................... //
+
+    std::vector<std::string> inputs;
+    for (size_t i = 0u; i < objectStreams.size(); ++i)
+    {
+        inputs.push_back(writePdf(directory / ("page_" + std::to_string(i) + ".pdf"), objectStreams[i]));
+    }
+    Plotypus::mergePdfFiles(inputs, (directory / "merged.pdf").string());
+
+    std::ifstream hMerged(directory / "merged.pdf", std::ios_base::binary);
+    const std::string merged((std::istreambuf_iterator<char>(hMerged)), std::istreambuf_iterator<char>());
+    UNITTEST_ASSERT(merged.find("/Count 3") != std::string::npos, "merge pages from compressed object streams");
+    UNITTEST_ASSERT(merged.find("/ProcSet") != std::string::npos, "keep resources from compressed object streams");
+
+    size_t contentCount = 0u;
+    for (size_t position = merged.find(content); position != std::string::npos; position = merged.find(content, position + 1u))
+    {
+        ++contentCount;
+    }
+    UNITTEST_ASSERT(contentCount == 3u, "copy compressed page content verbatim");
+
+    // ...................................................................... //
+
+    std::string corruptStored = objectStreams[0];
+    corruptStored[5] = '\0';              // NLEN, the one's complement of LEN
+    const std::string truncated = objectStreams[2].substr(0u, objectStreams[2].size() / 2u);
+
+    UNITTEST_THROWS(Plotypus::mergePdfFiles({writePdf(directory / "x.pdf", corruptStored)},             (directory / "y.pdf").string()), Plotypus::FileIOError,                "reject stored block with inconsistent length");
+    UNITTEST_THROWS(Plotypus::mergePdfFiles({writePdf(directory / "x.pdf", truncated)},                 (directory / "y.pdf").string()), Plotypus::FileIOError,                "reject truncated compressed stream");
+    UNITTEST_THROWS(Plotypus::mergePdfFiles({writePdf(directory / "x.pdf", objectStreams[0], "/LZWDecode")}, (directory / "y.pdf").string()), Plotypus::UnsupportedOperationError, "reject unsupported filters");
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
+
+bool unittest_report_renderToMemory()
+{
+    std::cout << "TESTING REPORT CLASS IN-MEMORY RENDERING" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("memoryrender");
+    const fs::path output    = directory / "output";
+    fs::create_directories(output);
+
+    // stand-in for gnuplot: emits binary "image" to stdout if the script directs output there
+    const fs::path executable = unittest_makeFakeGnuplot(directory, "grep -q '^set output$' \"$1\" || exit 1\n"
+                                                         "printf 'IMG\\000'\n"
+                                                         "grep -c '' \"$1\"\n");
+
+    std::vector<double> ys = {1., 2., 3.};
+
+    Plotypus::Report r(Plotypus::FileType::Png);
+    r.setVerbose(false);
+    r.setOutputDirectory(output.string());
+    r.setDataTransport(Plotypus::DataTransport::MemoryFiles);
+    r.gnuplotLaunchOptions().executable = executable.string();
+    r.addPlotWithAxes().addDataViewCompound<double>(std::span<double>(ys), [] (const double& y) {return y;});
+
+    // ...................................................................... //
+
+    r.writeDat();
+    const auto result = r.renderToMemory();
+
+    UNITTEST_ASSERT(result.exitCode == 0, "render with output to stdout");
+    UNITTEST_ASSERT(result.output.starts_with(std::string("IMG\0", 4)) && result.output.size() > 5u, "return binary output");
+    UNITTEST_ASSERT(fs::is_empty(output), "create no files");
+
+    r.setFileType(Plotypus::FileType::Screen);
+    UNITTEST_THROWS(r.renderToMemory(), Plotypus::UnsupportedOperationError, "reject screen output");
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
+
+bool unittest_report_nativeSvg()
+{
+    std::cout << "TESTING REPORT CLASS NATIVE SVG RENDERING" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("nativesvg");
+
+    const auto readFile = [] (const fs::path& path)
+    {
+        std::ifstream hFile(path);
+        return std::string((std::istreambuf_iterator<char>(hFile)), std::istreambuf_iterator<char>());
+    };
+
+    // ...................................................................... //
+
+    UNITTEST_ASSERT(Plotypus::parseColor("#ff8000") == Plotypus::Color({255u, 128u, 0u, 255u}), "parse RGB color");
+    UNITTEST_ASSERT(Plotypus::parseColor("0x80000000") == Plotypus::Color({0u, 0u, 0u, 127u}), "parse transparency");
+    UNITTEST_ASSERT(Plotypus::parseColor("dark-green").has_value(), "parse color name");
+    UNITTEST_ASSERT(!Plotypus::parseColor("palette frac 0.5").has_value(), "reject unknown color");
+
+    std::stringstream svg;
+    Plotypus::SvgCanvas canvas(svg);
+    canvas.beginPage(100., 50., {255u, 255u, 255u, 255u});
+    canvas.text({10., 10.}, "a<b", Plotypus::TextStyle());
+    canvas.endPage();
+    UNITTEST_ASSERT(svg.str().find("viewBox=\"0 0 100.00 50.00\"") != std::string::npos, "write page size");
+    UNITTEST_ASSERT(svg.str().find(">a&lt;b</text>") != std::string::npos, "escape text");
+
+    // ...................................................................... //
+
+    std::vector<double> ys = {1., 4., 2., 3.};
+    const auto selectY     = [] (const double& y) {return y;};
+    const auto selectDelta = [] (const double&)   {return .5;};
+
+    Plotypus::Report r(Plotypus::FileType::Svg);
+    r.setVerbose(false);
+    r.setOutputDirectory(directory.string());
+    r.setNativeRendering(true);
+
+    auto& plot = r.addPlotWithAxes("native title");
+    plot.xAxis().labelText = "abscissa";
+    plot.addDataViewCompound<double>(std::span<double>(ys), selectY, Plotypus::PlotStyle2D::Lines, "lines");
+    plot.addDataViewCompound<double>(std::span<double>(ys), selectY, Plotypus::PlotStyle2D::Points);
+    plot.addDataViewCompound<double>(std::span<double>(ys), selectY, Plotypus::PlotStyle2D::Boxes, "boxes");
+    auto& errorBars = plot.addDataViewCompound<double>(std::span<double>(ys), selectY, Plotypus::PlotStyle2D::YErrorBars);
+    errorBars.setSelector(Plotypus::ColumnType::X,      [&ys] (const double& y) {return static_cast<double>(&y - ys.data());});
+    errorBars.setSelector(Plotypus::ColumnType::DeltaY, selectDelta);
+
+    r.writeScript();
+
+    const std::string page = readFile(directory / "report.svg");
+    UNITTEST_ASSERT(page.find("<svg") != std::string::npos && page.find("</svg>") != std::string::npos, "write SVG document");
+    UNITTEST_ASSERT(page.find(">native title</text>") != std::string::npos, "draw title");
+    UNITTEST_ASSERT(page.find(">abscissa</text>") != std::string::npos, "draw axis label");
+    UNITTEST_ASSERT(page.find(">lines</text>") != std::string::npos && page.find(">boxes</text>") != std::string::npos, "draw key");
+    UNITTEST_ASSERT(page.find(">5</text>") != std::string::npos && page.find(">-1</text>") != std::string::npos, "extend ranges to error bars and boxes");
+    UNITTEST_ASSERT(page.find("<path") != std::string::npos && page.find("<rect") != std::string::npos, "draw lines and boxes");
+    UNITTEST_ASSERT(!fs::exists(directory / "report.gnuplot"), "write no script");
+
+    // ...................................................................... //
+
+    r.addSheet("second page").addLabel("note", .5, .5, false);
+    r.writeScript();
+    UNITTEST_ASSERT(fs::exists(directory / "report_1.svg") && fs::exists(directory / "report_2.svg"), "write one file per sheet");
+    UNITTEST_ASSERT(readFile(directory / "report_2.svg").find(">note</text>") != std::string::npos, "draw labels");
+
+    plot.addDataViewCompound<double>("sin(x)");
+    r.writeScript();
+    UNITTEST_ASSERT(fs::exists(directory / "report.gnuplot"), "fall back to gnuplot for functions");
+
+    // ...................................................................... //
+
+    using point_t = std::pair<double, double>;
+    std::vector<point_t> points = {{1e14, 1e14}, {1e14 + 1000., 1e14 + 1000.}};
+
+    Plotypus::Report ranges(Plotypus::FileType::Svg);
+    ranges.setVerbose(false);
+    ranges.setOutputDirectory((directory / "ranges").string());
+    fs::create_directories(directory / "ranges");
+    ranges.setNativeRendering(true);
+
+    auto& rangeView = ranges.addPlotWithAxes().addDataViewCompound<point_t>(std::span<point_t>(points), [] (const point_t& p) {return p.second;});
+    rangeView.setSelector(Plotypus::ColumnType::X, [] (const point_t& p) {return p.first;});
+    ranges.writeScript();
+    UNITTEST_ASSERT(fs::exists(directory / "ranges" / "report.svg") && !fs::exists(directory / "ranges" / "report.gnuplot"), "draw large but exact ranges");
+
+    for (const auto& [low, high] : {point_t(1e16, 1e16 + 1000.), point_t(1e17, 1e17 + 100.), point_t(-1e308, 1e308)})
+    {
+        fs::remove(directory / "ranges" / "report.gnuplot");
+        points[0].second = low;
+        points[1].second = high;
+        ranges.writeScript();
+        UNITTEST_ASSERT(fs::exists(directory / "ranges" / "report.gnuplot"), "fall back to gnuplot for tics beyond double precision");
+    }
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
+
+bool unittest_report_nativePng()
+{
+    std::cout << "TESTING REPORT CLASS NATIVE PNG RENDERING" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("nativepng");
+
+    // ...................................................................... //
+
+    Plotypus::RasterCanvas canvas;
+    canvas.beginPage(20., 10., {255u, 255u, 255u, 255u});
+    canvas.rectangle(2., 2., 4., 4., Plotypus::Color({255u, 0u, 0u, 255u}), std::nullopt);
+    canvas.rectangle(10., 2., 4., 4., Plotypus::Color({0u, 0u, 255u, 128u}), std::nullopt);
+    canvas.endPage();
+
+    const auto  pixels = canvas.getPixels();
+    const auto  pixel  = [&pixels] (size_t x, size_t y) {return Plotypus::Color({pixels[4u * (y * 20u + x)], pixels[4u * (y * 20u + x) + 1u], pixels[4u * (y * 20u + x) + 2u], pixels[4u * (y * 20u + x) + 3u]});};
+
+    UNITTEST_ASSERT(pixels.size() == 20u * 10u * 4u, "allocate page");
+    UNITTEST_ASSERT(pixel(0u, 0u) == Plotypus::Color({255u, 255u, 255u, 255u}), "fill background");
+    UNITTEST_ASSERT(pixel(3u, 3u) == Plotypus::Color({255u, 0u, 0u, 255u}), "fill rectangle");
+    UNITTEST_ASSERT(pixel(6u, 3u) == Plotypus::Color({255u, 255u, 255u, 255u}), "keep outside of rectangle");
+    UNITTEST_ASSERT(pixel(11u, 3u) == Plotypus::Color({127u, 127u, 255u, 255u}), "blend translucent color");
+
+    canvas.beginPage(40., 20., {255u, 255u, 255u, 255u});
+    canvas.text({2., 15.}, "Ag", Plotypus::TextStyle());
+    UNITTEST_ASSERT(std::count(canvas.getPixels().begin(), canvas.getPixels().end(), 255u) < 40 * 20 * 4 - 40, "draw text");
+    UNITTEST_ASSERT(canvas.getTextWidth("Ag", Plotypus::TextStyle()) > canvas.getTextWidth("..", Plotypus::TextStyle()), "measure text");
+
+    const std::string png = Plotypus::encodePng(pixels, 20u, 10u);
+    UNITTEST_ASSERT(png.starts_with("\x89PNG\r\n\x1a\n") && png.ends_with(std::string("IEND\xae\x42\x60\x82", 8u)), "write PNG chunks");
+    UNITTEST_ASSERT(png.substr(16u, 8u) == std::string("\0\0\0\x14\0\0\0\x0a", 8u), "write PNG dimensions");
+    UNITTEST_THROWS(Plotypus::encodePng(pixels, 10u, 10u), Plotypus::InvalidArgumentError, "reject mismatching dimensions");
+
+    // ...................................................................... //
+
+    std::vector<double> ys = {1., 4., 2., 3.};
+
+    Plotypus::Report r(Plotypus::FileType::Png);
+    r.setVerbose(false);
+    r.setOutputDirectory(directory.string());
+    r.setNativeRendering(true);
+    r.terminalInfoProvider().setDimensions(200, 150);
+
+    for (size_t i = 0u; i < 3u; ++i)
+    {
+        r.addPlotWithAxes("thumbnail").addDataViewCompound<double>(std::span<double>(ys), [] (const double& y) {return y;}, Plotypus::PlotStyle2D::LinesPoints);
+    }
+    r.writeScript();
+
+    UNITTEST_ASSERT(fs::exists(directory / "report_1.png") && fs::exists(directory / "report_3.png"), "write one image per sheet");
+    UNITTEST_ASSERT(!fs::exists(directory / "report.gnuplot"), "write no script");
+
+    std::ifstream hFile(directory / "report_2.png", std::ios_base::binary);
+    const std::string image((std::istreambuf_iterator<char>(hFile)), std::istreambuf_iterator<char>());
+    UNITTEST_ASSERT(image.substr(16u, 8u) == std::string("\0\0\0\xc8\0\0\0\x96", 8u), "use dimensions in pixels");
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
+
+bool unittest_report_nativeAscii()
+{
+    std::cout << "TESTING REPORT CLASS NATIVE ASCII RENDERING" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("nativeascii");
+
+    // ...................................................................... //
+
+    std::stringstream text;
+    Plotypus::TextCanvas canvas(text, Plotypus::CellGlyphs::Braille);
+    canvas.beginPage(12., 8., {255u, 255u, 255u, 255u});
+    canvas.beginPath(Plotypus::Stroke());
+    canvas.moveTo({.5, .5});
+    canvas.lineTo({.5, 3.5});
+    canvas.endPath();
+    canvas.text({6., 4.}, "ab", Plotypus::TextStyle());
+    canvas.endPage();
+    UNITTEST_ASSERT(text.str() == "⡇  ab\n\n", "draw Braille dots and text");
+    UNITTEST_ASSERT(canvas.getTextWidth("äb", Plotypus::TextStyle()) == 4., "measure text in cells");
+
+    text.str("");
+    Plotypus::TextCanvas characters(text);
+    characters.beginPage(5., 3., {255u, 255u, 255u, 255u});
+    characters.beginPath(Plotypus::Stroke());
+    characters.moveTo({0., 1.5});
+    characters.lineTo({4.9, 1.5});
+    characters.endPath();
+    characters.endPage();
+    UNITTEST_ASSERT(text.str() == "\n-----\n\n", "draw lines as characters");
+
+    // ...................................................................... //
+
+    std::vector<double> ys = {1., 4., 2., 3.};
+
+    Plotypus::Report r(Plotypus::FileType::Ascii);
+    r.setVerbose(false);
+    r.setOutputDirectory(directory.string());
+    r.setNativeRendering(true);
+    r.setCellGlyphs(Plotypus::CellGlyphs::Blocks);
+
+    r.addPlotWithAxes("ascii title").addDataViewCompound<double>(std::span<double>(ys), [] (const double& y) {return y;}, Plotypus::PlotStyle2D::Lines, "data");
+    r.addSheet("second page");
+    r.writeScript();
+
+    std::ifstream hFile(directory / "report.txt");
+    const std::string page((std::istreambuf_iterator<char>(hFile)), std::istreambuf_iterator<char>());
+    UNITTEST_ASSERT(page.find("ascii title") != std::string::npos && page.find("second page") != std::string::npos, "draw all sheets into one file");
+    UNITTEST_ASSERT(page.find(" 4") != std::string::npos && page.find(" 3\n") != std::string::npos, "draw tic labels");
+    UNITTEST_ASSERT(page.find("█") != std::string::npos || page.find("▀") != std::string::npos || page.find("▄") != std::string::npos, "draw block glyphs");
+    UNITTEST_ASSERT(!fs::exists(directory / "report.gnuplot"), "write no script");
+
+    std::stringstream direct;
+    r.renderText(direct);
+    const std::string output = direct.str();
+    UNITTEST_ASSERT(std::count(output.begin(), output.end(), '\n') == 2 * 24 + 1, "render text to a stream");
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
+
+bool unittest_report_renderer()
+{
+    std::cout << "TESTING REPORT CLASS RENDERER BACKENDS" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("renderer");
+
+    // ...................................................................... //
+
+    Plotypus::RecordingRenderer recorder;
+
+    Plotypus::Report r(Plotypus::FileType::Png);     // the recorder writes no PDF pages to merge
+    r.setVerbose(false);
+    r.setOutputDirectory(directory.string());
+    r.setRenderer(recorder);
+    r.addPlotWithAxes();
+
+    r.writeScript();
+    auto records = recorder.getRecords();
+    UNITTEST_ASSERT(records.size() == 1u && records[0].scriptFilename == (directory / "report.gnuplot").string(), "pass script to renderer");
+    UNITTEST_ASSERT(records[0].scriptSize == fs::file_size(directory / "report.gnuplot"), "record script size");
+
+    r.addPlotWithAxes();
+    r.addPlotWithAxes();
+    r.setParallelPages(true);
+    r.writeScript();
+    UNITTEST_ASSERT(recorder.getRenderCount() == 4u, "pass page scripts to renderer");
+    r.setParallelPages(false);
+
+    recorder.setSimulatedDuration(std::chrono::milliseconds(20));
+    const auto result = r.writeScriptAsync().get();
+    UNITTEST_ASSERT(result.exitCode == 0 && result.wallTime == std::chrono::milliseconds(20), "simulate rendering time");
+
+    recorder.clear();
+    UNITTEST_ASSERT(recorder.getRenderCount() == 0u, "clear records");
+
+    r.reset();
+    UNITTEST_ASSERT(&r.renderer() != &recorder, "restore default renderer on reset");
+
+    // ...................................................................... //
+
+    // stand-in for gnuplot: answers print commands with the error state on stderr and logs loaded scripts,
+    // failing those named broken; copies each script and the memory files it refers to after a while, as
+    // a slow gnuplot would read them
+    const fs::path log        = directory / "loaded.log";
+    const fs::path scriptCopy = directory / "script.copy";
+    const fs::path dataCopy   = directory / "data.copy";
+    const fs::path executable = unittest_makeFakeGnuplot(directory, "err=0\n"
+                                                         "while IFS= read -r line; do\n"
+                                                         "    case \"$line\" in\n"
+                                                         "        'reset errors') err=0;;\n"
+                                                         "        'print \"'*) l=${line#print \\\"}; echo \"${l%%\\\"*} $err\" >&2;;\n"
+                                                         "        *broken*) echo \"$line\" >> '" + log.string() + "'; echo 'line 1: undefined variable' >&2; err=1;;\n"
+                                                         "        'load '*) echo \"$line\" >> '" + log.string() + "'; f=${line#load ?}; sleep 0.2\n"
+                                                         "            cat \"${f%?}\" > '" + scriptCopy.string() + "' 2>/dev/null\n"
+                                                         "            grep -o '/proc/[0-9]*/fd/[0-9]*' '" + scriptCopy.string() + "' | while read -r d; do cat \"$d\"; done > '" + dataCopy.string() + "';;\n"
+                                                         "    esac\n"
+                                                         "done\n");
+
+    Plotypus::GnuplotLaunchOptions options;
+    options.executable = executable.string();
+
+    {
+        Plotypus::GnuplotPoolRenderer pool(2u);
+        UNITTEST_ASSERT(pool.getProcessCount() == 2u, "start pool");
+
+        std::vector<std::future<Plotypus::GnuplotResult>> results;
+        for (const auto script : {"a", "b", "c", "it's"})
+        {
+            results.push_back(pool.render(script, options));
+        }
+
+        bool success = true;
+        for (auto& future : results)
+        {
+            success = success && !future.get().exitCode;
+        }
+        UNITTEST_ASSERT(success, "render scripts in pool");
+
+        std::ifstream hLog(log);
+        const std::string loaded((std::istreambuf_iterator<char>(hLog)), std::istreambuf_iterator<char>());
+        UNITTEST_ASSERT(std::count(loaded.begin(), loaded.end(), '\n') == 4 && loaded.find("load 'c'") != std::string::npos, "load each script once");
+        UNITTEST_ASSERT(loaded.find("load 'it''s'\n") != std::string::npos, "quote script filenames for gnuplot");
+
+        const auto broken = pool.render("broken", options).get();
+        UNITTEST_ASSERT(broken.exitCode == 1 && !broken.timedOut && broken.errorOutput == "line 1: undefined variable\n", "report script errors in pool");
+        UNITTEST_ASSERT(!pool.render("a", options).get().exitCode, "render again after script error");
+        UNITTEST_THROWS(pool.render("a\nb", options).get(), Plotypus::InvalidArgumentError, "reject line breaks in script filenames");
+
+        std::vector<double> ys = {1., 2., 3.};
+
+        Plotypus::Report memoryReport(Plotypus::FileType::Png);
+        memoryReport.setVerbose(false);
+        memoryReport.setOutputDirectory(directory.string());
+        memoryReport.setDataTransport(Plotypus::DataTransport::MemoryFiles);
+        memoryReport.setRenderer(pool);
+        memoryReport.gnuplotLaunchOptions() = options;
+        auto& view = memoryReport.addPlotWithAxes().addDataViewCompound<double>(std::span<double>(ys), [] (const double& y) {return y;});
+
+        memoryReport.writeDat();
+        const std::string processPath = "/proc/" + fs::read_symlink("/proc/self").string() + "/fd/";
+        UNITTEST_ASSERT(view.getDataFilename().starts_with(processPath), "refer to memory files via the process ID for the pool");
+
+        const auto memoryResult = memoryReport.writeScriptAsync().get();
+        std::ifstream hScript(scriptCopy);
+        const std::string script((std::istreambuf_iterator<char>(hScript)), std::istreambuf_iterator<char>());
+        UNITTEST_ASSERT(!memoryResult.exitCode && script.find(view.getDataFilename()) != std::string::npos, "keep in-memory script open until the pool loaded it");
+        UNITTEST_ASSERT(fs::file_size(dataCopy) == ys.size() * sizeof(double), "let the pool read in-memory data");
+
+        options.executable = (directory / "missing").string();
+        const auto renderMissing = [&pool, &options] {return pool.render("x", options).get();};
+        UNITTEST_THROWS(renderMissing(), Plotypus::FileIOError, "pass on failure to start gnuplot");
+    }
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}
+
+bool unittest_report_dataArchive()
+{
+    std::cout << "TESTING REPORT CLASS DATA ARCHIVE" << std::endl;
+
+    UNITTEST_VARS;
+
+    const fs::path directory = unittest_makeTempDirectory("archive");
+
+    // ...................................................................... //
+
+    std::vector<double> ys    = {1., 4., 2., 3.};
+    std::vector<double> zs    = {5., 6.};
+    const auto          selectY = [] (const double& y) {return y;};
+
+    Plotypus::Report r;
+    r.setVerbose(false);
+    r.setAutoRunScript(false);
+    r.setOutputDirectory(directory.string());
+    r.setDataTransport(Plotypus::DataTransport::Archive);
+
+    auto& plot = r.addPlotWithAxes();
+    plot.addDataViewCompound<double>(std::span<double>(ys), selectY);
+    plot.addDataViewCompound<double>(std::span<double>(zs), selectY);
+    plot.addDataViewCompound<double>(std::span<double>(zs), selectY).setBinaryDataOutput(false);
+
+    UNITTEST_THROWS(r.writeScript(), Plotypus::UnsupportedOperationError, "require data before script");
+
+    r.writeDat();
+    r.writeScript();
+
+    std::ifstream hScript(directory / "report.gnuplot");
+    const std::string script((std::istreambuf_iterator<char>(hScript)), std::istreambuf_iterator<char>());
+    const std::string archive = (directory / "report.dat").string();
+
+    UNITTEST_ASSERT(fs::file_size(archive) == (ys.size() + zs.size()) * sizeof(double), "append binary data to archive");
+    UNITTEST_ASSERT(script.find("\"" + archive + "\" binary skip=0 record=4 ") != std::string::npos, "address first slice");
+    UNITTEST_ASSERT(script.find("\"" + archive + "\" binary skip=32 record=2 ") != std::string::npos, "address second slice");
+    UNITTEST_ASSERT(r.getExportSummary().writtenDataFiles.size() == 2u, "keep separate file for ASCII data");
+
+    std::ifstream hArchive(archive, std::ios_base::binary);
+    std::vector<double> values(ys.size() + zs.size());
+    hArchive.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(double));
+    UNITTEST_ASSERT(values[3] == 3. && values[4] == 5., "write slices in order");
+
+    r.setDataTransport(Plotypus::DataTransport::Files);
+    r.writeScript();
+    std::ifstream hFiles(directory / "report.gnuplot");
+    const std::string filesScript((std::istreambuf_iterator<char>(hFiles)), std::istreambuf_iterator<char>());
+    UNITTEST_ASSERT(filesScript.find("skip=") == std::string::npos, "forget slices without archive");
+
+    // ...................................................................... //
+
+    fs::remove_all(directory);
+
+    UNITTEST_FINALIZE;
+}